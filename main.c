@@ -1,3 +1,5 @@
+#define _GNU_SOURCE
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -5,6 +7,10 @@
 #include <time.h>
 #include <math.h>
 #include <stdarg.h>
+#include <stdint.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
 
 #ifdef _WIN32
 #include <io.h>
@@ -12,6 +18,34 @@
 #define fileno _fileno
 #else
 #include <unistd.h>
+#include <pthread.h>
+#include <sys/uio.h>
+#include <sys/mman.h>
+#include <glob.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <signal.h>
+#endif
+
+#ifdef _WIN32
+#define THREAD_LOCAL
+#else
+#define THREAD_LOCAL __thread
+#endif
+
+#if defined(__linux__)
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+#endif
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if defined(__AVX2__)
+#include <immintrin.h>
 #endif
 
 #define MAX_DNA_LENGTH 1024
@@ -22,76 +56,389 @@
 #define MAX_COMPRESSED_LENGTH (MAX_DNA_LENGTH * 3)
 #define KEY_SIZE 16
 #define MAX_MATCHES 128
+#define MAX_KMER_SIZE 32
+#define KMER_PARTITIONS 64
+#define KMER_CHUNK_SIZE (1 << 20)
+#define KMER_RUN_BUFFER 4096
+#define FASTA_READ_BUFFER 65536
+#define DEFAULT_MEM_LIMIT ((int64_t)1 << 30)
+#define PROFILE_MAX_EVENTS (1 << 20)
+#define FASTA_LINE_WIDTH 60
+#define VIEW_BLOCK 4096
+#define RANDOM_CHUNK_BASES (FASTA_LINE_WIDTH * 65536)
+#define SIM_READS_PER_JOB 16384
+#define STATS_CSV 0
+#define STATS_COLUMNAR 1
+#define STATS_INT_COLUMNS 5
+#define STATS_CHUNK_ROWS 65536
+#define STATS_CSV_BUFFER (1 << 20)
+#define MASK_MIN_CHUNK (1 << 20)
+#define REPEAT_MIN_CHUNK (1 << 20)
+#define BATCH_QUEUE_DEPTH 64
+#define REPEAT_MIN_LENGTH 12
+#define REPEAT_MISMATCH_PENALTY 4
+#define IO_BLOCK_SIZE (1 << 20)
+#define IO_QUEUE_DEPTH 4
+#define IO_THREADS 2
+#define IO_AUTO 0
+#define IO_SYNC 1
+#define IO_THREADED 2
+#define IO_URING 3
+#define IO_READ 0
+#define IO_WRITE 1
+#define SERVE_OP_CLEAN (1 << 0)
+#define SERVE_OP_MUTATE (1 << 1)
+#define SERVE_OP_REVERSE_COMPLEMENT (1 << 2)
+#define SERVE_OP_COMPLEMENT (1 << 3)
+#define SERVE_OP_REVERSE (1 << 4)
+#define SERVE_OP_STATS (1 << 5)
+#define SERVE_OP_FIND (1 << 6)
+#define SERVE_OP_ORF (1 << 7)
+#define SERVE_OP_TRANSLATE (1 << 8)
+#define SERVE_OP_COMPRESS (1 << 9)
+#define SERVE_OP_HASH (1 << 10)
+#define SERVE_OP_KEY (1 << 11)
+#define FORMAT_TEXT 0
+#define FORMAT_NDJSON 1
+#define FORMAT_MSGPACK 2
+#define RECORD_MAX_DEPTH 8
 
 #define PROGRAM_VERSION "1.0.0"
 #define BUILD_DATE __DATE__
 #define BUILD_TIME __TIME__
 
 typedef struct {
-    int show_ascii;
-    int show_stats;
-    int show_summary;
-    int show_json;
-    int do_reverse;
-    int do_complement;
-    int do_reverse_complement;
-    int file_mode;
-    int do_csv;
-    int do_binary;
-    int do_hex;
-    int do_key;
-    int do_hash;
-    int do_qrcode;
-    int do_histogram;
-    int histogram_vertical;
-    int do_compress;
-    int do_decompress;
-    int do_export_stats;
-    int do_find;
-    int do_complexity;
+    unsigned int show_ascii : 1;
+    unsigned int show_stats : 1;
+    unsigned int show_summary : 1;
+    unsigned int show_json : 1;
+    unsigned int do_reverse : 1;
+    unsigned int do_complement : 1;
+    unsigned int do_reverse_complement : 1;
+    unsigned int file_mode : 1;
+    unsigned int do_csv : 1;
+    unsigned int do_binary : 1;
+    unsigned int do_hex : 1;
+    unsigned int do_key : 1;
+    unsigned int do_hash : 1;
+    unsigned int do_qrcode : 1;
+    unsigned int do_histogram : 1;
+    unsigned int histogram_vertical : 1;
+    unsigned int do_compress : 1;
+    unsigned int do_decompress : 1;
+    unsigned int do_export_stats : 1;
+    unsigned int do_stats_columns : 1;
+    unsigned int do_find : 1;
+    unsigned int do_complexity : 1;
+    unsigned int compare_mode : 1;
+    unsigned int encrypt_mode : 1;
+    unsigned int decrypt_mode : 1;
+    unsigned int encrypt_file_mode : 1;
+    unsigned int decrypt_file_mode : 1;
+    unsigned int stdin_mode : 1;
+    unsigned int no_color : 1;
+    unsigned int show_version : 1;
+    unsigned int do_benchmark : 1;
+    unsigned int do_translate : 1;
+    unsigned int do_hamming : 1;
+    unsigned int do_log : 1;
+    unsigned int do_palindrome : 1;
+    unsigned int do_fasta_input : 1;
+    unsigned int do_fasta_export : 1;
+    unsigned int do_orf : 1;
+    unsigned int both_strands : 1;
+    unsigned int six_frame : 1;
+    unsigned int do_position : 1;
+    unsigned int do_mask : 1;
+    unsigned int mask_bed : 1;
+    unsigned int do_find_palindromes : 1;
+    unsigned int do_repeats : 1;
+    unsigned int has_seed : 1;
+    unsigned int paired : 1;
+    unsigned int do_serve : 1;
+    unsigned int do_sketch : 1;
+    unsigned int do_compare_sketch : 1;
+    unsigned int sketch_per_record : 1;
+    unsigned int do_align : 1;
+    unsigned int do_jaccard : 1;
+    unsigned int align_local : 1;
+    unsigned int do_bench_suite : 1;
+    unsigned int do_profile : 1;
+    unsigned int profile_trace : 1;
+    unsigned int do_demux : 1;
+
     int mutate_count;
     int errors_count;
-    int random_length;
-    int compare_mode;
-    int encrypt_mode;
-    int decrypt_mode;
-    int encrypt_file_mode;
-    int decrypt_file_mode;
-    int stdin_mode;
-    int no_color;
-    int show_version;
-    int do_benchmark;
-    int do_translate;
     int rotate_n;
-    int do_hamming;
-    int do_log;
-    int do_palindrome;
-    int do_fasta_input;
-    int do_fasta_export;
-    int do_orf;
-    int do_position;
     char position_base;
-
-    char log_file[MAX_FILENAME_LENGTH];
-    char hamming_seq[MAX_DNA_LENGTH];
-    char input_file[MAX_FILENAME_LENGTH];
-    char output_file[MAX_FILENAME_LENGTH];
-    char csv_file[MAX_FILENAME_LENGTH];
-    char export_stats_file[MAX_FILENAME_LENGTH];
-    char compare_seq1[MAX_DNA_LENGTH];
-    char compare_seq2[MAX_DNA_LENGTH];
-    char find_pattern[MAX_DNA_LENGTH];
-    char encrypt_text[MAX_TEXT_LENGTH];
-    char decrypt_hex[MAX_TEXT_LENGTH];
-    char encrypt_file_input[MAX_FILENAME_LENGTH];
-    char encrypt_file_output[MAX_FILENAME_LENGTH];
-    char decrypt_file_input[MAX_FILENAME_LENGTH];
-    char decrypt_file_output[MAX_FILENAME_LENGTH];
-    char fasta_input_file[MAX_FILENAME_LENGTH];
-    char fasta_export_file[MAX_FILENAME_LENGTH];
+    int kmer_size;
+    int thread_count;
+    int64_t mem_limit;
+    int64_t random_length;
+    int64_t simulate_reads;
+    int64_t window_size;
+    int64_t window_step;
+    int mask_level;
+    int mask_window;
+    int min_arm;
+    int max_arm;
+    int max_spacer;
+    int max_period;
+    int min_copies;
+    uint64_t seed;
+    int io_backend;
+    int read_length;
+    int fragment_size;
+    int fragment_sd;
+    int output_format;
+    double sub_rate;
+    double ins_rate;
+    double del_rate;
+    double error_start;
+    double error_end;
+    int64_t bench_size;
+    int sketch_k;
+    int sketch_size;
+    int sketch_input_count;
+    char **sketch_inputs;
+    int batch_input_count;
+    char **batch_inputs;
+    int align_band;
+    int align_match;
+    int align_mismatch;
+    int align_gap_open;
+    int align_gap_extend;
+    int hamming_max_dist;
+    int hamming_top_n;
+    int bench_reps;
+    int demux_mismatches;
+
+    const char *log_file;
+    const char *hamming_seq;
+    const char *input_file;
+    const char *output_file;
+    const char *csv_file;
+    const char *export_stats_file;
+    const char *stats_columns_file;
+    const char *compare_seq1;
+    const char *compare_seq2;
+    const char *find_pattern;
+    const char *encrypt_text;
+    const char *decrypt_hex;
+    const char *encrypt_file_input;
+    const char *encrypt_file_output;
+    const char *decrypt_file_input;
+    const char *decrypt_file_output;
+    const char *fasta_input_file;
+    const char *fasta_export_file;
+    const char *kmer_output_file;
+    const char *sketch_output_file;
+    const char *compare_sketch_file1;
+    const char *compare_sketch_file2;
+    const char *align_file1;
+    const char *align_file2;
+    const char *demux_barcode_file;
+    const char *demux_prefix;
+    const char *bench_output_file;
+    const char *profile_output_file;
+    const char *random_output_file;
+    const char *reads_prefix;
+    const char *window_prefix;
+    const char *mask_output_file;
+    const char *palindrome_output_file;
+    const char *repeats_output_file;
+    const char *region;
+    const char *fasta_record;
+    const char *faidx_file;
+    const char *batch_output_file;
+    const char *regions_file;
+    const char *error_profile_file;
+    const char *serve_socket;
 } options;
 
 static FILE *log_fp = NULL;
+static int log_muted = 0;
+static int64_t alloc_count = 0;
+static int64_t alloc_bytes = 0;
+
+void count_allocation(size_t size)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __atomic_fetch_add(&alloc_count, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&alloc_bytes, (int64_t)size, __ATOMIC_RELAXED);
+#else
+    alloc_count++;
+    alloc_bytes += size;
+#endif
+}
+
+int64_t load_allocation_counter(const int64_t *counter)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __atomic_load_n(counter, __ATOMIC_RELAXED);
+#else
+    return *counter;
+#endif
+}
+
+void *xmalloc(size_t size)
+{
+    void *memory = malloc(size > 0 ? size : 1);
+
+    count_allocation(size);
+
+    if (memory == NULL) 
+    {
+        fprintf(stderr, "Error: Out of memory (requested %zu bytes).\n", size);
+        exit(1);
+    }
+
+    return memory;
+}
+
+void *xrealloc(void *memory, size_t size)
+{
+    void *resized = realloc(memory, size > 0 ? size : 1);
+
+    count_allocation(size);
+
+    if (resized == NULL) 
+    {
+        fprintf(stderr, "Error: Out of memory (requested %zu bytes).\n", size);
+        exit(1);
+    }
+
+    return resized;
+}
+
+#define ARENA_ALIGN 16
+#define ARENA_MIN_BLOCK (64 << 10)
+#define ARENA_HEADER ((sizeof(arena_block) + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1))
+
+typedef struct arena_block {
+    struct arena_block *next;
+    size_t capacity;
+    size_t used;
+} arena_block;
+
+typedef struct {
+    arena_block *head;
+    size_t used;
+    size_t capacity;
+    size_t peak;
+} scratch_arena;
+
+static THREAD_LOCAL scratch_arena global_arena;
+
+void *arena_alloc(scratch_arena *arena, size_t size)
+{
+    arena_block *block = arena->head;
+
+    size = (size + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+
+    if (block == NULL || block->capacity - block->used < size) 
+    {
+        size_t capacity = block != NULL ? block->capacity * 2 : ARENA_MIN_BLOCK;
+
+        while (capacity < size) 
+        {
+            capacity *= 2;
+        }
+
+        block = xmalloc(ARENA_HEADER + capacity);
+        block->next = arena->head;
+        block->capacity = capacity;
+        block->used = 0;
+        arena->head = block;
+        arena->capacity += capacity;
+    }
+
+    char *memory = (char *)block + ARENA_HEADER + block->used;
+
+    block->used += size;
+    arena->used += size;
+
+    if (arena->used > arena->peak) 
+    {
+        arena->peak = arena->used;
+    }
+
+    return memory;
+}
+
+void *arena_grow(scratch_arena *arena, void *memory, size_t old_size, size_t new_size)
+{
+    arena_block *block = arena->head;
+
+    old_size = (old_size + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+    new_size = (new_size + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+
+    if (memory != NULL && block != NULL && (char *)memory + old_size == (char *)block + ARENA_HEADER + block->used && block->used - old_size + new_size <= block->capacity) 
+    {
+        block->used += new_size - old_size;
+        arena->used += new_size - old_size;
+
+        if (arena->used > arena->peak) 
+        {
+            arena->peak = arena->used;
+        }
+
+        return memory;
+    }
+
+    void *resized = arena_alloc(arena, new_size);
+
+    if (memory != NULL) 
+    {
+        memcpy(resized, memory, old_size);
+    }
+
+    return resized;
+}
+
+void arena_reset(scratch_arena *arena)
+{
+    arena_block *block = arena->head;
+
+    if (block != NULL && block->next != NULL) 
+    {
+        size_t capacity = arena->capacity;
+
+        while (block != NULL) 
+        {
+            arena_block *next = block->next;
+
+            free(block);
+            block = next;
+        }
+
+        block = xmalloc(ARENA_HEADER + capacity);
+        block->next = NULL;
+        block->capacity = capacity;
+        arena->head = block;
+    }
+
+    if (block != NULL) 
+    {
+        block->used = 0;
+    }
+
+    arena->used = 0;
+}
+
+void arena_free(scratch_arena *arena)
+{
+    while (arena->head != NULL) 
+    {
+        arena_block *next = arena->head->next;
+
+        free(arena->head);
+        arena->head = next;
+    }
+
+    arena->used = 0;
+    arena->capacity = 0;
+}
 
 int is_valid_base(char base) 
 {
@@ -143,18 +490,21 @@ char complement_base(char base)
     return '?';
 }
 
-void reverse_sequence(char *sequence) 
+void reverse_range(char *sequence, int64_t start, int64_t end)
 {
-    int length = strlen(sequence);
-
-    for (int i = 0; i < length / 2; i++) 
+    for (int64_t i = start, j = end - 1; i < j; i++, j--) 
     {
         char temp = sequence[i];
-        sequence[i] = sequence[length - 1 - i];
-        sequence[length - 1 - i] = temp;
+        sequence[i] = sequence[j];
+        sequence[j] = temp;
     }
 }
 
+void reverse_sequence(char *sequence) 
+{
+    reverse_range(sequence, 0, strlen(sequence));
+}
+
 void make_complement(char *sequence) 
 {
     for (int i = 0; sequence[i] != '\0'; i++) 
@@ -163,2352 +513,14884 @@ void make_complement(char *sequence)
     }
 }
 
-void reverse_complement_sequence(char *sequence)
-{
-    make_complement(sequence);
-    reverse_sequence(sequence);
-}
-
-char random_base(char exclude) 
+void reverse_complement_range(char *sequence, int64_t length)
 {
-    char bases[] = { 'A', 'C', 'G', 'T' };
-    char new_base;
+    int64_t i = 0;
+    int64_t j = length - 1;
 
-    do 
+    for (; i < j; i++, j--) 
     {
-        new_base = bases[rand() % 4];
-    } 
-    while (new_base == exclude);
+        char temp = complement_base(sequence[i]);
+        sequence[i] = complement_base(sequence[j]);
+        sequence[j] = temp;
+    }
 
-    return new_base;
+    if (i == j) 
+    {
+        sequence[i] = complement_base(sequence[i]);
+    }
 }
 
-void mutate_sequence(char *sequence, int count) 
+void reverse_complement_sequence(char *sequence)
 {
-    int length = strlen(sequence);
+    reverse_complement_range(sequence, strlen(sequence));
+}
 
-    if (length == 0) 
+void rotate_left_range(char *sequence, int64_t length, int64_t n)
+{
+    if (length == 0 || n % length == 0) 
     {
         return;
     }
 
-    if (count <= 0) 
+    n = ((n % length) + length) % length;
+    reverse_range(sequence, 0, n);
+    reverse_range(sequence, n, length);
+    reverse_range(sequence, 0, length);
+}
+
+typedef struct {
+    char *data;
+    int64_t length;
+    int64_t base;
+    int step;
+    int complement;
+} sequence_view;
+
+void sequence_view_init(sequence_view *view, char *data, int64_t length)
+{
+    view->data = data;
+    view->length = length;
+    view->base = 0;
+    view->step = 1;
+    view->complement = 0;
+}
+
+void sequence_view_reverse(sequence_view *view)
+{
+    if (view->length == 0) 
     {
         return;
     }
 
-    int mutated[MAX_DNA_LENGTH] = { 0 };
-    int done = 0;
+    view->base = (view->base + view->step * (view->length - 1)) % view->length;
+    view->base = (view->base + view->length) % view->length;
+    view->step = -view->step;
+}
 
-    while (done < count) 
-    {
-        int pos = rand() % length;
+void sequence_view_complement(sequence_view *view)
+{
+    view->complement = !view->complement;
+}
 
-        if (mutated[pos] == 0) 
-        {
-            if (is_valid_base(sequence[pos])) 
-            {
-                sequence[pos] = random_base(sequence[pos]);
-                mutated[pos] = 1;
-                done++;
-            }
-        }
+void sequence_view_rotate(sequence_view *view, int64_t n)
+{
+    if (view->length == 0) 
+    {
+        return;
     }
+
+    view->base = (view->base - view->step * (n % view->length)) % view->length;
+    view->base = (view->base + view->length) % view->length;
 }
 
-void inject_errors(char *sequence, int count) 
+char sequence_view_at(const sequence_view *view, int64_t i)
 {
-    int length = strlen(sequence);
+    int64_t index = view->base + view->step * i;
 
-    if (length == 0) 
+    if (index >= view->length) 
     {
-        return;
+        index -= view->length;
     }
-
-    if (count <= 0) 
+    else if (index < 0) 
     {
-        return;
+        index += view->length;
     }
 
-    int errored[MAX_DNA_LENGTH] = { 0 };
-    int done = 0;
+    char base = view->data[index];
+
+    return view->complement ? complement_base(base) : base;
+}
 
-    while (done < count) 
+void sequence_view_materialize(sequence_view *view)
+{
+    if (view->step < 0) 
     {
-        int pos = rand() % length;
+        if (view->complement) 
+        {
+            reverse_complement_range(view->data, view->length);
+        }
+        else 
+        {
+            reverse_range(view->data, 0, view->length);
+        }
 
-        if (errored[pos] == 0) 
+        rotate_left_range(view->data, view->length, view->length - 1 - view->base);
+    }
+    else 
+    {
+        if (view->complement) 
         {
-            if (is_valid_base(sequence[pos])) 
+            for (int64_t i = 0; i < view->length; i++) 
             {
-                sequence[pos] = random_base(sequence[pos]);
-                errored[pos] = 1;
-                done++;
+                view->data[i] = complement_base(view->data[i]);
             }
         }
+
+        rotate_left_range(view->data, view->length, view->base);
     }
+
+    view->base = 0;
+    view->step = 1;
+    view->complement = 0;
 }
 
-void generate_random_sequence(char *sequence, int length) 
+int sequence_view_is_identity(const sequence_view *view)
 {
-    char bases[] = { 'A', 'C', 'G', 'T' };
+    return view->base == 0 && view->step == 1 && !view->complement;
+}
+
+#if defined(__SSE2__)
+__m128i complement_block(__m128i bases)
+{
+    __m128i is_a = _mm_cmpeq_epi8(bases, _mm_set1_epi8('A'));
+    __m128i is_c = _mm_cmpeq_epi8(bases, _mm_set1_epi8('C'));
+    __m128i is_g = _mm_cmpeq_epi8(bases, _mm_set1_epi8('G'));
+    __m128i is_t = _mm_cmpeq_epi8(bases, _mm_set1_epi8('T'));
+    __m128i known = _mm_or_si128(_mm_or_si128(is_a, is_c), _mm_or_si128(is_g, is_t));
+    __m128i result = _mm_and_si128(is_a, _mm_set1_epi8('T'));
+
+    result = _mm_or_si128(result, _mm_and_si128(is_t, _mm_set1_epi8('A')));
+    result = _mm_or_si128(result, _mm_and_si128(is_c, _mm_set1_epi8('G')));
+    result = _mm_or_si128(result, _mm_and_si128(is_g, _mm_set1_epi8('C')));
+
+    return _mm_or_si128(result, _mm_andnot_si128(known, _mm_set1_epi8('?')));
+}
+
+__m128i reverse_block(__m128i bytes)
+{
+    bytes = _mm_or_si128(_mm_slli_epi16(bytes, 8), _mm_srli_epi16(bytes, 8));
+    bytes = _mm_shufflelo_epi16(bytes, _MM_SHUFFLE(0, 1, 2, 3));
+    bytes = _mm_shufflehi_epi16(bytes, _MM_SHUFFLE(0, 1, 2, 3));
+
+    return _mm_shuffle_epi32(bytes, _MM_SHUFFLE(1, 0, 3, 2));
+}
+#endif
+
+void copy_forward(char *out, const char *source, int64_t count, int complement)
+{
+    int64_t i = 0;
 
-    for (int i = 0; i < length && i < MAX_DNA_LENGTH - 1; i++) 
+    if (!complement) 
     {
-        sequence[i] = bases[rand() % 4];
+        memcpy(out, source, (size_t)count);
+        return;
     }
 
-    if (length < MAX_DNA_LENGTH - 1) 
+#if defined(__SSE2__)
+    for (; i + 16 <= count; i += 16) 
     {
-        sequence[length] = '\0';
-    } 
-    else 
+        __m128i bases = _mm_loadu_si128((const __m128i *)(source + i));
+
+        _mm_storeu_si128((__m128i *)(out + i), complement_block(bases));
+    }
+#endif
+
+    for (; i < count; i++) 
     {
-        sequence[MAX_DNA_LENGTH - 1] = '\0';
+        out[i] = complement_base(source[i]);
     }
 }
 
-void clean_sequence(char *sequence) 
+void copy_reversed(char *out, const char *source, int64_t count, int complement)
 {
-    int j = 0;
+    int64_t i = 0;
 
-    for (int i = 0; sequence[i] != '\0'; i++) 
+#if defined(__SSE2__)
+    for (; i + 16 <= count; i += 16) 
     {
-        char base = toupper(sequence[i]);
+        __m128i bases = reverse_block(_mm_loadu_si128((const __m128i *)(source + count - 16 - i)));
 
-        if (is_valid_base(base)) 
-        {
-            sequence[j] = base;
-            j++;
-        }
+        _mm_storeu_si128((__m128i *)(out + i), complement ? complement_block(bases) : bases);
     }
+#endif
 
-    sequence[j] = '\0';
+    for (; i < count; i++) 
+    {
+        char base = source[count - 1 - i];
+
+        out[i] = complement ? complement_base(base) : base;
+    }
 }
 
-int count_differences(const char *s1, const char *s2) 
+void sequence_view_read(const sequence_view *view, int64_t start, int64_t count, char *out)
 {
-    int diff = 0;
-    int i = 0;
-
-    while (s1[i] != '\0' && s2[i] != '\0') 
+    while (count > 0) 
     {
-        if (s1[i] != s2[i]) 
+        int64_t run;
+
+        if (view->step > 0) 
         {
-            diff++;
+            int64_t physical = (view->base + start) % view->length;
+
+            run = count < view->length - physical ? count : view->length - physical;
+            copy_forward(out, view->data + physical, run, view->complement);
+        }
+        else 
+        {
+            int64_t physical = ((view->base - start) % view->length + view->length) % view->length;
+
+            run = count < physical + 1 ? count : physical + 1;
+            copy_reversed(out, view->data + physical - run + 1, run, view->complement);
         }
 
-        i++;
+        out += run;
+        start += run;
+        count -= run;
     }
+}
+
+typedef struct {
+    const sequence_view *view;
+    char block[VIEW_BLOCK];
+    int64_t start;
+    int64_t length;
+} view_cursor;
+
+void view_cursor_init(view_cursor *cursor, const sequence_view *view)
+{
+    cursor->view = view;
+    cursor->start = 0;
+    cursor->length = 0;
+}
 
-    while (s1[i] != '\0' || s2[i] != '\0') 
+const char *view_cursor_span(view_cursor *cursor, int64_t position, int64_t count)
+{
+    if (position < cursor->start || position + count > cursor->start + cursor->length) 
     {
-        diff++;
-        i++;
+        int64_t left = cursor->view->length - position;
+
+        cursor->start = position;
+        cursor->length = left < VIEW_BLOCK ? left : VIEW_BLOCK;
+        sequence_view_read(cursor->view, position, cursor->length, cursor->block);
     }
 
-    return diff;
+    return cursor->block + (position - cursor->start);
 }
 
-void count_bases(const char *sequence, int *a, int *c, int *g, int *t) 
+typedef struct {
+    uint64_t s[4];
+} rng_state;
+
+static THREAD_LOCAL rng_state global_rng;
+static char random_base_table[256][4];
+
+uint64_t splitmix64(uint64_t *state)
 {
-    *a = 0;
-    *c = 0;
-    *g = 0;
-    *t = 0;
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
 
-    for (int i = 0; sequence[i] != '\0'; i++) 
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+
+    return z ^ (z >> 31);
+}
+
+void init_random_base_table(void)
+{
+    const char bases[] = { 'A', 'C', 'G', 'T' };
+
+    for (int v = 0; v < 256; v++) 
     {
-        if (sequence[i] == 'A') 
-        {
-            (*a)++;
-        } 
-        else if (sequence[i] == 'C') 
+        for (int j = 0; j < 4; j++) 
         {
-            (*c)++;
-        } 
-        else if (sequence[i] == 'G') 
-        {
-            (*g)++;
-        } 
-        else if (sequence[i] == 'T') 
-        {
-            (*t)++;
+            random_base_table[v][j] = bases[(v >> (2 * j)) & 3];
         }
     }
 }
 
-void log_printf(const char *format, ...) 
+void rng_seed(rng_state *rng, uint64_t seed)
 {
-    va_list args;
-
-    va_start(args, format);
+    for (int i = 0; i < 4; i++) 
+    {
+        rng->s[i] = splitmix64(&seed);
+    }
+}
 
-    vprintf(format, args);
-
-    if (log_fp != NULL) 
-    {
-        va_list args_copy;
-        va_copy(args_copy, args);
-        vfprintf(log_fp, format, args_copy);
-        va_end(args_copy);
-    }
+uint64_t rotl64(uint64_t value, int shift)
+{
+    return (value << shift) | (value >> (64 - shift));
+}
 
-    va_end(args);
+uint64_t rng_next(rng_state *rng)
+{
+    uint64_t *s = rng->s;
+    uint64_t result = rotl64(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl64(s[3], 45);
+
+    return result;
 }
 
-void print_base(char base) 
+void rng_jump(rng_state *rng)
 {
-    if (base == 'A') 
-    {
-        log_printf("[A]");
-    } 
-    else if (base == 'C') 
-    {
-        log_printf("[C]");
-    } 
-    else if (base == 'G') 
-    {
-        log_printf("[G]");
-    } 
-    else if (base == 'T') 
-    {
-        log_printf("[T]");
-    } 
-    else 
+    static const uint64_t jump[] = { 0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL, 0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL };
+    uint64_t s[4] = { 0, 0, 0, 0 };
+
+    for (int i = 0; i < 4; i++) 
     {
-        log_printf("[?]");
+        for (int b = 0; b < 64; b++) 
+        {
+            if (jump[i] & ((uint64_t)1 << b)) 
+            {
+                s[0] ^= rng->s[0];
+                s[1] ^= rng->s[1];
+                s[2] ^= rng->s[2];
+                s[3] ^= rng->s[3];
+            }
+
+            rng_next(rng);
+        }
     }
+
+    memcpy(rng->s, s, sizeof(s));
 }
 
-void print_sequence(const char *sequence) 
+uint32_t rng_bounded(rng_state *rng, uint32_t bound)
 {
-    log_printf("\n=== ASCII View ===\n\n");
+    return (uint32_t)(((rng_next(rng) >> 32) * (uint64_t)bound) >> 32);
+}
 
-    int count = 0;
+void rng_fill_bases(rng_state *rng, char *out, int64_t length)
+{
+    const char bases[] = { 'A', 'C', 'G', 'T' };
+    int64_t i = 0;
 
-    for (int i = 0; sequence[i] != '\0'; i++) 
+    for (; i + 32 <= length; i += 32) 
     {
-        print_base(sequence[i]);
-        count++;
+        uint64_t word = rng_next(rng);
 
-        if (count % 32 == 0) 
+        for (int j = 0; j < 8; j++) 
         {
-            log_printf("\n");
+            memcpy(out + i + 4 * j, random_base_table[(word >> (8 * j)) & 0xFF], 4);
         }
     }
 
-    if (count % 32 != 0) 
+    if (i < length) 
     {
-        log_printf("\n");
+        uint64_t word = rng_next(rng);
+
+        for (; i < length; i++) 
+        {
+            out[i] = bases[word & 3];
+            word >>= 2;
+        }
     }
 }
 
-void print_match_marked(const char *seq, int seq_len, int start, int pat_len, int color) 
+char random_base_from(rng_state *rng, char exclude) 
 {
-    for (int i = 0; i < seq_len; i++) 
+    char bases[] = { 'A', 'C', 'G', 'T' };
+
+    for (int i = 0; i < 4; i++) 
     {
-        if (i >= start && i < start + pat_len) 
-        {
-            if (!color) 
-            {
-                print_base(seq[i]);
-            } 
-            else 
-            {
-                log_printf("\033[42;30m");
-                print_base(seq[i]);
-                log_printf("\033[0m");
-            }
-        } 
-        else 
+        if (bases[i] == exclude) 
         {
-            print_base(seq[i]);
+            return bases[(i + 1 + rng_bounded(rng, 3)) % 4];
         }
     }
 
-    log_printf("\n");
+    return bases[rng_bounded(rng, 4)];
 }
 
-void find_pattern(const char *sequence, const char *pattern, int color) 
+char random_base(char exclude) 
 {
-    int seq_len = strlen(sequence);
-    int pat_len = strlen(pattern);
-    int positions[MAX_MATCHES];
-    int match_count = 0;
+    return random_base_from(&global_rng, exclude);
+}
 
-    if (pat_len == 0) 
+uint64_t rng_below(rng_state *rng, uint64_t bound)
+{
+#if defined(__SIZEOF_INT128__)
+    return (uint64_t)(((unsigned __int128)rng_next(rng) * bound) >> 64);
+#else
+    return rng_next(rng) % bound;
+#endif
+}
+
+double rng_uniform(rng_state *rng)
+{
+    return ((rng_next(rng) >> 11) + 1) * (1.0 / 9007199254740992.0);
+}
+
+void sample_without_replacement(rng_state *rng, int64_t n, int64_t k, uint64_t *bitmap)
+{
+    memset(bitmap, 0, sizeof(uint64_t) * (size_t)((n + 63) / 64));
+
+    for (int64_t j = n - k; j < n; j++) 
     {
-        log_printf("\n=== Pattern Search: \"%s\" ===\n\n", pattern);
-        log_printf("No matches found.\n");
-        return;
+        int64_t t = (int64_t)rng_below(rng, (uint64_t)j + 1);
+
+        if (bitmap[t / 64] & ((uint64_t)1 << (t % 64))) 
+        {
+            t = j;
+        }
+
+        bitmap[t / 64] |= (uint64_t)1 << (t % 64);
     }
+}
 
-    if (seq_len == 0) 
+int64_t substitute_random_positions(rng_state *rng, char *sequence, int64_t length, int64_t count)
+{
+    int64_t valid = 0;
+
+    for (int64_t i = 0; i < length; i++) 
     {
-        log_printf("\n=== Pattern Search: \"%s\" ===\n\n", pattern);
-        log_printf("No matches found.\n");
-        return;
+        valid += is_valid_base(sequence[i]);
     }
 
-    if (pat_len > seq_len) 
+    if (count > valid) 
     {
-        log_printf("\n=== Pattern Search: \"%s\" ===\n\n", pattern);
-        log_printf("No matches found.\n");
-        return;
+        count = valid;
     }
 
-    char upper_pattern[MAX_DNA_LENGTH];
-    for (int i = 0; i < pat_len; i++) 
+    if (count <= 0) 
     {
-        upper_pattern[i] = toupper(pattern[i]);
+        return 0;
     }
-    upper_pattern[pat_len] = '\0';
 
-    log_printf("\n=== Pattern Search: \"%s\" ===\n\n", pattern);
+    uint64_t *bitmap = xmalloc(sizeof(uint64_t) * (size_t)((valid + 63) / 64));
+    int64_t rank = 0;
 
-    for (int i = 0; i <= seq_len - pat_len && match_count < MAX_MATCHES; i++) 
-    {
-        int match = 1;
+    sample_without_replacement(rng, valid, count, bitmap);
 
-        for (int j = 0; j < pat_len; j++) 
+    for (int64_t i = 0; i < length; i++) 
+    {
+        if (!is_valid_base(sequence[i])) 
         {
-            if (toupper(sequence[i + j]) != upper_pattern[j]) 
-            {
-                match = 0;
-                break;
-            }
+            continue;
         }
 
-        if (match) 
+        if (bitmap[rank / 64] & ((uint64_t)1 << (rank % 64))) 
         {
-            positions[match_count] = i;
-            match_count++;
+            sequence[i] = random_base_from(rng, sequence[i]);
         }
-    }
 
-    if (match_count == 0) 
-    {
-        log_printf("No matches found.\n");
-        return;
+        rank++;
     }
 
-    log_printf("Found %d match(es):\n\n", match_count);
+    free(bitmap);
 
-    for (int m = 0; m < match_count; m++) 
-    {
-        log_printf("%d. Position: %d\n", m + 1, positions[m] + 1);
-        print_match_marked(sequence, seq_len, positions[m], pat_len, color ? 1 : 0);
-        log_printf("\n");
-    }
+    return count;
 }
 
-void print_positions_of_base(const char *sequence, char base)
+void mutate_sequence(char *sequence, int count) 
 {
-    log_printf("\n=== Positions of base '%c' ===\n\n", base);
+    substitute_random_positions(&global_rng, sequence, strlen(sequence), count);
+}
 
-    int length = strlen(sequence);
-    int found = 0;
+void inject_errors(char *sequence, int count) 
+{
+    substitute_random_positions(&global_rng, sequence, strlen(sequence), count);
+}
 
-    for (int i = 0; i < length; i++) 
+typedef struct {
+    rng_state *rng;
+    double sub_rate;
+    double ins_rate;
+    double del_rate;
+    double log_keep;
+    int64_t next_event;
+    int64_t substitutions;
+    int64_t insertions;
+    int64_t deletions;
+} mutation_engine;
+
+int64_t mutation_next_gap(mutation_engine *engine)
+{
+    if (engine->log_keep == 0) 
     {
-        if (sequence[i] == base) 
-        {
-            log_printf("%d\n", i);
-            found = 1;
-        }
+        return INT64_MAX;
     }
 
-    if (!found) 
+    if (engine->log_keep < -700) 
     {
-        log_printf("Base '%c' not found in sequence.\n", base);
+        return 0;
     }
 
-    log_printf("\n");
+    double gap = floor(log(rng_uniform(engine->rng)) / engine->log_keep);
+
+    return gap > 9e18 ? INT64_MAX : (int64_t)gap;
 }
 
-void print_stats(const char *sequence) 
+void mutation_engine_init(mutation_engine *engine, rng_state *rng, double sub_rate, double ins_rate, double del_rate)
 {
-    int a;
-    int c;
-    int g;
-    int t;
-
-    count_bases(sequence, &a, &c, &g, &t);
-
-    log_printf("\n=== Base Statistics ===\n\n");
-
-    log_printf("A: %d\n", a);
-    log_printf("C: %d\n", c);
-    log_printf("G: %d\n", g);
-    log_printf("T: %d\n", t);
+    double total = sub_rate + ins_rate + del_rate;
+
+    engine->rng = rng;
+    engine->sub_rate = sub_rate;
+    engine->ins_rate = ins_rate;
+    engine->del_rate = del_rate;
+    engine->log_keep = total <= 0 ? 0 : (total >= 1 ? -1000 : log1p(-total));
+    engine->substitutions = 0;
+    engine->insertions = 0;
+    engine->deletions = 0;
+    engine->next_event = mutation_next_gap(engine);
 }
 
-void print_summary(const char *sequence) 
+int64_t mutation_engine_apply(mutation_engine *engine, const char *in, int64_t length, char *out)
 {
-    int a;
-    int c;
-    int g;
-    int t;
-
-    count_bases(sequence, &a, &c, &g, &t);
-
-    int total = a + c + g + t;
-    int gc = c + g;
-
-    log_printf("\n=== Summary ===\n\n");
-
-    log_printf("Total Length: %d\n", total);
-    log_printf("A: %d  C: %d  G: %d  T: %d\n", a, c, g, t);
+    double total = engine->sub_rate + engine->ins_rate + engine->del_rate;
+    int64_t out_length = 0;
+    int64_t i = 0;
 
-    if (total > 0) 
-    {
-        log_printf("GC Content: %.1f%%\n", (100.0 * gc / total));
-    } 
-    else 
+    while (i < length) 
     {
-        log_printf("GC Content: 0.0%%\n");
-    }
-}
+        int64_t run = length - i < engine->next_event ? length - i : engine->next_event;
 
-void print_json(const char *sequence) 
-{
-    int a;
-    int c;
-    int g;
-    int t;
+        memcpy(out + out_length, in + i, (size_t)run);
+        out_length += run;
+        i += run;
 
-    count_bases(sequence, &a, &c, &g, &t);
+        if (engine->next_event != INT64_MAX) 
+        {
+            engine->next_event -= run;
+        }
 
-    int total = a + c + g + t;
-    int gc = c + g;
+        if (i == length) 
+        {
+            break;
+        }
 
-    log_printf("\n=== JSON Output ===\n\n");
+        char base = in[i++];
+        double pick = rng_uniform(engine->rng) * total;
 
-    log_printf("{\n");
-    log_printf("  \"length\": %d,\n", total);
-    log_printf("  \"sequence\": \"%s\",\n", sequence);
-    log_printf("  \"counts\": {\n");
-    log_printf("    \"A\": %d,\n", a);
-    log_printf("    \"C\": %d,\n", c);
-    log_printf("    \"G\": %d,\n", g);
-    log_printf("    \"T\": %d\n", t);
-    log_printf("  },\n");
+        if (!is_valid_base(base)) 
+        {
+            out[out_length++] = base;
+        }
+        else if (pick < engine->sub_rate) 
+        {
+            out[out_length++] = random_base_from(engine->rng, base);
+            engine->substitutions++;
+        }
+        else if (pick < engine->sub_rate + engine->ins_rate) 
+        {
+            out[out_length++] = base;
+            out[out_length++] = random_base_from(engine->rng, 0);
+            engine->insertions++;
+        }
+        else 
+        {
+            engine->deletions++;
+        }
 
-    if (total > 0) 
-    {
-        log_printf("  \"gc_percent\": %.1f\n", (100.0 * gc / total));
-    } 
-    else 
-    {
-        log_printf("  \"gc_percent\": 0.0\n");
+        engine->next_event = mutation_next_gap(engine);
     }
 
-    log_printf("}\n");
+    return out_length;
 }
 
-void export_csv(const char *filename, const char *sequence) 
+void generate_random_sequence(char *sequence, int64_t length) 
 {
-    int count_a;
-    int count_c;
-    int count_g;
-    int count_t;
-
-    count_bases(sequence, &count_a, &count_c, &count_g, &count_t);
-
-    int total = count_a + count_c + count_g + count_t;
-    int gc = count_g + count_c;
-
-    FILE *file = fopen(filename, "a");
-
-    if (file == NULL) 
+    if (length > MAX_DNA_LENGTH - 1) 
     {
-        log_printf("Failed to write to file: %s\n", filename);
-        return;
+        length = MAX_DNA_LENGTH - 1;
     }
 
-    fseek(file, 0, SEEK_END);
-    long size = ftell(file);
-
-    if (size == 0) 
-    {
-        fprintf(file, "sequence,length,A,C,G,T,gc_percent\n");
-    }
+    rng_fill_bases(&global_rng, sequence, length);
+    sequence[length] = '\0';
+}
 
-    fprintf(file, "%s,%d,%d,%d,%d,%d,", sequence, total, count_a, count_c, count_g, count_t);
+void clean_sequence(char *sequence) 
+{
+    int j = 0;
 
-    if (total > 0) 
-    {
-        fprintf(file, "%.1f\n", (100.0 * gc / total));
-    } 
-    else 
+    for (int i = 0; sequence[i] != '\0'; i++) 
     {
-        fprintf(file, "0.0\n");
+        char base = toupper(sequence[i]);
+
+        if (is_valid_base(base)) 
+        {
+            sequence[j] = base;
+            j++;
+        }
     }
 
-    fclose(file);
+    sequence[j] = '\0';
 }
 
-void export_stats_json(const char *filename, const char *sequence) 
+int count_differences(const char *s1, const char *s2) 
 {
-    int a, c, g, t;
-
-    count_bases(sequence, &a, &c, &g, &t);
-
-    int total = a + c + g + t;
-    int gc = c + g;
-
-    FILE *file = fopen(filename, "w");
+    int diff = 0;
+    int i = 0;
 
-    if (file == NULL) 
+    while (s1[i] != '\0' && s2[i] != '\0') 
     {
-        log_printf("Failed to write JSON stats to file: %s\n", filename);
-        return;
-    }
-
-    fprintf(file, "{\n");
-    fprintf(file, "  \"sequence\": \"%s\",\n", sequence);
-    fprintf(file, "  \"length\": %d,\n", total);
-    fprintf(file, "  \"A\": %d,\n", a);
-    fprintf(file, "  \"C\": %d,\n", c);
-    fprintf(file, "  \"G\": %d,\n", g);
-    fprintf(file, "  \"T\": %d,\n", t);
+        if (s1[i] != s2[i]) 
+        {
+            diff++;
+        }
 
-    if (total > 0) 
-    {
-        fprintf(file, "  \"gc_percent\": %.1f\n", (100.0 * gc / total));
-    } 
-    else 
-    {
-        fprintf(file, "  \"gc_percent\": 0.0\n");
+        i++;
     }
 
-    fprintf(file, "}\n");
+    diff += strlen(s1 + i) + strlen(s2 + i);
 
-    fclose(file);
+    return diff;
 }
 
-void print_binary(const char *sequence) 
+void count_bases(const char *sequence, int *a, int *c, int *g, int *t) 
 {
-    log_printf("\n=== Binary Output ===\n\n");
+    *a = 0;
+    *c = 0;
+    *g = 0;
+    *t = 0;
 
     for (int i = 0; sequence[i] != '\0'; i++) 
     {
         if (sequence[i] == 'A') 
         {
-            log_printf("00");
+            (*a)++;
         } 
         else if (sequence[i] == 'C') 
         {
-            log_printf("01");
+            (*c)++;
         } 
         else if (sequence[i] == 'G') 
         {
-            log_printf("10");
+            (*g)++;
         } 
         else if (sequence[i] == 'T') 
         {
-            log_printf("11");
-        } 
-        else 
-        {
-            log_printf("??");
+            (*t)++;
         }
     }
-
-    log_printf("\n");
 }
 
-void print_hex(const char *sequence) 
-{
-    log_printf("\n=== Hex Output ===\n\n");
-
-    int i = 0;
+typedef struct {
+    char *data;
+    size_t length;
+    size_t capacity;
+} text_buffer;
 
-    while (sequence[i] != '\0') 
+void text_reserve(text_buffer *buffer, size_t extra)
+{
+    if (buffer->length + extra + 1 > buffer->capacity) 
     {
-        char code1 = 0;
-        char code2 = 0;
+        size_t grown = buffer->capacity == 0 ? 256 : buffer->capacity * 2;
 
-        if (sequence[i] == 'A') 
-        {
-            code1 = 0;
-        } 
-        else if (sequence[i] == 'C') 
-        {
-            code1 = 1;
-        } 
-        else if (sequence[i] == 'G') 
-        {
-            code1 = 2;
-        } 
-        else if (sequence[i] == 'T') 
+        while (grown < buffer->length + extra + 1) 
         {
-            code1 = 3;
+            grown *= 2;
         }
 
-        if (sequence[i + 1] != '\0') 
-        {
-            if (sequence[i + 1] == 'A') 
-            {
-                code2 = 0;
-            } 
-            else if (sequence[i + 1] == 'C') 
-            {
-                code2 = 1;
-            } 
-            else if (sequence[i + 1] == 'G') 
-            {
-                code2 = 2;
-            } 
-            else if (sequence[i + 1] == 'T') 
-            {
-                code2 = 3;
-            }
+        buffer->data = xrealloc(buffer->data, grown);
+        buffer->capacity = grown;
+    }
+}
 
-            unsigned char combined = (code1 << 2) | code2;
-            log_printf("%X", combined);
+void text_append(text_buffer *buffer, const char *data, size_t length)
+{
+    text_reserve(buffer, length);
+    memcpy(buffer->data + buffer->length, data, length);
+    buffer->length += length;
+    buffer->data[buffer->length] = '\0';
+}
 
-            i = i + 2;
-        } 
-        else 
-        {
-            log_printf("%X", code1 << 2);
-            break;
-        }
+void text_printf(text_buffer *buffer, const char *format, ...)
+{
+    va_list args;
+
+    va_start(args, format);
+
+    int needed = vsnprintf(NULL, 0, format, args);
+
+    va_end(args);
+
+    if (needed < 0) 
+    {
+        return;
     }
 
-    log_printf("\n");
+    text_reserve(buffer, (size_t)needed);
+    va_start(args, format);
+    vsnprintf(buffer->data + buffer->length, (size_t)needed + 1, format, args);
+    va_end(args);
+    buffer->length += needed;
 }
 
-void derive_key_bytes(const char *sequence, unsigned char *key_out) 
+static THREAD_LOCAL text_buffer *log_capture = NULL;
+
+void log_printf(const char *format, ...) 
 {
-    for (int i = 0; i < KEY_SIZE; i++) 
+    va_list args;
+
+    if (log_muted) 
     {
-        key_out[i] = 0;
+        return;
     }
 
-    for (int i = 0; sequence[i] != '\0'; i++) 
+    va_start(args, format);
+
+    if (log_capture != NULL) 
     {
-        unsigned char value = 0;
+        va_list args_copy;
 
-        if (sequence[i] == 'A') 
-        {
-            value = 0x1;
-        } 
-        else if (sequence[i] == 'C') 
-        {
-            value = 0x3;
-        } 
-        else if (sequence[i] == 'G') 
-        {
-            value = 0x7;
-        } 
-        else if (sequence[i] == 'T') 
-        {
-            value = 0xD;
-        }
+        va_copy(args_copy, args);
 
-        key_out[i % KEY_SIZE] ^= value ^ (i * 31);
-    }
-}
+        int needed = vsnprintf(NULL, 0, format, args_copy);
 
-void derive_key(const char *sequence) 
-{
-    unsigned char key[KEY_SIZE];
+        va_end(args_copy);
 
-    derive_key_bytes(sequence, key);
+        if (needed > 0) 
+        {
+            text_reserve(log_capture, (size_t)needed);
+            vsnprintf(log_capture->data + log_capture->length, (size_t)needed + 1, format, args);
+            log_capture->length += needed;
+        }
 
-    log_printf("\n=== Derived Key ===\n\n");
+        va_end(args);
+        return;
+    }
 
-    log_printf("DNA Key (32 chars): ");
+    vprintf(format, args);
 
-    for (int i = 0; i < KEY_SIZE; i++) 
+    if (log_fp != NULL) 
     {
-        log_printf("%02X", key[i]);
+        va_list args_copy;
+        va_copy(args_copy, args);
+        vfprintf(log_fp, format, args_copy);
+        va_end(args_copy);
     }
 
-    log_printf("\n");
+    va_end(args);
 }
 
-void derive_hash(const char *sequence) 
+void text_append_json_string(text_buffer *buffer, const char *text, size_t length)
 {
-    unsigned char hash[32] = { 0 };
+    text_reserve(buffer, length + 2);
+    buffer->data[buffer->length++] = '"';
 
-    for (int i = 0; sequence[i] != '\0'; i++) 
+    for (size_t i = 0; i < length; i++) 
     {
-        unsigned char value = 0;
+        unsigned char ch = (unsigned char)text[i];
 
-        if (sequence[i] == 'A') 
-        {
-            value = 0xA3;
-        } 
-        else if (sequence[i] == 'C') 
+        if (ch == '"' || ch == '\\') 
         {
-            value = 0xC5;
-        } 
-        else if (sequence[i] == 'G') 
+            text_reserve(buffer, 2);
+            buffer->data[buffer->length++] = '\\';
+            buffer->data[buffer->length++] = (char)ch;
+        }
+        else if (ch < 0x20) 
         {
-            value = 0xF1;
-        } 
-        else if (sequence[i] == 'T') 
+            text_printf(buffer, "\\u%04x", ch);
+        }
+        else 
         {
-            value = 0x9E;
+            text_reserve(buffer, 1);
+            buffer->data[buffer->length++] = (char)ch;
         }
-
-        hash[i % 32] ^= value ^ (i * 17);
-        hash[(i * 3) % 32] ^= (value << (i % 5)) | (value >> ((8 - (i % 5)) % 8));
     }
 
-    log_printf("\n=== Hash ===\n\n");
+    text_append(buffer, "\"", 1);
+}
 
-    log_printf("DNA Hash (64 chars): ");
+void text_append_hex(text_buffer *buffer, const unsigned char *bytes, int count)
+{
+    text_append(buffer, "\"", 1);
 
-    for (int i = 0; i < 32; i++) 
+    for (int i = 0; i < count; i++) 
     {
-        log_printf("%02X", hash[i]);
+        text_printf(buffer, "%02X", bytes[i]);
     }
 
-    log_printf("\n");
+    text_append(buffer, "\"", 1);
 }
 
-void encrypt_text_with_dna_key(const char *sequence, const char *text) 
+int64_t parse_size(const char *text)
 {
-    unsigned char key[KEY_SIZE];
-
-    derive_key_bytes(sequence, key);
+    char *end;
+    double value = strtod(text, &end);
 
-    log_printf("\n=== Encrypted Output ===\n\n");
+    if (end == text || value < 0) 
+    {
+        return -1;
+    }
 
-    log_printf("Plaintext : %s\n", text);
-    log_printf("Cipherhex : ");
+    char unit = toupper(*end);
 
-    for (int i = 0; text[i] != '\0'; i++) 
+    if (unit == 'K') 
     {
-        unsigned char encrypted = text[i] ^ key[i % KEY_SIZE];
-        log_printf("%02X", encrypted);
+        value *= 1024.0;
+    } 
+    else if (unit == 'M') 
+    {
+        value *= 1024.0 * 1024.0;
+    } 
+    else if (unit == 'G') 
+    {
+        value *= 1024.0 * 1024.0 * 1024.0;
+    } 
+    else if (unit == 'T') 
+    {
+        value *= 1024.0 * 1024.0 * 1024.0 * 1024.0;
+    } 
+    else if (unit != '\0' && unit != 'B') 
+    {
+        return -1;
     }
 
-    log_printf("\n");
+    return (int64_t)value;
 }
 
-void decrypt_hex_with_dna_key(const char *sequence, const char *hex_string) 
+int file_seek(FILE *file, int64_t offset)
 {
-    unsigned char key[KEY_SIZE];
+#ifdef _WIN32
+    return _fseeki64(file, offset, SEEK_SET);
+#else
+    return fseeko(file, (off_t)offset, SEEK_SET);
+#endif
+}
 
-    derive_key_bytes(sequence, key);
+int64_t now_ns(void)
+{
+    struct timespec ts;
 
-    log_printf("\n=== Decrypted Output ===\n\n");
+#ifdef _WIN32
+    timespec_get(&ts, TIME_UTC);
+#else
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+#endif
 
-    log_printf("Cipherhex : %s\n", hex_string);
-    log_printf("Plaintext : ");
+    return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
 
-    int len = strlen(hex_string);
+int64_t peak_rss_kb(void)
+{
+#ifdef _WIN32
+    return 0;
+#else
+    struct rusage usage;
 
-    for (int i = 0; i + 1 < len; i = i + 2) 
+    if (getrusage(RUSAGE_SELF, &usage) != 0) 
     {
-        char hex_byte[3];
-
-        hex_byte[0] = hex_string[i];
-        hex_byte[1] = hex_string[i + 1];
-        hex_byte[2] = '\0';
-
-        unsigned int value;
-        sscanf(hex_byte, "%02X", &value);
-
-        unsigned char decrypted = (unsigned char)value ^ key[(i / 2) % KEY_SIZE];
-        log_printf("%c", decrypted);
+        return 0;
     }
 
-    log_printf("\n");
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+#endif
 }
 
-void print_qrcode(const char *sequence) 
-{
-    log_printf("\n=== QR Code ===\n\n");
+enum {
+    STAGE_SEQUENCE,
+    STAGE_DECOMPRESS,
+    STAGE_CLEAN,
+    STAGE_MUTATE,
+    STAGE_ERRORS,
+    STAGE_RATES,
+    STAGE_TRANSFORM,
+    STAGE_FIND,
+    STAGE_PALINDROME,
+    STAGE_ORF,
+    STAGE_POSITION,
+    STAGE_JSON,
+    STAGE_BINARY,
+    STAGE_HEX,
+    STAGE_KEY,
+    STAGE_HASH,
+    STAGE_ENCRYPT,
+    STAGE_DECRYPT,
+    STAGE_QRCODE,
+    STAGE_HISTOGRAM,
+    STAGE_COMPRESS,
+    STAGE_COMPLEXITY,
+    STAGE_TRANSLATE,
+    STAGE_ASCII,
+    STAGE_STATS,
+    STAGE_SUMMARY,
+    STAGE_CSV,
+    STAGE_STATS_COLUMNS,
+    STAGE_EXPORT_STATS,
+    STAGE_FASTA_EXPORT,
+    STAGE_RECORD,
+    STAGE_HAMMING,
+    STAGE_ENCRYPT_FILE,
+    STAGE_DECRYPT_FILE,
+    STAGE_COUNT
+};
+
+static const char *profile_stage_names[STAGE_COUNT] = {
+    "process_sequence", "decompress", "clean", "mutate", "errors", "rates", "transform",
+    "find", "palindrome", "orf", "position", "json", "binary", "hex", "key", "hash", "encrypt", "decrypt",
+    "qrcode", "histogram", "compress", "complexity", "translate", "ascii", "stats", "summary", "csv", "stats_columns",
+    "export_stats", "fasta_export", "record", "hamming", "encrypt_file", "decrypt_file"
+};
 
-    int len = strlen(sequence);
-    int size = 21;
-    int block = 0;
+typedef struct {
+    int64_t calls;
+    int64_t total_ns;
+    int64_t min_ns;
+    int64_t max_ns;
+    int64_t bytes;
+    int64_t allocations;
+    int64_t allocated_bytes;
+} profile_stage;
 
-    for (int y = 0; y < size; y++) 
-    {
-        for (int x = 0; x < size; x++) 
-        {
-            if (block >= len) 
-            {
-                log_printf("[ ]");
-            } 
-            else 
-            {
-                char bit = sequence[block] % 2;
+typedef struct {
+    int stage;
+    int64_t start_ns;
+    int64_t duration_ns;
+} profile_event;
 
-                if (bit == 1) 
-                {
-                    log_printf("[#]");
-                } 
-                else 
-                {
-                    log_printf("[ ]");
-                }
+typedef struct {
+    int64_t start_ns;
+    int64_t allocations;
+    int64_t allocated_bytes;
+} profile_mark;
 
-                block++;
-            }
-        }
+typedef struct {
+    int enabled;
+    int64_t start_ns;
+    profile_stage stages[STAGE_COUNT];
+    profile_event *events;
+    int event_count;
+    int event_capacity;
+    int events_dropped;
+} profile_state;
+
+static profile_state profiler;
+
+void profile_start(void)
+{
+    memset(&profiler, 0, sizeof(profiler));
+    profiler.enabled = 1;
+    profiler.start_ns = now_ns();
 
-        log_printf("\n");
+    for (int i = 0; i < STAGE_COUNT; i++) 
+    {
+        profiler.stages[i].min_ns = INT64_MAX;
     }
 }
 
-void print_histogram_horizontal(const char *sequence, int no_color) 
+profile_mark profile_begin(void)
 {
-    int a;
-    int c;
-    int g;
-    int t;
+    profile_mark mark = { 0, 0, 0 };
 
-    count_bases(sequence, &a, &c, &g, &t);
+    if (profiler.enabled) 
+    {
+        mark.allocations = load_allocation_counter(&alloc_count);
+        mark.allocated_bytes = load_allocation_counter(&alloc_bytes);
+        mark.start_ns = now_ns();
+    }
 
-    int max = a;
+    return mark;
+}
 
-    if (c > max) 
+#ifndef _WIN32
+static pthread_mutex_t profile_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+void profile_record(int stage, profile_mark mark, int64_t bytes, int64_t elapsed)
+{
+    profile_stage *s = &profiler.stages[stage];
+
+    s->calls++;
+    s->total_ns += elapsed;
+    s->bytes += bytes;
+    s->allocations += load_allocation_counter(&alloc_count) - mark.allocations;
+    s->allocated_bytes += load_allocation_counter(&alloc_bytes) - mark.allocated_bytes;
+
+    if (elapsed < s->min_ns) 
     {
-        max = c;
+        s->min_ns = elapsed;
     }
 
-    if (g > max) 
+    if (elapsed > s->max_ns) 
     {
-        max = g;
+        s->max_ns = elapsed;
     }
 
-    if (t > max) 
+    if (profiler.event_count == profiler.event_capacity) 
     {
-        max = t;
-    }
+        if (profiler.event_capacity >= PROFILE_MAX_EVENTS) 
+        {
+            profiler.events_dropped++;
+            return;
+        }
 
-    int scaled_a;
-    int scaled_c;
-    int scaled_g;
-    int scaled_t;
+        profiler.event_capacity = profiler.event_capacity == 0 ? 1024 : profiler.event_capacity * 2;
+        profiler.events = realloc(profiler.events, sizeof(profile_event) * profiler.event_capacity);
 
-    if (max <= BAR_WIDTH) 
-    {
-        scaled_a = a;
-        scaled_c = c;
-        scaled_g = g;
-        scaled_t = t;
-    } 
-    else 
-    {
-        scaled_a = (a * BAR_WIDTH) / max;
-        scaled_c = (c * BAR_WIDTH) / max;
-        scaled_g = (g * BAR_WIDTH) / max;
-        scaled_t = (t * BAR_WIDTH) / max;
+        if (profiler.events == NULL) 
+        {
+            fprintf(stderr, "Error: Out of memory (profile events).\n");
+            exit(1);
+        }
     }
 
-    if (!no_color) 
-    {
-        log_printf("\033[31m");
-    }
+    profile_event *event = &profiler.events[profiler.event_count++];
 
-    log_printf("A: ");
+    event->stage = stage;
+    event->start_ns = mark.start_ns - profiler.start_ns;
+    event->duration_ns = elapsed;
+}
 
-    for (int i = 0; i < scaled_a; i++) 
+void profile_end(int stage, profile_mark mark, int64_t bytes)
+{
+    if (!profiler.enabled) 
     {
-        log_printf("#");
+        return;
     }
 
-    for (int i = scaled_a; i < BAR_WIDTH; i++) 
-    {
-        log_printf(" ");
-    }
+    int64_t elapsed = now_ns() - mark.start_ns;
 
-    if (!no_color) 
+#ifndef _WIN32
+    pthread_mutex_lock(&profile_lock);
+#endif
+    profile_record(stage, mark, bytes, elapsed);
+#ifndef _WIN32
+    pthread_mutex_unlock(&profile_lock);
+#endif
+}
+
+void profile_end_sequence(int stage, profile_mark mark, const char *sequence)
+{
+    if (profiler.enabled) 
     {
-        log_printf("\033[0m");
+        profile_end(stage, mark, strlen(sequence));
     }
+}
 
-    log_printf(" (%d)\n", a);
+void profile_write_json(FILE *out, int64_t wall_ns)
+{
+    int first = 1;
 
-    if (!no_color) 
+    fprintf(out, "{\n");
+    fprintf(out, "  \"wall_ns\": %lld,\n", (long long)wall_ns);
+    fprintf(out, "  \"peak_rss_kb\": %lld,\n", (long long)peak_rss_kb());
+    fprintf(out, "  \"stages\": [");
+
+    for (int i = 0; i < STAGE_COUNT; i++) 
     {
-        log_printf("\033[32m");
-    }
+        const profile_stage *s = &profiler.stages[i];
 
-    log_printf("C: ");
+        if (s->calls == 0) 
+        {
+            continue;
+        }
 
-    for (int i = 0; i < scaled_c; i++) 
-    {
-        log_printf("#");
+        fprintf(out, "%s\n    {\"name\": \"%s\", \"calls\": %lld, \"total_ns\": %lld, \"min_ns\": %lld, \"max_ns\": %lld, \"mean_ns\": %.1f, \"bytes\": %lld, \"allocations\": %lld, \"allocated_bytes\": %lld}",
+            first ? "" : ",", profile_stage_names[i], (long long)s->calls, (long long)s->total_ns, (long long)s->min_ns, (long long)s->max_ns,
+            (double)s->total_ns / s->calls, (long long)s->bytes, (long long)s->allocations, (long long)s->allocated_bytes);
+        first = 0;
     }
 
-    for (int i = scaled_c; i < BAR_WIDTH; i++) 
-    {
-        log_printf(" ");
-    }
+    fprintf(out, "\n  ]\n");
+    fprintf(out, "}\n");
+}
 
-    if (!no_color) 
+void profile_write_trace(FILE *out)
+{
+    fprintf(out, "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [");
+
+    for (int i = 0; i < profiler.event_count; i++) 
     {
-        log_printf("\033[0m");
+        const profile_event *event = &profiler.events[i];
+
+        fprintf(out, "%s\n  {\"name\": \"%s\", \"cat\": \"stage\", \"ph\": \"X\", \"pid\": 1, \"tid\": 1, \"ts\": %.3f, \"dur\": %.3f}",
+            i == 0 ? "" : ",", profile_stage_names[event->stage], event->start_ns / 1000.0, event->duration_ns / 1000.0);
     }
 
-    log_printf(" (%d)\n", c);
+    fprintf(out, "\n]}\n");
+}
 
-    if (!no_color) 
+void profile_report(const options *config)
+{
+    if (!profiler.enabled) 
     {
-        log_printf("\033[34m");
+        return;
     }
 
-    log_printf("G: ");
+    int64_t wall_ns = now_ns() - profiler.start_ns;
+    int order[STAGE_COUNT];
+    int count = 0;
 
-    for (int i = 0; i < scaled_g; i++) 
+    for (int i = 0; i < STAGE_COUNT; i++) 
     {
-        log_printf("#");
-    }
+        if (profiler.stages[i].calls == 0) 
+        {
+            continue;
+        }
 
-    for (int i = scaled_g; i < BAR_WIDTH; i++) 
-    {
-        log_printf(" ");
-    }
+        int j = count++;
 
-    if (!no_color) 
-    {
-        log_printf("\033[0m");
+        while (j > 0 && profiler.stages[order[j - 1]].total_ns < profiler.stages[i].total_ns) 
+        {
+            order[j] = order[j - 1];
+            j--;
+        }
+
+        order[j] = i;
     }
 
-    log_printf(" (%d)\n", g);
+    log_printf("\n=== Profile ===\n\n");
+    log_printf("%-20s %8s %12s %7s %12s %12s %8s\n", "Stage", "Calls", "Total (ms)", "%Wall", "Mean (us)", "Bytes", "Allocs");
 
-    if (!no_color) 
+    for (int k = 0; k < count; k++) 
     {
-        log_printf("\033[33m");
+        const profile_stage *s = &profiler.stages[order[k]];
+
+        log_printf("%-20s %8lld %12.3f %6.1f%% %12.3f %12lld %8lld\n", profile_stage_names[order[k]], (long long)s->calls, s->total_ns / 1e6,
+            wall_ns > 0 ? 100.0 * s->total_ns / wall_ns : 0.0, s->total_ns / 1e3 / s->calls, (long long)s->bytes, (long long)s->allocations);
     }
 
-    log_printf("T: ");
+    log_printf("\nWall time: %.3f ms\n", wall_ns / 1e6);
 
-    for (int i = 0; i < scaled_t; i++) 
+    if (global_arena.peak > 0) 
     {
-        log_printf("#");
+        log_printf("Scratch arena peak: %zu bytes\n", global_arena.peak);
     }
 
-    for (int i = scaled_t; i < BAR_WIDTH; i++) 
+    if (profiler.events_dropped > 0) 
     {
-        log_printf(" ");
+        log_printf("Trace events dropped: %d\n", profiler.events_dropped);
     }
 
-    if (!no_color) 
+    if (config->profile_output_file[0] != '\0') 
     {
-        log_printf("\033[0m");
+        FILE *out = fopen(config->profile_output_file, "w");
+
+        if (out == NULL) 
+        {
+            log_printf("Error: Could not open output file '%s'\n", config->profile_output_file);
+        }
+        else 
+        {
+            if (config->profile_trace) 
+            {
+                profile_write_trace(out);
+            }
+            else 
+            {
+                profile_write_json(out, wall_ns);
+            }
+
+            fclose(out);
+            log_printf("Profile written to %s\n", config->profile_output_file);
+        }
     }
 
-    log_printf(" (%d)\n", t);
+    log_printf("\n");
+
+    free(profiler.events);
+    profiler.events = NULL;
+    profiler.enabled = 0;
 }
 
-void print_histogram_vertical(const char *sequence, int no_color)
+int64_t file_tell(FILE *file)
 {
-    int a, c, g, t;
-    count_bases(sequence, &a, &c, &g, &t);
+#ifdef _WIN32
+    return _ftelli64(file);
+#else
+    return (int64_t)ftello(file);
+#endif
+}
 
-    int max = a;
+#ifdef _WIN32
+typedef int worker_mutex;
 
-    if (c > max) 
-    {
-        max = c;
-    }
+void worker_mutex_init(worker_mutex *mutex)
+{
+    *mutex = 0;
+}
 
-    if (g > max) 
+void worker_mutex_lock(worker_mutex *mutex)
+{
+    (void)mutex;
+}
+
+void worker_mutex_unlock(worker_mutex *mutex)
+{
+    (void)mutex;
+}
+
+void worker_mutex_destroy(worker_mutex *mutex)
+{
+    (void)mutex;
+}
+
+int default_thread_count(void)
+{
+    return 1;
+}
+
+void run_workers(int count, void *(*routine)(void *), void *args, size_t arg_size)
+{
+    for (int i = 0; i < count; i++) 
     {
-        max = g;
+        routine((char *)args + i * arg_size);
     }
+}
+#else
+typedef pthread_mutex_t worker_mutex;
 
-    if (t > max) 
+void worker_mutex_init(worker_mutex *mutex)
+{
+    pthread_mutex_init(mutex, NULL);
+}
+
+void worker_mutex_lock(worker_mutex *mutex)
+{
+    pthread_mutex_lock(mutex);
+}
+
+void worker_mutex_unlock(worker_mutex *mutex)
+{
+    pthread_mutex_unlock(mutex);
+}
+
+void worker_mutex_destroy(worker_mutex *mutex)
+{
+    pthread_mutex_destroy(mutex);
+}
+
+int default_thread_count(void)
+{
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+
+    if (online < 1) 
     {
-        max = t;
+        return 1;
     }
 
-    int height = BAR_HEIGHT;
+    return (int)online;
+}
 
-    if (max < BAR_HEIGHT && max > 0)
+void run_workers(int count, void *(*routine)(void *), void *args, size_t arg_size)
+{
+    if (count <= 1) 
     {
-        height = max;
+        routine(args);
+        return;
     }
 
-    log_printf("\n=== DNA Base Distribution Histogram (vertical) ===\n\n");
+    pthread_t *threads = xmalloc(sizeof(pthread_t) * count);
+    int *started = xmalloc(sizeof(int) * count);
 
-    for (int row = height; row > 0; row--) 
+    for (int i = 1; i < count; i++) 
     {
-        if (!no_color) 
+        started[i] = pthread_create(&threads[i], NULL, routine, (char *)args + i * arg_size) == 0;
+
+        if (!started[i]) 
         {
-            log_printf("\033[31m");
+            routine((char *)args + i * arg_size);
         }
+    }
 
-        log_printf(" ");
+    routine(args);
 
-        if (a >= row) 
-        {
-            log_printf("#");
-        } 
-        else 
+    for (int i = 1; i < count; i++) 
+    {
+        if (started[i]) 
         {
-            log_printf(" ");
+            pthread_join(threads[i], NULL);
         }
+    }
 
-        if (!no_color) 
-        {
-            log_printf("\033[0m");
-        }
+    free(started);
+    free(threads);
+}
+#endif
 
-        if (!no_color) 
-        {
-            log_printf("\033[32m");
-        }
+typedef struct io_request {
+    int op;
+    int fd;
+    char *data;
+    size_t length;
+    int64_t offset;
+    int64_t result;
+    int done;
+#ifndef _WIN32
+    struct iovec vector;
+#endif
+    struct io_request *next;
+} io_request;
 
-        log_printf(" ");
+typedef struct {
+    int backend;
+#if defined(__linux__) && defined(__NR_io_uring_setup)
+    int ring_fd;
+    unsigned *sq_tail;
+    unsigned *sq_mask;
+    unsigned *sq_array;
+    unsigned *cq_head;
+    unsigned *cq_tail;
+    unsigned *cq_mask;
+    struct io_uring_sqe *sqes;
+    struct io_uring_cqe *cqes;
+    void *sq_ring;
+    void *cq_ring;
+    size_t sq_ring_size;
+    size_t cq_ring_size;
+    size_t sqes_size;
+#endif
+} io_queue;
 
-        if (c >= row) 
-        {
-            log_printf("#");
-        } 
-        else 
-        {
-            log_printf(" ");
-        }
+static int io_backend = IO_AUTO;
 
-        if (!no_color) 
-        {
-            log_printf("\033[0m");
-        }
+int io_open(const char *filename, int op)
+{
+#ifdef _WIN32
+    return op == IO_READ ? _open(filename, _O_RDONLY | _O_BINARY) : _open(filename, _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+    return op == IO_READ ? open(filename, O_RDONLY) : open(filename, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+#endif
+}
 
-        if (!no_color) 
-        {
-            log_printf("\033[34m");
-        }
+void io_close(int fd)
+{
+#ifdef _WIN32
+    _close(fd);
+#else
+    close(fd);
+#endif
+}
 
-        log_printf(" ");
+int64_t io_transfer(io_request *request)
+{
+    size_t total = 0;
 
-        if (g >= row) 
-        {
-            log_printf("#");
-        } 
-        else 
-        {
-            log_printf(" ");
-        }
+    while (total < request->length) 
+    {
+#ifdef _WIN32
+        int count;
 
-        if (!no_color) 
-        {
-            log_printf("\033[0m");
-        }
+        _lseeki64(request->fd, request->offset + (int64_t)total, SEEK_SET);
+        count = request->op == IO_READ ? _read(request->fd, request->data + total, (unsigned)(request->length - total)) : _write(request->fd, request->data + total, (unsigned)(request->length - total));
+#else
+        ssize_t count = request->op == IO_READ ? pread(request->fd, request->data + total, request->length - total, (off_t)(request->offset + total)) : pwrite(request->fd, request->data + total, request->length - total, (off_t)(request->offset + total));
+#endif
 
-        if (!no_color) 
+        if (count < 0) 
         {
-            log_printf("\033[33m");
-        }
-
-        log_printf(" ");
+            if (errno == EINTR) 
+            {
+                continue;
+            }
 
-        if (t >= row) 
-        {
-            log_printf("#");
-        } 
-        else 
-        {
-            log_printf(" ");
+            return -1;
         }
 
-        if (!no_color) 
+        if (count == 0) 
         {
-            log_printf("\033[0m");
+            break;
         }
 
-        log_printf("\n");
+        total += (size_t)count;
     }
 
-    log_printf(" A C G T\n");
+    return (int64_t)total;
+}
 
-    log_printf("(%d %d %d %d)\n", a, c, g, t);
+void io_complete(io_request *request, int64_t result)
+{
+    if (result < 0) 
+    {
+        result = io_transfer(request);
+    }
+    else if ((size_t)result < request->length) 
+    {
+        io_request rest = *request;
+
+        rest.data += result;
+        rest.length -= (size_t)result;
+        rest.offset += result;
+
+        int64_t more = io_transfer(&rest);
+
+        result = more < 0 ? -1 : result + more;
+    }
+
+    request->result = result;
+    request->done = 1;
 }
 
-void compress_sequence(const char *input, char *output) 
+#ifndef _WIN32
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t ready;
+    pthread_cond_t finished;
+    io_request *head;
+    io_request *tail;
+    int started;
+} io_thread_pool;
+
+static io_thread_pool io_pool = {PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, PTHREAD_COND_INITIALIZER, NULL, NULL, 0};
+
+void *io_pool_worker(void *arg)
 {
-    int i = 0;
-    int out = 0;
+    (void)arg;
 
-    while (input[i] != '\0') 
-    {
-        char base = input[i];
-        int count = 1;
+    pthread_mutex_lock(&io_pool.lock);
 
-        while (input[i + count] != '\0' && input[i + count] == base) 
+    while (1) 
+    {
+        while (io_pool.head == NULL) 
         {
-            count++;
+            pthread_cond_wait(&io_pool.ready, &io_pool.lock);
         }
 
-        output[out++] = base;
-
-        int digits = 0;
-        int temp = count;
+        io_request *request = io_pool.head;
 
-        do 
-        {
-            digits++;
-            temp = temp / 10;
-        } 
-        while (temp > 0);
+        io_pool.head = request->next;
 
-        for (int d = digits - 1; d >= 0; d--) 
+        if (io_pool.head == NULL) 
         {
-            int digit = (count / (int)pow(10, d)) % 10;
-            output[out++] = '0' + digit;
+            io_pool.tail = NULL;
         }
 
-        i = i + count;
+        pthread_mutex_unlock(&io_pool.lock);
+
+        int64_t result = io_transfer(request);
+
+        pthread_mutex_lock(&io_pool.lock);
+        request->result = result;
+        request->done = 1;
+        pthread_cond_broadcast(&io_pool.finished);
     }
 
-    output[out] = '\0';
+    return NULL;
 }
 
-void decompress_sequence(const char *input, char *output) 
+void io_pool_submit(io_request *request)
 {
-    int in = 0;
-    int out = 0;
+    pthread_mutex_lock(&io_pool.lock);
 
-    while (input[in] != '\0') 
+    if (!io_pool.started) 
     {
-        char base = input[in];
-
-        if (!is_valid_base(base)) 
+        for (int t = 0; t < IO_THREADS; t++) 
         {
-            output[out] = '\0';
-            return;
-        }
-
-        in++;
-
-        int count = 0;
+            pthread_t thread;
 
-        while (isdigit(input[in])) 
-        {
-            count = count * 10 + (input[in] - '0');
-            in++;
+            if (pthread_create(&thread, NULL, io_pool_worker, NULL) == 0) 
+            {
+                pthread_detach(thread);
+                io_pool.started++;
+            }
         }
 
-        if (count == 0) 
+        if (!io_pool.started) 
         {
-            output[out] = '\0';
+            pthread_mutex_unlock(&io_pool.lock);
+            io_complete(request, -1);
             return;
         }
-
-        for (int i = 0; i < count && out < MAX_DNA_LENGTH - 1; i++) 
-        {
-            output[out++] = base;
-        }
     }
 
-    output[out] = '\0';
-}
-
-void print_compressed(const char *sequence) 
-{
-    char compressed[MAX_COMPRESSED_LENGTH];
+    request->next = NULL;
 
-    compress_sequence(sequence, compressed);
+    if (io_pool.tail != NULL) 
+    {
+        io_pool.tail->next = request;
+    }
+    else 
+    {
+        io_pool.head = request;
+    }
 
-    log_printf("\n=== Compressed Sequence ===\n\n");
-    log_printf("%s\n", compressed);
+    io_pool.tail = request;
+    pthread_cond_signal(&io_pool.ready);
+    pthread_mutex_unlock(&io_pool.lock);
 }
 
-void print_decompressed(const char *sequence) 
+void io_pool_wait(io_request *request)
 {
-    char decompressed[MAX_DNA_LENGTH];
+    pthread_mutex_lock(&io_pool.lock);
 
-    decompress_sequence(sequence, decompressed);
+    while (!request->done) 
+    {
+        pthread_cond_wait(&io_pool.finished, &io_pool.lock);
+    }
 
-    log_printf("\n=== Decompressed Sequence ===\n\n");
-    log_printf("%s\n", decompressed);
+    pthread_mutex_unlock(&io_pool.lock);
 }
+#endif
 
-void encrypt_file(const char *dna_sequence, const char *input_filename, const char *output_filename) 
+#if defined(__linux__) && defined(__NR_io_uring_setup)
+int io_uring_queue_init(io_queue *queue, unsigned depth)
 {
-    unsigned char key[KEY_SIZE];
-
-    derive_key_bytes(dna_sequence, key);
+    struct io_uring_params params;
 
-    FILE *fin = fopen(input_filename, "rb");
+    memset(&params, 0, sizeof(params));
+    queue->ring_fd = (int)syscall(__NR_io_uring_setup, depth, &params);
 
-    if (fin == NULL) 
+    if (queue->ring_fd < 0) 
     {
-        log_printf("Error: Could not open input file '%s'\n", input_filename);
-        return;
+        return 0;
     }
 
-    FILE *fout = fopen(output_filename, "wb");
+    queue->sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    queue->cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    queue->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
 
-    if (fout == NULL) 
+    if (params.features & IORING_FEAT_SINGLE_MMAP) 
     {
-        fclose(fin);
-        log_printf("Error: Could not open output file '%s'\n", output_filename);
-        return;
+        if (queue->cq_ring_size > queue->sq_ring_size) 
+        {
+            queue->sq_ring_size = queue->cq_ring_size;
+        }
+
+        queue->cq_ring_size = queue->sq_ring_size;
     }
 
-    log_printf("\n=== File Encryption ===\n\n");
-    log_printf("Input : %s\n", input_filename);
-    log_printf("Output: %s\n", output_filename);
+    queue->sq_ring = mmap(NULL, queue->sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, queue->ring_fd, IORING_OFF_SQ_RING);
+    queue->cq_ring = queue->sq_ring;
 
-    int i = 0;
-    int ch;
+    if (queue->sq_ring != MAP_FAILED && !(params.features & IORING_FEAT_SINGLE_MMAP)) 
+    {
+        queue->cq_ring = mmap(NULL, queue->cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, queue->ring_fd, IORING_OFF_CQ_RING);
+    }
 
-    while ((ch = fgetc(fin)) != EOF) 
+    queue->sqes = queue->sq_ring == MAP_FAILED || queue->cq_ring == MAP_FAILED ? MAP_FAILED : mmap(NULL, queue->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, queue->ring_fd, IORING_OFF_SQES);
+
+    if (queue->sqes == MAP_FAILED) 
     {
-        unsigned char encrypted = ((unsigned char)ch) ^ key[i % KEY_SIZE];
-        fputc(encrypted, fout);
-        i++;
+        if (queue->cq_ring != MAP_FAILED && queue->cq_ring != queue->sq_ring) 
+        {
+            munmap(queue->cq_ring, queue->cq_ring_size);
+        }
+
+        if (queue->sq_ring != MAP_FAILED) 
+        {
+            munmap(queue->sq_ring, queue->sq_ring_size);
+        }
+
+        close(queue->ring_fd);
+        return 0;
     }
 
-    fclose(fin);
-    fclose(fout);
+    char *sq = queue->sq_ring;
+    char *cq = queue->cq_ring;
 
-    log_printf("File encrypted successfully.\n");
+    queue->sq_tail = (unsigned *)(sq + params.sq_off.tail);
+    queue->sq_mask = (unsigned *)(sq + params.sq_off.ring_mask);
+    queue->sq_array = (unsigned *)(sq + params.sq_off.array);
+    queue->cq_head = (unsigned *)(cq + params.cq_off.head);
+    queue->cq_tail = (unsigned *)(cq + params.cq_off.tail);
+    queue->cq_mask = (unsigned *)(cq + params.cq_off.ring_mask);
+    queue->cqes = (struct io_uring_cqe *)(cq + params.cq_off.cqes);
+
+    return 1;
 }
 
-void decrypt_file(const char *dna_sequence, const char *input_filename, const char *output_filename) 
+void io_uring_queue_push(io_queue *queue, io_request *request)
 {
-    unsigned char key[KEY_SIZE];
+    unsigned tail = *queue->sq_tail;
+    unsigned index = tail & *queue->sq_mask;
+    struct io_uring_sqe *sqe = &queue->sqes[index];
 
-    derive_key_bytes(dna_sequence, key);
+    request->vector.iov_base = request->data;
+    request->vector.iov_len = request->length;
 
-    FILE *fin = fopen(input_filename, "rb");
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = request->op == IO_READ ? IORING_OP_READV : IORING_OP_WRITEV;
+    sqe->fd = request->fd;
+    sqe->addr = (uint64_t)(uintptr_t)&request->vector;
+    sqe->len = 1;
+    sqe->off = (uint64_t)request->offset;
+    sqe->user_data = (uint64_t)(uintptr_t)request;
 
-    if (fin == NULL) 
-    {
-        log_printf("Error: Could not open input file '%s'\n", input_filename);
-        return;
-    }
+    queue->sq_array[index] = index;
+    __atomic_store_n(queue->sq_tail, tail + 1, __ATOMIC_RELEASE);
 
-    FILE *fout = fopen(output_filename, "wb");
+    long submitted;
 
-    if (fout == NULL) 
+    do 
     {
-        fclose(fin);
-        log_printf("Error: Could not open output file '%s'\n", output_filename);
-        return;
-    }
+        submitted = syscall(__NR_io_uring_enter, queue->ring_fd, 1, 0, 0, NULL, 0);
+    } 
+    while (submitted < 0 && errno == EINTR);
 
-    log_printf("\n=== File Decryption ===\n\n");
-    log_printf("Input : %s\n", input_filename);
-    log_printf("Output: %s\n", output_filename);
+    if (submitted < 1) 
+    {
+        __atomic_store_n(queue->sq_tail, tail, __ATOMIC_RELEASE);
+        io_complete(request, -1);
+    }
+}
 
-    int i = 0;
-    int ch;
+void io_uring_queue_reap(io_queue *queue)
+{
+    unsigned head = *queue->cq_head;
 
-    while ((ch = fgetc(fin)) != EOF) 
+    if (head == __atomic_load_n(queue->cq_tail, __ATOMIC_ACQUIRE)) 
     {
-        unsigned char decrypted = ((unsigned char)ch) ^ key[i % KEY_SIZE];
-        fputc(decrypted, fout);
-        i++;
+        syscall(__NR_io_uring_enter, queue->ring_fd, 0, 1, IORING_ENTER_GETEVENTS, NULL, 0);
     }
 
-    fclose(fin);
-    fclose(fout);
+    while (head != __atomic_load_n(queue->cq_tail, __ATOMIC_ACQUIRE)) 
+    {
+        struct io_uring_cqe *cqe = &queue->cqes[head & *queue->cq_mask];
 
-    log_printf("File decrypted successfully.\n");
+        io_complete((io_request *)(uintptr_t)cqe->user_data, cqe->res);
+        head++;
+    }
+
+    __atomic_store_n(queue->cq_head, head, __ATOMIC_RELEASE);
 }
+#endif
 
-void print_complexity(const char *sequence) 
+void io_queue_init(io_queue *queue)
 {
-    int a, c, g, t;
-    count_bases(sequence, &a, &c, &g, &t);
-    int total = a + c + g + t;
+    memset(queue, 0, sizeof(*queue));
+    queue->backend = IO_SYNC;
 
-    if (total == 0) 
+#if defined(__linux__) && defined(__NR_io_uring_setup)
+    if ((io_backend == IO_AUTO || io_backend == IO_URING) && io_uring_queue_init(queue, IO_QUEUE_DEPTH)) 
     {
-        log_printf("\n=== Sequence Complexity ===\n\n");
-        log_printf("Sequence is empty.\n");
+        queue->backend = IO_URING;
         return;
     }
+#endif
 
-    double pa = (double)a / total;
-    double pc = (double)c / total;
-    double pg = (double)g / total;
-    double pt = (double)t / total;
-
-    double entropy = 0.0;
-
-    if (pa > 0) 
+#ifndef _WIN32
+    if (io_backend != IO_SYNC) 
     {
-        entropy -= pa * log2(pa);
+        queue->backend = IO_THREADED;
+    }
+#endif
+}
+
+void io_queue_submit(io_queue *queue, io_request *request)
+{
+    request->done = 0;
+    request->result = 0;
+
+#if defined(__linux__) && defined(__NR_io_uring_setup)
+    if (queue->backend == IO_URING) 
+    {
+        io_uring_queue_push(queue, request);
+        return;
+    }
+#endif
+
+#ifndef _WIN32
+    if (queue->backend == IO_THREADED) 
+    {
+        io_pool_submit(request);
+        return;
+    }
+#endif
+
+    io_complete(request, -1);
+}
+
+void io_queue_wait(io_queue *queue, io_request *request)
+{
+#if defined(__linux__) && defined(__NR_io_uring_setup)
+    if (queue->backend == IO_URING) 
+    {
+        while (!request->done) 
+        {
+            io_uring_queue_reap(queue);
+        }
+
+        return;
+    }
+#endif
+
+#ifndef _WIN32
+    if (queue->backend == IO_THREADED) 
+    {
+        io_pool_wait(request);
+    }
+#endif
+
+    (void)queue;
+}
+
+void io_queue_close(io_queue *queue)
+{
+#if defined(__linux__) && defined(__NR_io_uring_setup)
+    if (queue->backend == IO_URING) 
+    {
+        munmap(queue->sqes, queue->sqes_size);
+
+        if (queue->cq_ring != queue->sq_ring) 
+        {
+            munmap(queue->cq_ring, queue->cq_ring_size);
+        }
+
+        munmap(queue->sq_ring, queue->sq_ring_size);
+        close(queue->ring_fd);
+    }
+#endif
+
+    queue->backend = IO_SYNC;
+}
+
+int io_is_regular(const char *filename, int missing_ok)
+{
+    struct stat info;
+
+    if (stat(filename, &info) != 0) 
+    {
+        return missing_ok;
+    }
+
+    return (info.st_mode & S_IFMT) == S_IFREG;
+}
+
+typedef struct {
+    io_queue queue;
+    io_request requests[IO_QUEUE_DEPTH];
+    int busy[IO_QUEUE_DEPTH];
+    char *storage;
+    int fd;
+    int head;
+    int held;
+    int64_t size;
+    int64_t next_offset;
+    int64_t end;
+} io_reader;
+
+void io_reader_submit(io_reader *reader, int slot)
+{
+    io_request *request = &reader->requests[slot];
+
+    if (reader->next_offset >= reader->end) 
+    {
+        return;
+    }
+
+    request->op = IO_READ;
+    request->fd = reader->fd;
+    request->offset = reader->next_offset;
+    request->length = reader->end - reader->next_offset < IO_BLOCK_SIZE ? (size_t)(reader->end - reader->next_offset) : IO_BLOCK_SIZE;
+    reader->next_offset += request->length;
+    reader->busy[slot] = 1;
+    io_queue_submit(&reader->queue, request);
+}
+
+void io_reader_drain(io_reader *reader)
+{
+    for (int slot = 0; slot < IO_QUEUE_DEPTH; slot++) 
+    {
+        if (reader->busy[slot]) 
+        {
+            io_queue_wait(&reader->queue, &reader->requests[slot]);
+            reader->busy[slot] = 0;
+        }
+    }
+}
+
+void io_reader_start(io_reader *reader, int64_t offset, int64_t length)
+{
+    io_reader_drain(reader);
+
+    reader->end = length < 0 || offset + length > reader->size ? reader->size : offset + length;
+    reader->next_offset = offset;
+    reader->head = 0;
+    reader->held = -1;
+
+    for (int slot = 0; slot < IO_QUEUE_DEPTH; slot++) 
+    {
+        io_reader_submit(reader, slot);
+    }
+}
+
+int io_reader_open(io_reader *reader, const char *filename)
+{
+    memset(reader, 0, sizeof(*reader));
+
+    if (!io_is_regular(filename, 0)) 
+    {
+        return 0;
+    }
+
+    reader->fd = io_open(filename, IO_READ);
+
+    if (reader->fd < 0) 
+    {
+        return 0;
+    }
+
+#ifdef _WIN32
+    reader->size = _lseeki64(reader->fd, 0, SEEK_END);
+#else
+    reader->size = (int64_t)lseek(reader->fd, 0, SEEK_END);
+#endif
+    reader->storage = xmalloc((size_t)IO_BLOCK_SIZE * IO_QUEUE_DEPTH);
+
+    for (int slot = 0; slot < IO_QUEUE_DEPTH; slot++) 
+    {
+        reader->requests[slot].data = reader->storage + (size_t)slot * IO_BLOCK_SIZE;
+    }
+
+    io_queue_init(&reader->queue);
+    io_reader_start(reader, 0, -1);
+
+    return 1;
+}
+
+int64_t io_reader_next(io_reader *reader, char **data)
+{
+    if (reader->held >= 0) 
+    {
+        io_reader_submit(reader, reader->held);
+        reader->held = -1;
+    }
+
+    int slot = reader->head;
+    io_request *request = &reader->requests[slot];
+
+    if (!reader->busy[slot]) 
+    {
+        return 0;
+    }
+
+    io_queue_wait(&reader->queue, request);
+    reader->busy[slot] = 0;
+    reader->head = (slot + 1) % IO_QUEUE_DEPTH;
+
+    if (request->result <= 0) 
+    {
+        reader->next_offset = reader->end;
+        return request->result;
+    }
+
+    reader->held = slot;
+    *data = request->data;
+
+    return request->result;
+}
+
+void io_reader_close(io_reader *reader)
+{
+    io_reader_drain(reader);
+    io_queue_close(&reader->queue);
+    io_close(reader->fd);
+    free(reader->storage);
+    reader->storage = NULL;
+}
+
+typedef struct {
+    io_queue queue;
+    io_request requests[IO_QUEUE_DEPTH];
+    int busy[IO_QUEUE_DEPTH];
+    char *storage;
+    int fd;
+    int current;
+    int64_t offset;
+    int failed;
+} io_writer;
+
+int io_writer_open(io_writer *writer, const char *filename, size_t capacity)
+{
+    memset(writer, 0, sizeof(*writer));
+
+    if (!io_is_regular(filename, 1)) 
+    {
+        return 0;
+    }
+
+    writer->fd = io_open(filename, IO_WRITE);
+
+    if (writer->fd < 0) 
+    {
+        return 0;
+    }
+
+    writer->storage = xmalloc(capacity * IO_QUEUE_DEPTH);
+
+    for (int slot = 0; slot < IO_QUEUE_DEPTH; slot++) 
+    {
+        writer->requests[slot].data = writer->storage + capacity * slot;
+    }
+
+    io_queue_init(&writer->queue);
+
+    return 1;
+}
+
+void io_writer_settle(io_writer *writer, int slot)
+{
+    if (writer->busy[slot]) 
+    {
+        io_queue_wait(&writer->queue, &writer->requests[slot]);
+        writer->failed |= writer->requests[slot].result != (int64_t)writer->requests[slot].length;
+        writer->busy[slot] = 0;
+    }
+}
+
+char *io_writer_buffer(io_writer *writer)
+{
+    return writer->requests[writer->current].data;
+}
+
+char *io_writer_submit(io_writer *writer, size_t length)
+{
+    if (length > 0) 
+    {
+        io_request *request = &writer->requests[writer->current];
+
+        request->op = IO_WRITE;
+        request->fd = writer->fd;
+        request->length = length;
+        request->offset = writer->offset;
+        writer->offset += length;
+        writer->busy[writer->current] = 1;
+        io_queue_submit(&writer->queue, request);
+
+        writer->current = (writer->current + 1) % IO_QUEUE_DEPTH;
+        io_writer_settle(writer, writer->current);
+    }
+
+    return io_writer_buffer(writer);
+}
+
+int io_writer_close(io_writer *writer)
+{
+    for (int slot = 0; slot < IO_QUEUE_DEPTH; slot++) 
+    {
+        io_writer_settle(writer, slot);
+    }
+
+    io_queue_close(&writer->queue);
+
+#ifdef _WIN32
+    writer->failed |= _close(writer->fd) != 0;
+#else
+    writer->failed |= close(writer->fd) != 0;
+#endif
+    free(writer->storage);
+    writer->storage = NULL;
+
+    return !writer->failed;
+}
+
+void print_base(char base) 
+{
+    if (base == 'A') 
+    {
+        log_printf("[A]");
+    } 
+    else if (base == 'C') 
+    {
+        log_printf("[C]");
+    } 
+    else if (base == 'G') 
+    {
+        log_printf("[G]");
+    } 
+    else if (base == 'T') 
+    {
+        log_printf("[T]");
+    } 
+    else 
+    {
+        log_printf("[?]");
+    }
+}
+
+void print_sequence(const char *sequence) 
+{
+    log_printf("\n=== ASCII View ===\n\n");
+
+    int count = 0;
+
+    for (int i = 0; sequence[i] != '\0'; i++) 
+    {
+        print_base(sequence[i]);
+        count++;
+
+        if (count % 32 == 0) 
+        {
+            log_printf("\n");
+        }
+    }
+
+    if (count % 32 != 0) 
+    {
+        log_printf("\n");
+    }
+}
+
+void print_match_marked(const sequence_view *view, int start, int pat_len, int color) 
+{
+    for (int i = 0; i < view->length; i++) 
+    {
+        char base = sequence_view_at(view, i);
+
+        if (i >= start && i < start + pat_len) 
+        {
+            if (!color) 
+            {
+                print_base(base);
+            } 
+            else 
+            {
+                log_printf("\033[42;30m");
+                print_base(base);
+                log_printf("\033[0m");
+            }
+        } 
+        else 
+        {
+            print_base(base);
+        }
+    }
+
+    log_printf("\n");
+}
+
+int find_pattern_positions(const char *sequence, int seq_len, const char *pattern, int *positions, int max_matches) 
+{
+    int pat_len = strlen(pattern);
+    int match_count = 0;
+
+    if (pat_len == 0 || pat_len > seq_len || pat_len >= MAX_DNA_LENGTH) 
+    {
+        return 0;
+    }
+
+    char upper_pattern[MAX_DNA_LENGTH];
+    for (int i = 0; i < pat_len; i++) 
+    {
+        upper_pattern[i] = toupper(pattern[i]);
+    }
+    upper_pattern[pat_len] = '\0';
+
+    for (int i = 0; i <= seq_len - pat_len && match_count < max_matches; i++) 
+    {
+        int match = 1;
+
+        for (int j = 0; j < pat_len; j++) 
+        {
+            if (toupper(sequence[i + j]) != upper_pattern[j]) 
+            {
+                match = 0;
+                break;
+            }
+        }
+
+        if (match) 
+        {
+            positions[match_count] = i;
+            match_count++;
+        }
+    }
+
+    return match_count;
+}
+
+int find_pattern_positions_view(const sequence_view *view, const char *pattern, int *positions, int max_matches) 
+{
+    int pat_len = strlen(pattern);
+    int match_count = 0;
+    view_cursor cursor;
+
+    if (pat_len == 0 || pat_len > view->length || pat_len > VIEW_BLOCK) 
+    {
+        return 0;
+    }
+
+    view_cursor_init(&cursor, view);
+
+    for (int64_t start = 0; start + pat_len <= view->length && match_count < max_matches; start += VIEW_BLOCK - pat_len + 1) 
+    {
+        int length = view->length - start < VIEW_BLOCK ? (int)(view->length - start) : VIEW_BLOCK;
+        const char *block = view_cursor_span(&cursor, start, length);
+        int found = find_pattern_positions(block, length, pattern, positions + match_count, max_matches - match_count);
+
+        for (int m = 0; m < found; m++) 
+        {
+            positions[match_count + m] += (int)start;
+        }
+
+        match_count += found;
+    }
+
+    return match_count;
+}
+
+void find_pattern_view(const sequence_view *view, const char *pattern, int color, int both_strands) 
+{
+    int seq_len = view->length;
+    int pat_len = strlen(pattern);
+    int positions[MAX_MATCHES];
+    int match_count = 0;
+
+    if (pat_len == 0) 
+    {
+        log_printf("\n=== Pattern Search: \"%s\" ===\n\n", pattern);
+        log_printf("No matches found.\n");
+        return;
+    }
+
+    if (seq_len == 0) 
+    {
+        log_printf("\n=== Pattern Search: \"%s\" ===\n\n", pattern);
+        log_printf("No matches found.\n");
+        return;
+    }
+
+    if (pat_len > seq_len) 
+    {
+        log_printf("\n=== Pattern Search: \"%s\" ===\n\n", pattern);
+        log_printf("No matches found.\n");
+        return;
+    }
+
+    log_printf("\n=== Pattern Search: \"%s\" ===\n\n", pattern);
+
+    match_count = find_pattern_positions_view(view, pattern, positions, MAX_MATCHES);
+
+    if (match_count == 0) 
+    {
+        log_printf("No matches found.\n");
+    }
+    else 
+    {
+        log_printf("Found %d match(es):\n\n", match_count);
+
+        for (int m = 0; m < match_count; m++) 
+        {
+            log_printf("%d. Position: %d\n", m + 1, positions[m] + 1);
+            print_match_marked(view, positions[m], pat_len, color ? 1 : 0);
+            log_printf("\n");
+        }
+    }
+
+    if (!both_strands) 
+    {
+        return;
+    }
+
+    sequence_view reverse = *view;
+
+    sequence_view_complement(&reverse);
+    sequence_view_reverse(&reverse);
+    match_count = find_pattern_positions_view(&reverse, pattern, positions, MAX_MATCHES);
+
+    log_printf("\nReverse strand: ");
+
+    if (match_count == 0) 
+    {
+        log_printf("No matches found.\n");
+        return;
+    }
+
+    log_printf("Found %d match(es):\n\n", match_count);
+
+    for (int m = 0; m < match_count; m++) 
+    {
+        int start = seq_len - positions[m] - pat_len;
+
+        log_printf("%d. Position: %d (-)\n", m + 1, start + 1);
+        print_match_marked(view, start, pat_len, color ? 1 : 0);
+        log_printf("\n");
+    }
+}
+
+void find_pattern(const char *sequence, const char *pattern, int color) 
+{
+    sequence_view view;
+
+    sequence_view_init(&view, (char *)sequence, strlen(sequence));
+    find_pattern_view(&view, pattern, color, 0);
+}
+
+void print_positions_of_base(const char *sequence, char base)
+{
+    log_printf("\n=== Positions of base '%c' ===\n\n", base);
+
+    int length = strlen(sequence);
+    int found = 0;
+
+    for (int i = 0; i < length; i++) 
+    {
+        if (sequence[i] == base) 
+        {
+            log_printf("%d\n", i);
+            found = 1;
+        }
+    }
+
+    if (!found) 
+    {
+        log_printf("Base '%c' not found in sequence.\n", base);
+    }
+
+    log_printf("\n");
+}
+
+void print_stats(const char *sequence) 
+{
+    int a;
+    int c;
+    int g;
+    int t;
+
+    count_bases(sequence, &a, &c, &g, &t);
+
+    log_printf("\n=== Base Statistics ===\n\n");
+
+    log_printf("A: %d\n", a);
+    log_printf("C: %d\n", c);
+    log_printf("G: %d\n", g);
+    log_printf("T: %d\n", t);
+}
+
+void print_summary(const char *sequence) 
+{
+    int a;
+    int c;
+    int g;
+    int t;
+
+    count_bases(sequence, &a, &c, &g, &t);
+
+    int total = a + c + g + t;
+    int gc = c + g;
+
+    log_printf("\n=== Summary ===\n\n");
+
+    log_printf("Total Length: %d\n", total);
+    log_printf("A: %d  C: %d  G: %d  T: %d\n", a, c, g, t);
+
+    if (total > 0) 
+    {
+        log_printf("GC Content: %.1f%%\n", (100.0 * gc / total));
+    } 
+    else 
+    {
+        log_printf("GC Content: 0.0%%\n");
+    }
+}
+
+void print_json(const char *sequence) 
+{
+    int a;
+    int c;
+    int g;
+    int t;
+
+    count_bases(sequence, &a, &c, &g, &t);
+
+    int total = a + c + g + t;
+    int gc = c + g;
+
+    log_printf("\n=== JSON Output ===\n\n");
+
+    log_printf("{\n");
+    log_printf("  \"length\": %d,\n", total);
+    log_printf("  \"sequence\": \"%s\",\n", sequence);
+    log_printf("  \"counts\": {\n");
+    log_printf("    \"A\": %d,\n", a);
+    log_printf("    \"C\": %d,\n", c);
+    log_printf("    \"G\": %d,\n", g);
+    log_printf("    \"T\": %d\n", t);
+    log_printf("  },\n");
+
+    if (total > 0) 
+    {
+        log_printf("  \"gc_percent\": %.1f\n", (100.0 * gc / total));
+    } 
+    else 
+    {
+        log_printf("  \"gc_percent\": 0.0\n");
+    }
+
+    log_printf("}\n");
+}
+
+typedef struct {
+    int format;
+    FILE *file;
+    char filename[MAX_FILENAME_LENGTH];
+    text_buffer buffer;
+    text_buffer sequences;
+    int rows;
+    int64_t total_rows;
+    int32_t *counts;
+    double *gc_percent;
+    int64_t *offsets;
+} stats_exporter;
+
+static stats_exporter stats_exporters[2];
+
+void text_append_le(text_buffer *buffer, uint64_t value, int bytes)
+{
+    text_reserve(buffer, bytes);
+
+    for (int i = 0; i < bytes; i++) 
+    {
+        buffer->data[buffer->length++] = (char)((value >> (8 * i)) & 0xFF);
+    }
+}
+
+void text_append_int(text_buffer *buffer, int64_t value)
+{
+    char digits[24];
+    int length = 0;
+    uint64_t magnitude = value < 0 ? (uint64_t)0 - (uint64_t)value : (uint64_t)value;
+
+    do 
+    {
+        digits[length++] = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } 
+    while (magnitude > 0);
+
+    text_reserve(buffer, length + 1);
+
+    if (value < 0) 
+    {
+        buffer->data[buffer->length++] = '-';
+    }
+
+    while (length > 0) 
+    {
+        buffer->data[buffer->length++] = digits[--length];
+    }
+}
+
+void stats_exporter_write_buffer(stats_exporter *exporter)
+{
+    fwrite(exporter->buffer.data, 1, exporter->buffer.length, exporter->file);
+    exporter->buffer.length = 0;
+}
+
+void stats_exporter_flush_chunk(stats_exporter *exporter)
+{
+    text_buffer *out = &exporter->buffer;
+    int rows = exporter->rows;
+
+    if (rows == 0) 
+    {
+        return;
+    }
+
+    text_append_le(out, (uint32_t)rows, 4);
+
+    for (int column = 0; column < STATS_INT_COLUMNS; column++) 
+    {
+        text_append_le(out, (uint64_t)rows * 4, 8);
+
+        for (int r = 0; r < rows; r++) 
+        {
+            text_append_le(out, (uint32_t)exporter->counts[(size_t)r * STATS_INT_COLUMNS + column], 4);
+        }
+    }
+
+    text_append_le(out, (uint64_t)rows * 8, 8);
+
+    for (int r = 0; r < rows; r++) 
+    {
+        uint64_t bits;
+
+        memcpy(&bits, &exporter->gc_percent[r], sizeof(bits));
+        text_append_le(out, bits, 8);
+    }
+
+    text_append_le(out, (uint64_t)(rows + 1) * 8 + exporter->sequences.length, 8);
+
+    for (int r = 0; r <= rows; r++) 
+    {
+        text_append_le(out, (uint64_t)exporter->offsets[r], 8);
+    }
+
+    text_append(out, exporter->sequences.data, exporter->sequences.length);
+    stats_exporter_write_buffer(exporter);
+
+    exporter->sequences.length = 0;
+    exporter->rows = 0;
+}
+
+void stats_exporters_close(void)
+{
+    for (int f = 0; f < 2; f++) 
+    {
+        stats_exporter *exporter = &stats_exporters[f];
+
+        if (exporter->file == NULL) 
+        {
+            continue;
+        }
+
+        if (exporter->format == STATS_COLUMNAR) 
+        {
+            stats_exporter_flush_chunk(exporter);
+            text_append_le(&exporter->buffer, 0, 4);
+            text_append_le(&exporter->buffer, (uint64_t)exporter->total_rows, 8);
+        }
+
+        stats_exporter_write_buffer(exporter);
+        fclose(exporter->file);
+        free(exporter->buffer.data);
+        free(exporter->sequences.data);
+        free(exporter->counts);
+        free(exporter->gc_percent);
+        free(exporter->offsets);
+        memset(exporter, 0, sizeof(*exporter));
+    }
+}
+
+stats_exporter *stats_exporter_get(const char *filename, int format)
+{
+    static int registered = 0;
+    stats_exporter *exporter = &stats_exporters[format];
+
+    if (exporter->file != NULL) 
+    {
+        return strcmp(exporter->filename, filename) == 0 ? exporter : NULL;
+    }
+
+    exporter->file = fopen(filename, format == STATS_CSV ? "a" : "wb");
+
+    if (exporter->file == NULL) 
+    {
+        return NULL;
+    }
+
+    strncpy(exporter->filename, filename, MAX_FILENAME_LENGTH - 1);
+    exporter->format = format;
+
+    if (!registered) 
+    {
+        atexit(stats_exporters_close);
+        registered = 1;
+    }
+
+    if (format == STATS_CSV) 
+    {
+        fseek(exporter->file, 0, SEEK_END);
+
+        if (file_tell(exporter->file) == 0) 
+        {
+            text_append(&exporter->buffer, "sequence,length,A,C,G,T,gc_percent\n", 35);
+        }
+
+        return exporter;
+    }
+
+    static const char *names[] = { "length", "A", "C", "G", "T", "gc_percent", "sequence" };
+    static const unsigned char types[] = { 1, 1, 1, 1, 1, 2, 3 };
+
+    exporter->counts = xmalloc(sizeof(int32_t) * STATS_INT_COLUMNS * STATS_CHUNK_ROWS);
+    exporter->gc_percent = xmalloc(sizeof(double) * STATS_CHUNK_ROWS);
+    exporter->offsets = xmalloc(sizeof(int64_t) * (STATS_CHUNK_ROWS + 1));
+    exporter->offsets[0] = 0;
+    text_append(&exporter->buffer, "DNACOL01", 8);
+    text_append_le(&exporter->buffer, 7, 4);
+
+    for (int column = 0; column < 7; column++) 
+    {
+        text_append_le(&exporter->buffer, strlen(names[column]), 1);
+        text_append(&exporter->buffer, names[column], strlen(names[column]));
+        text_append_le(&exporter->buffer, types[column], 1);
+    }
+
+    return exporter;
+}
+
+void export_stats_row(const char *filename, int format, const char *sequence) 
+{
+    stats_exporter *exporter = stats_exporter_get(filename, format);
+
+    if (exporter == NULL) 
+    {
+        log_printf("Failed to write to file: %s\n", filename);
+        return;
+    }
+
+    int a, c, g, t;
+
+    count_bases(sequence, &a, &c, &g, &t);
+
+    int total = a + c + g + t;
+    double gc_percent = total > 0 ? 100.0 * (g + c) / total : 0.0;
+    size_t length = strlen(sequence);
+
+    exporter->total_rows++;
+
+    if (format == STATS_CSV) 
+    {
+        text_buffer *out = &exporter->buffer;
+        char percent[32];
+        int percent_length = snprintf(percent, sizeof(percent), "%.1f\n", gc_percent);
+
+        text_append(out, sequence, length);
+        text_append(out, ",", 1);
+        text_append_int(out, total);
+        text_append(out, ",", 1);
+        text_append_int(out, a);
+        text_append(out, ",", 1);
+        text_append_int(out, c);
+        text_append(out, ",", 1);
+        text_append_int(out, g);
+        text_append(out, ",", 1);
+        text_append_int(out, t);
+        text_append(out, ",", 1);
+        text_append(out, percent, percent_length);
+
+        if (out->length >= STATS_CSV_BUFFER) 
+        {
+            stats_exporter_write_buffer(exporter);
+        }
+
+        return;
+    }
+
+    int32_t *row = exporter->counts + (size_t)exporter->rows * STATS_INT_COLUMNS;
+
+    row[0] = total;
+    row[1] = a;
+    row[2] = c;
+    row[3] = g;
+    row[4] = t;
+    exporter->gc_percent[exporter->rows] = gc_percent;
+    text_append(&exporter->sequences, sequence, length);
+    exporter->rows++;
+    exporter->offsets[exporter->rows] = exporter->sequences.length;
+
+    if (exporter->rows == STATS_CHUNK_ROWS) 
+    {
+        stats_exporter_flush_chunk(exporter);
+    }
+}
+
+void export_csv(const char *filename, const char *sequence) 
+{
+    export_stats_row(filename, STATS_CSV, sequence);
+}
+
+void export_stats_json(const char *filename, const char *sequence) 
+{
+    int a, c, g, t;
+
+    count_bases(sequence, &a, &c, &g, &t);
+
+    int total = a + c + g + t;
+    int gc = c + g;
+
+    FILE *file = fopen(filename, "w");
+
+    if (file == NULL) 
+    {
+        log_printf("Failed to write JSON stats to file: %s\n", filename);
+        return;
+    }
+
+    fprintf(file, "{\n");
+    fprintf(file, "  \"sequence\": \"%s\",\n", sequence);
+    fprintf(file, "  \"length\": %d,\n", total);
+    fprintf(file, "  \"A\": %d,\n", a);
+    fprintf(file, "  \"C\": %d,\n", c);
+    fprintf(file, "  \"G\": %d,\n", g);
+    fprintf(file, "  \"T\": %d,\n", t);
+
+    if (total > 0) 
+    {
+        fprintf(file, "  \"gc_percent\": %.1f\n", (100.0 * gc / total));
+    } 
+    else 
+    {
+        fprintf(file, "  \"gc_percent\": 0.0\n");
+    }
+
+    fprintf(file, "}\n");
+
+    fclose(file);
+}
+
+void print_binary(const char *sequence) 
+{
+    log_printf("\n=== Binary Output ===\n\n");
+
+    for (int i = 0; sequence[i] != '\0'; i++) 
+    {
+        if (sequence[i] == 'A') 
+        {
+            log_printf("00");
+        } 
+        else if (sequence[i] == 'C') 
+        {
+            log_printf("01");
+        } 
+        else if (sequence[i] == 'G') 
+        {
+            log_printf("10");
+        } 
+        else if (sequence[i] == 'T') 
+        {
+            log_printf("11");
+        } 
+        else 
+        {
+            log_printf("??");
+        }
+    }
+
+    log_printf("\n");
+}
+
+void print_hex(const char *sequence) 
+{
+    log_printf("\n=== Hex Output ===\n\n");
+
+    int i = 0;
+
+    while (sequence[i] != '\0') 
+    {
+        char code1 = 0;
+        char code2 = 0;
+
+        if (sequence[i] == 'A') 
+        {
+            code1 = 0;
+        } 
+        else if (sequence[i] == 'C') 
+        {
+            code1 = 1;
+        } 
+        else if (sequence[i] == 'G') 
+        {
+            code1 = 2;
+        } 
+        else if (sequence[i] == 'T') 
+        {
+            code1 = 3;
+        }
+
+        if (sequence[i + 1] != '\0') 
+        {
+            if (sequence[i + 1] == 'A') 
+            {
+                code2 = 0;
+            } 
+            else if (sequence[i + 1] == 'C') 
+            {
+                code2 = 1;
+            } 
+            else if (sequence[i + 1] == 'G') 
+            {
+                code2 = 2;
+            } 
+            else if (sequence[i + 1] == 'T') 
+            {
+                code2 = 3;
+            }
+
+            unsigned char combined = (code1 << 2) | code2;
+            log_printf("%X", combined);
+
+            i = i + 2;
+        } 
+        else 
+        {
+            log_printf("%X", code1 << 2);
+            break;
+        }
+    }
+
+    log_printf("\n");
+}
+
+void derive_key_bytes(const char *sequence, unsigned char *key_out) 
+{
+    for (int i = 0; i < KEY_SIZE; i++) 
+    {
+        key_out[i] = 0;
+    }
+
+    for (int i = 0; sequence[i] != '\0'; i++) 
+    {
+        unsigned char value = 0;
+
+        if (sequence[i] == 'A') 
+        {
+            value = 0x1;
+        } 
+        else if (sequence[i] == 'C') 
+        {
+            value = 0x3;
+        } 
+        else if (sequence[i] == 'G') 
+        {
+            value = 0x7;
+        } 
+        else if (sequence[i] == 'T') 
+        {
+            value = 0xD;
+        }
+
+        key_out[i % KEY_SIZE] ^= value ^ (i * 31);
+    }
+}
+
+void derive_key(const char *sequence) 
+{
+    unsigned char key[KEY_SIZE];
+
+    derive_key_bytes(sequence, key);
+
+    log_printf("\n=== Derived Key ===\n\n");
+
+    log_printf("DNA Key (32 chars): ");
+
+    for (int i = 0; i < KEY_SIZE; i++) 
+    {
+        log_printf("%02X", key[i]);
+    }
+
+    log_printf("\n");
+}
+
+void derive_hash_bytes(const char *sequence, unsigned char *hash) 
+{
+    memset(hash, 0, 32);
+
+    for (int i = 0; sequence[i] != '\0'; i++) 
+    {
+        unsigned char value = 0;
+
+        if (sequence[i] == 'A') 
+        {
+            value = 0xA3;
+        } 
+        else if (sequence[i] == 'C') 
+        {
+            value = 0xC5;
+        } 
+        else if (sequence[i] == 'G') 
+        {
+            value = 0xF1;
+        } 
+        else if (sequence[i] == 'T') 
+        {
+            value = 0x9E;
+        }
+
+        hash[i % 32] ^= value ^ (i * 17);
+        hash[(i * 3) % 32] ^= (value << (i % 5)) | (value >> ((8 - (i % 5)) % 8));
+    }
+}
+
+void derive_hash(const char *sequence) 
+{
+    unsigned char hash[32];
+
+    derive_hash_bytes(sequence, hash);
+
+    log_printf("\n=== Hash ===\n\n");
+
+    log_printf("DNA Hash (64 chars): ");
+
+    for (int i = 0; i < 32; i++) 
+    {
+        log_printf("%02X", hash[i]);
+    }
+
+    log_printf("\n");
+}
+
+void encrypt_text_with_dna_key(const char *sequence, const char *text) 
+{
+    unsigned char key[KEY_SIZE];
+
+    derive_key_bytes(sequence, key);
+
+    log_printf("\n=== Encrypted Output ===\n\n");
+
+    log_printf("Plaintext : %s\n", text);
+    log_printf("Cipherhex : ");
+
+    for (int i = 0; text[i] != '\0'; i++) 
+    {
+        unsigned char encrypted = text[i] ^ key[i % KEY_SIZE];
+        log_printf("%02X", encrypted);
+    }
+
+    log_printf("\n");
+}
+
+void decrypt_hex_with_dna_key(const char *sequence, const char *hex_string) 
+{
+    unsigned char key[KEY_SIZE];
+
+    derive_key_bytes(sequence, key);
+
+    log_printf("\n=== Decrypted Output ===\n\n");
+
+    log_printf("Cipherhex : %s\n", hex_string);
+    log_printf("Plaintext : ");
+
+    int len = strlen(hex_string);
+
+    for (int i = 0; i + 1 < len; i = i + 2) 
+    {
+        char hex_byte[3];
+
+        hex_byte[0] = hex_string[i];
+        hex_byte[1] = hex_string[i + 1];
+        hex_byte[2] = '\0';
+
+        unsigned int value;
+        sscanf(hex_byte, "%02X", &value);
+
+        unsigned char decrypted = (unsigned char)value ^ key[(i / 2) % KEY_SIZE];
+        log_printf("%c", decrypted);
+    }
+
+    log_printf("\n");
+}
+
+void print_qrcode(const char *sequence) 
+{
+    log_printf("\n=== QR Code ===\n\n");
+
+    int len = strlen(sequence);
+    int size = 21;
+    int block = 0;
+
+    for (int y = 0; y < size; y++) 
+    {
+        for (int x = 0; x < size; x++) 
+        {
+            if (block >= len) 
+            {
+                log_printf("[ ]");
+            } 
+            else 
+            {
+                char bit = sequence[block] % 2;
+
+                if (bit == 1) 
+                {
+                    log_printf("[#]");
+                } 
+                else 
+                {
+                    log_printf("[ ]");
+                }
+
+                block++;
+            }
+        }
+
+        log_printf("\n");
+    }
+}
+
+void print_histogram_horizontal(const char *sequence, int no_color) 
+{
+    int a;
+    int c;
+    int g;
+    int t;
+
+    count_bases(sequence, &a, &c, &g, &t);
+
+    int max = a;
+
+    if (c > max) 
+    {
+        max = c;
+    }
+
+    if (g > max) 
+    {
+        max = g;
+    }
+
+    if (t > max) 
+    {
+        max = t;
+    }
+
+    int scaled_a;
+    int scaled_c;
+    int scaled_g;
+    int scaled_t;
+
+    if (max <= BAR_WIDTH) 
+    {
+        scaled_a = a;
+        scaled_c = c;
+        scaled_g = g;
+        scaled_t = t;
+    } 
+    else 
+    {
+        scaled_a = (a * BAR_WIDTH) / max;
+        scaled_c = (c * BAR_WIDTH) / max;
+        scaled_g = (g * BAR_WIDTH) / max;
+        scaled_t = (t * BAR_WIDTH) / max;
+    }
+
+    if (!no_color) 
+    {
+        log_printf("\033[31m");
+    }
+
+    log_printf("A: ");
+
+    for (int i = 0; i < scaled_a; i++) 
+    {
+        log_printf("#");
+    }
+
+    for (int i = scaled_a; i < BAR_WIDTH; i++) 
+    {
+        log_printf(" ");
+    }
+
+    if (!no_color) 
+    {
+        log_printf("\033[0m");
+    }
+
+    log_printf(" (%d)\n", a);
+
+    if (!no_color) 
+    {
+        log_printf("\033[32m");
+    }
+
+    log_printf("C: ");
+
+    for (int i = 0; i < scaled_c; i++) 
+    {
+        log_printf("#");
+    }
+
+    for (int i = scaled_c; i < BAR_WIDTH; i++) 
+    {
+        log_printf(" ");
+    }
+
+    if (!no_color) 
+    {
+        log_printf("\033[0m");
+    }
+
+    log_printf(" (%d)\n", c);
+
+    if (!no_color) 
+    {
+        log_printf("\033[34m");
+    }
+
+    log_printf("G: ");
+
+    for (int i = 0; i < scaled_g; i++) 
+    {
+        log_printf("#");
+    }
+
+    for (int i = scaled_g; i < BAR_WIDTH; i++) 
+    {
+        log_printf(" ");
+    }
+
+    if (!no_color) 
+    {
+        log_printf("\033[0m");
+    }
+
+    log_printf(" (%d)\n", g);
+
+    if (!no_color) 
+    {
+        log_printf("\033[33m");
+    }
+
+    log_printf("T: ");
+
+    for (int i = 0; i < scaled_t; i++) 
+    {
+        log_printf("#");
+    }
+
+    for (int i = scaled_t; i < BAR_WIDTH; i++) 
+    {
+        log_printf(" ");
+    }
+
+    if (!no_color) 
+    {
+        log_printf("\033[0m");
+    }
+
+    log_printf(" (%d)\n", t);
+}
+
+void print_histogram_vertical(const char *sequence, int no_color)
+{
+    int a, c, g, t;
+    count_bases(sequence, &a, &c, &g, &t);
+
+    int max = a;
+
+    if (c > max) 
+    {
+        max = c;
+    }
+
+    if (g > max) 
+    {
+        max = g;
+    }
+
+    if (t > max) 
+    {
+        max = t;
+    }
+
+    int height = BAR_HEIGHT;
+
+    if (max < BAR_HEIGHT && max > 0)
+    {
+        height = max;
+    }
+
+    log_printf("\n=== DNA Base Distribution Histogram (vertical) ===\n\n");
+
+    for (int row = height; row > 0; row--) 
+    {
+        if (!no_color) 
+        {
+            log_printf("\033[31m");
+        }
+
+        log_printf(" ");
+
+        if (a >= row) 
+        {
+            log_printf("#");
+        } 
+        else 
+        {
+            log_printf(" ");
+        }
+
+        if (!no_color) 
+        {
+            log_printf("\033[0m");
+        }
+
+        if (!no_color) 
+        {
+            log_printf("\033[32m");
+        }
+
+        log_printf(" ");
+
+        if (c >= row) 
+        {
+            log_printf("#");
+        } 
+        else 
+        {
+            log_printf(" ");
+        }
+
+        if (!no_color) 
+        {
+            log_printf("\033[0m");
+        }
+
+        if (!no_color) 
+        {
+            log_printf("\033[34m");
+        }
+
+        log_printf(" ");
+
+        if (g >= row) 
+        {
+            log_printf("#");
+        } 
+        else 
+        {
+            log_printf(" ");
+        }
+
+        if (!no_color) 
+        {
+            log_printf("\033[0m");
+        }
+
+        if (!no_color) 
+        {
+            log_printf("\033[33m");
+        }
+
+        log_printf(" ");
+
+        if (t >= row) 
+        {
+            log_printf("#");
+        } 
+        else 
+        {
+            log_printf(" ");
+        }
+
+        if (!no_color) 
+        {
+            log_printf("\033[0m");
+        }
+
+        log_printf("\n");
+    }
+
+    log_printf(" A C G T\n");
+
+    log_printf("(%d %d %d %d)\n", a, c, g, t);
+}
+
+void compress_sequence(const char *input, char *output) 
+{
+    int i = 0;
+    int out = 0;
+
+    while (input[i] != '\0') 
+    {
+        char base = input[i];
+        int count = 1;
+
+        while (input[i + count] != '\0' && input[i + count] == base) 
+        {
+            count++;
+        }
+
+        output[out++] = base;
+
+        int digits = 0;
+        int temp = count;
+
+        do 
+        {
+            digits++;
+            temp = temp / 10;
+        } 
+        while (temp > 0);
+
+        for (int d = digits - 1; d >= 0; d--) 
+        {
+            int digit = (count / (int)pow(10, d)) % 10;
+            output[out++] = '0' + digit;
+        }
+
+        i = i + count;
+    }
+
+    output[out] = '\0';
+}
+
+void decompress_sequence(const char *input, char *output) 
+{
+    int in = 0;
+    int out = 0;
+
+    while (input[in] != '\0') 
+    {
+        char base = input[in];
+
+        if (!is_valid_base(base)) 
+        {
+            output[out] = '\0';
+            return;
+        }
+
+        in++;
+
+        int count = 0;
+
+        while (isdigit(input[in])) 
+        {
+            count = count * 10 + (input[in] - '0');
+            in++;
+        }
+
+        if (count == 0) 
+        {
+            output[out] = '\0';
+            return;
+        }
+
+        for (int i = 0; i < count && out < MAX_DNA_LENGTH - 1; i++) 
+        {
+            output[out++] = base;
+        }
+    }
+
+    output[out] = '\0';
+}
+
+void print_compressed(const char *sequence) 
+{
+    char compressed[MAX_COMPRESSED_LENGTH];
+
+    compress_sequence(sequence, compressed);
+
+    log_printf("\n=== Compressed Sequence ===\n\n");
+    log_printf("%s\n", compressed);
+}
+
+void print_decompressed(const char *sequence) 
+{
+    char decompressed[MAX_DNA_LENGTH];
+
+    decompress_sequence(sequence, decompressed);
+
+    log_printf("\n=== Decompressed Sequence ===\n\n");
+    log_printf("%s\n", decompressed);
+}
+
+int xor_stream(const unsigned char *key, io_reader *in, io_writer *out)
+{
+    char *block;
+    char *target = io_writer_buffer(out);
+    int64_t length;
+
+    while ((length = io_reader_next(in, &block)) > 0) 
+    {
+        for (int64_t i = 0; i < length; i++) 
+        {
+            target[i] = (char)((unsigned char)block[i] ^ key[i % KEY_SIZE]);
+        }
+
+        target = io_writer_submit(out, (size_t)length);
+    }
+
+    return length == 0;
+}
+
+void encrypt_file(const char *dna_sequence, const char *input_filename, const char *output_filename) 
+{
+    unsigned char key[KEY_SIZE];
+
+    derive_key_bytes(dna_sequence, key);
+
+    io_reader in;
+    io_writer out;
+
+    if (!io_reader_open(&in, input_filename)) 
+    {
+        log_printf("Error: Could not open input file '%s'\n", input_filename);
+        return;
+    }
+
+    if (!io_writer_open(&out, output_filename, IO_BLOCK_SIZE)) 
+    {
+        io_reader_close(&in);
+        log_printf("Error: Could not open output file '%s'\n", output_filename);
+        return;
+    }
+
+    log_printf("\n=== File Encryption ===\n\n");
+    log_printf("Input : %s\n", input_filename);
+    log_printf("Output: %s\n", output_filename);
+
+    int ok = xor_stream(key, &in, &out);
+
+    io_reader_close(&in);
+
+    if (!io_writer_close(&out) || !ok) 
+    {
+        log_printf("Error: Could not encrypt '%s' to '%s'\n", input_filename, output_filename);
+        return;
+    }
+
+    log_printf("File encrypted successfully.\n");
+}
+
+void decrypt_file(const char *dna_sequence, const char *input_filename, const char *output_filename) 
+{
+    unsigned char key[KEY_SIZE];
+
+    derive_key_bytes(dna_sequence, key);
+
+    io_reader in;
+    io_writer out;
+
+    if (!io_reader_open(&in, input_filename)) 
+    {
+        log_printf("Error: Could not open input file '%s'\n", input_filename);
+        return;
+    }
+
+    if (!io_writer_open(&out, output_filename, IO_BLOCK_SIZE)) 
+    {
+        io_reader_close(&in);
+        log_printf("Error: Could not open output file '%s'\n", output_filename);
+        return;
+    }
+
+    log_printf("\n=== File Decryption ===\n\n");
+    log_printf("Input : %s\n", input_filename);
+    log_printf("Output: %s\n", output_filename);
+
+    int ok = xor_stream(key, &in, &out);
+
+    io_reader_close(&in);
+
+    if (!io_writer_close(&out) || !ok) 
+    {
+        log_printf("Error: Could not decrypt '%s' to '%s'\n", input_filename, output_filename);
+        return;
+    }
+
+    log_printf("File decrypted successfully.\n");
+}
+
+double base_entropy(int a, int c, int g, int t) 
+{
+    int total = a + c + g + t;
+
+    if (total == 0) 
+    {
+        return 0.0;
+    }
+
+    double pa = (double)a / total;
+    double pc = (double)c / total;
+    double pg = (double)g / total;
+    double pt = (double)t / total;
+
+    double entropy = 0.0;
+
+    if (pa > 0) 
+    {
+        entropy -= pa * log2(pa);
     }
 
     if (pc > 0) 
     {
-        entropy -= pc * log2(pc);
+        entropy -= pc * log2(pc);
+    }
+
+    if (pg > 0) 
+    {
+        entropy -= pg * log2(pg);
+    }
+
+    if (pt > 0) 
+    {
+        entropy -= pt * log2(pt);
+    }
+
+    return entropy;
+}
+
+void print_complexity(const char *sequence) 
+{
+    int a, c, g, t;
+    count_bases(sequence, &a, &c, &g, &t);
+    int total = a + c + g + t;
+
+    if (total == 0) 
+    {
+        log_printf("\n=== Sequence Complexity ===\n\n");
+        log_printf("Sequence is empty.\n");
+        return;
+    }
+
+    double entropy = base_entropy(a, c, g, t);
+
+    log_printf("\n=== Sequence Complexity ===\n\n");
+    log_printf("Shannon Entropy: %.4f bits/base (max: 2.0000)\n", entropy);
+}
+
+void print_version(const char *progname) 
+{
+    printf("\n%s version %s\n", progname, PROGRAM_VERSION);
+    printf("Build date: %s %s\n\n", BUILD_DATE, BUILD_TIME);
+}
+
+void print_help(const char *progname)
+{
+    printf("\n%s - DNA Sequence Analysis Tool\n\n", progname);
+
+    printf("Usage:\n");
+    printf("  %s [options]\n\n", progname);
+
+    printf("Options:\n");
+    printf("  --ascii                 Show ASCII representation of DNA sequence\n");
+    printf("  --stats                 Show base statistics\n");
+    printf("  --summary               Show summary of sequence statistics\n");
+    printf("  --json                  Output analysis in JSON format (disables ASCII, stats, summary)\n");
+    printf("  --palindrome            Check if DNA sequence is a palindrome (reverse-complement)\n");
+    printf("  --reverse               Reverse the DNA sequence before analysis\n");
+    printf("  --complement            Use complement of DNA sequence before analysis\n");
+    printf("  --reverse-complement    Use reverse complement of DNA sequence before analysis\n");
+    printf("  --binary                Output DNA sequence as binary code\n");
+    printf("  --hex                   Output DNA sequence as hexadecimal code\n");
+    printf("  --key                   Derive a 128-bit key from DNA sequence\n");
+    printf("  --hash                  Output a 256-bit hash of the DNA sequence\n");
+    printf("  --qrcode                Visualize DNA sequence as a symbolic QR code\n");
+    printf("  --histogram             Show base distribution histogram (horizontal by default)\n");
+    printf("  --histogram-vertical    Show base distribution histogram vertically\n");
+    printf("  --histogram-horizontal  Show base distribution histogram horizontally\n");
+    printf("  --compress              Compress the DNA sequence (run-length encoding)\n");
+    printf("  --decompress            Decompress a run-length encoded DNA sequence\n");
+    printf("  --export-stats <file>   Export statistics as JSON to file\n");
+    printf("  --errors <N>            Introduce N random errors in the sequence\n");
+    printf("  --no-color              Disable colored output\n");
+    printf("  --csv <file>            Export sequence data to CSV file\n");
+    printf("  --stats-columns <file>  Export per-sequence statistics in columnar binary form\n");
+    printf("  --file <file>           Read sequences from a file (one per line)\n");
+    printf("  --mutate <N>            Introduce N random point mutations\n");
+    printf("  --sub-rate <p>          Substitute each base with probability p\n");
+    printf("  --ins-rate <p>          Insert a random base after each base with probability p\n");
+    printf("  --del-rate <p>          Delete each base with probability p\n");
+    printf("  --random <length>       Generate a random DNA sequence of given length\n");
+    printf("  --random-output <file>  Stream a --random sequence of any length (e.g. 1G) to a FASTA file ('-' = stdout)\n");
+    printf("  --simulate-reads <N>    Simulate N FASTQ reads from the --fasta/--file/stdin reference\n");
+    printf("  --read-length <L>       Simulated read length (default: 150)\n");
+    printf("  --paired                Simulate paired-end reads into <prefix>_1.fastq and <prefix>_2.fastq\n");
+    printf("  --fragment-size <N>     Mean paired-end fragment length (default: 400)\n");
+    printf("  --fragment-sd <N>       Standard deviation of the fragment length (default: 50)\n");
+    printf("  --error-rate <a> <b>    Per-base error rate rising from a at the first to b at the last cycle (default: 0.001 0.01)\n");
+    printf("  --error-profile <file>  Per-cycle error rates, one per line (overrides --error-rate)\n");
+    printf("  --reads-output <prefix> Output prefix for simulated reads (default: reads)\n");
+    printf("  --window <W>            Write GC%%, entropy and GC skew bedGraph profiles over W bp windows\n");
+    printf("  --step <S>              Window step for --window (default: W)\n");
+    printf("  --window-output <prefix> Output prefix for <prefix>.{gc,entropy,skew}.bedgraph (default: window)\n");
+    printf("  --mask                  Soft-mask low-complexity regions (DUST) of --fasta/--file/stdin input\n");
+    printf("  --mask-format <fmt>     Mask output: fasta (lowercase, default) or bed (intervals)\n");
+    printf("  --mask-level <T>        DUST score threshold (default: 20)\n");
+    printf("  --mask-window <W>       DUST window length (default: 64)\n");
+    printf("  --mask-output <file>    Write masked output to file (default: '-' = stdout)\n");
+    printf("  --find-palindromes      Report reverse-complement palindromes and inverted repeats of --fasta/--file/stdin input\n");
+    printf("  --min-arm <N>           Minimum palindrome arm length (default: 4)\n");
+    printf("  --max-arm <N>           Cap reported arm length (default: unlimited)\n");
+    printf("  --max-spacer <N>        Allow inverted repeats with up to N spacer bases (default: 0)\n");
+    printf("  --palindrome-output <file> Write palindromes to file (default: '-' = stdout)\n");
+    printf("  --repeats               Report tandem repeats of --fasta/--file/stdin input\n");
+    printf("  --max-period <N>        Longest repeat unit to search for (default: 6)\n");
+    printf("  --min-copies <N>        Minimum copies of the unit (default: 3)\n");
+    printf("  --repeats-output <file> Write tandem repeats to file (default: '-' = stdout)\n");
+    printf("  --seed <N>              Seed for --random, --mutate and --errors (runs are reproducible)\n");
+    printf("  --compare <seq1> <seq2> Compare two DNA sequences and count differences\n");
+    printf("  --find <pattern>        Search for a subsequence pattern in DNA\n");
+    printf("  --encrypt <text>        Encrypt text with DNA-derived key\n");
+    printf("  --decrypt <hex>         Decrypt hex string with DNA-derived key\n");
+    printf("  --encrypt-file <in> <out>  Encrypt a file using DNA key\n");
+    printf("  --decrypt-file <in> <out>  Decrypt a file using DNA key\n");
+    printf("  --stdin                 Read sequences from standard input\n");
+    printf("  --complexity            Calculate sequence complexity (Shannon entropy)\n");
+    printf("  --translate             Translate DNA sequence to amino acid sequence\n");
+    printf("  --benchmark             Measure and display analysis time\n");
+    printf("  --rotate <N>            Cyclically rotate DNA sequence by N bases\n");
+    printf("  --hamming <seq>         Calculate Hamming distance to reference sequence\n");
+    printf("  --max-dist <N>          Stop counting once the Hamming distance exceeds N\n");
+    printf("  --hamming-top <N>       Report only the N input sequences nearest to the --hamming reference\n");
+    printf("  --demux <barcodes.tsv>  Split --file/--fasta/stdin reads by leading barcode (lines: sample barcode)\n");
+    printf("  --demux-mismatches <N>  Barcode mismatches tolerated when demultiplexing, 0-2 (default: 1)\n");
+    printf("  --demux-prefix <path>   Prefix for per-sample output files (default: demux_)\n");
+    printf("  --log <file>            Log all terminal output to specified file\n");
+    printf("  --fasta <file>          Read a single DNA sequence from a FASTA file\n");
+    printf("  --faidx <file>          Build the <file>.fai offset index for a FASTA file\n");
+    printf("  --record <name>         Read only the named --fasta record, seeking to it through <file>.fai\n");
+    printf("  --region <name:beg-end> Process only this 1-based inclusive slice of the --fasta file (indexed via <file>.fai)\n");
+    printf("  --regions <file.bed>    Process every BED interval (0-based, half-open) of the --fasta file\n");
+    printf("  --export-fasta <file>   Export processed sequence to a FASTA file\n");
+    printf("  --orf                   Find and display Open Reading Frames (ORFs) in the sequence\n");
+    printf("  --both-strands          Also search the reverse strand with --find\n");
+    printf("  --six-frame             Translate all six frames and add reverse-strand ORFs to --orf\n");
+    printf("  --position <base>       Show all 0-based positions of specified base (A, C, G, T)\n");
+    printf("  --kmers <k>             Count canonical k-mers (k <= %d) of --fasta/--file/stdin input\n", MAX_KMER_SIZE);
+    printf("  --kmer-output <file>    Write k-mer counts to file instead of standard output\n");
+    printf("  --threads <N>           Number of worker threads (default: all cores)\n");
+    printf("  --io <backend>          File I/O backend: auto (default), uring, threads or sync\n");
+    printf("  --mem-limit <size>      Memory budget for k-mer tables, e.g. 512M or 8G (default: 1G)\n");
+    printf("  --batch <in...>         Run the selected analysis on every record of many FASTA files (paths, globs or @manifest), split into 1023-base chunks on a work-stealing thread pool\n");
+    printf("  --batch-output <file>   Write the per-file results, in input order, to file (default: '-' = stdout)\n");
+    printf("  --sketch <out> [in...]  Build MinHash sketches of input files and save them to <out>\n");
+    printf("  --sketch-k <k>          K-mer size used for sketching (default: 21)\n");
+    printf("  --sketch-size <N>       Number of hashes kept per sketch (default: 1000)\n");
+    printf("  --sketch-records        Sketch every FASTA record separately instead of whole files\n");
+    printf("  --compare-sketch <a> <b>  Estimate Jaccard/ANI for all pairs of two sketch files\n");
+    printf("  --jaccard               Estimate MinHash Jaccard/ANI between the --compare sequences\n");
+    printf("  --align                 Align the --compare sequences (global by default) and report CIGAR\n");
+    printf("  --align-fasta <a> <b>   Align the first records of two FASTA files\n");
+    printf("  --local                 Use local (Smith-Waterman) instead of global alignment\n");
+    printf("  --band <W>              Restrict alignment to a band of W diagonals around the main diagonal\n");
+    printf("  --match <N>             Alignment match score (default: 2)\n");
+    printf("  --mismatch <N>          Alignment mismatch penalty (default: 3)\n");
+    printf("  --gap-open <N>          Gap open penalty (default: 5)\n");
+    printf("  --gap-extend <N>        Gap extension penalty per base (default: 2)\n");
+    printf("  --format <fmt>          Output per sequence: text (default), ndjson or msgpack (one object per record)\n");
+    printf("  --serve                 Answer newline-delimited JSON requests from stdin on a worker pool\n");
+    printf("  --serve-socket <path>   Serve JSON requests on a UNIX socket instead of stdin\n");
+    printf("  --bench-suite           Run repeatable benchmarks of every kernel and report JSON\n");
+    printf("  --bench-size <size>     Generated input size for --bench-suite, e.g. 4M (default: 1M bases)\n");
+    printf("  --bench-reps <N>        Timed repetitions per kernel (default: 15)\n");
+    printf("  --bench-output <file>   Write --bench-suite JSON to file and print a summary table\n");
+    printf("  --profile               Report per-stage wall time, calls, bytes and allocations\n");
+    printf("  --profile-output <file> Also write the profile to file (implies --profile)\n");
+    printf("  --profile-format <fmt>  Profile file format: json (default) or trace (Chrome trace events)\n\n");
+    printf("  --version, -v           Show program version and build info\n");
+    printf("  --help, -h              Show this help message\n");
+}
+
+#define OPTION_SLOTS 256
+#define OPTION_BUCKETS 64
+
+enum {
+    OPT_NONE,
+    OPT_ASCII,
+    OPT_STATS,
+    OPT_SUMMARY,
+    OPT_PALINDROME,
+    OPT_JSON,
+    OPT_REVERSE,
+    OPT_COMPLEMENT,
+    OPT_REVERSE_COMPLEMENT,
+    OPT_BINARY,
+    OPT_HEX,
+    OPT_KEY,
+    OPT_HASH,
+    OPT_QRCODE,
+    OPT_HISTOGRAM,
+    OPT_HISTOGRAM_VERTICAL,
+    OPT_HISTOGRAM_HORIZONTAL,
+    OPT_COMPRESS,
+    OPT_DECOMPRESS,
+    OPT_EXPORT_STATS,
+    OPT_ERRORS,
+    OPT_NO_COLOR,
+    OPT_CSV,
+    OPT_STATS_COLUMNS,
+    OPT_FILE,
+    OPT_MUTATE,
+    OPT_RANDOM,
+    OPT_RANDOM_OUTPUT,
+    OPT_SUB_RATE,
+    OPT_INS_RATE,
+    OPT_DEL_RATE,
+    OPT_SIMULATE_READS,
+    OPT_READ_LENGTH,
+    OPT_PAIRED,
+    OPT_FRAGMENT_SIZE,
+    OPT_FRAGMENT_SD,
+    OPT_ERROR_RATE,
+    OPT_ERROR_PROFILE,
+    OPT_READS_OUTPUT,
+    OPT_WINDOW,
+    OPT_STEP,
+    OPT_WINDOW_OUTPUT,
+    OPT_MASK,
+    OPT_MASK_FORMAT,
+    OPT_MASK_LEVEL,
+    OPT_MASK_WINDOW,
+    OPT_MASK_OUTPUT,
+    OPT_FIND_PALINDROMES,
+    OPT_MIN_ARM,
+    OPT_MAX_ARM,
+    OPT_MAX_SPACER,
+    OPT_PALINDROME_OUTPUT,
+    OPT_REPEATS,
+    OPT_MAX_PERIOD,
+    OPT_MIN_COPIES,
+    OPT_IO,
+    OPT_REPEATS_OUTPUT,
+    OPT_FORMAT,
+    OPT_SERVE,
+    OPT_SERVE_SOCKET,
+    OPT_SEED,
+    OPT_COMPARE,
+    OPT_FIND,
+    OPT_ENCRYPT,
+    OPT_DECRYPT,
+    OPT_ENCRYPT_FILE,
+    OPT_DECRYPT_FILE,
+    OPT_STDIN,
+    OPT_COMPLEXITY,
+    OPT_TRANSLATE,
+    OPT_ROTATE,
+    OPT_HAMMING,
+    OPT_MAX_DIST,
+    OPT_HAMMING_TOP,
+    OPT_DEMUX,
+    OPT_DEMUX_MISMATCHES,
+    OPT_DEMUX_PREFIX,
+    OPT_VERSION,
+    OPT_BENCHMARK,
+    OPT_BENCH_SUITE,
+    OPT_BENCH_SIZE,
+    OPT_BENCH_REPS,
+    OPT_PROFILE,
+    OPT_PROFILE_OUTPUT,
+    OPT_PROFILE_FORMAT,
+    OPT_BENCH_OUTPUT,
+    OPT_HELP,
+    OPT_LOG,
+    OPT_FASTA,
+    OPT_FAIDX,
+    OPT_RECORD,
+    OPT_REGION,
+    OPT_REGIONS,
+    OPT_EXPORT_FASTA,
+    OPT_ORF,
+    OPT_BOTH_STRANDS,
+    OPT_SIX_FRAME,
+    OPT_POSITION,
+    OPT_KMERS,
+    OPT_KMER_OUTPUT,
+    OPT_THREADS,
+    OPT_SKETCH,
+    OPT_BATCH,
+    OPT_BATCH_OUTPUT,
+    OPT_COMPARE_SKETCH,
+    OPT_SKETCH_K,
+    OPT_SKETCH_SIZE,
+    OPT_SKETCH_RECORDS,
+    OPT_ALIGN,
+    OPT_JACCARD,
+    OPT_ALIGN_FASTA,
+    OPT_LOCAL,
+    OPT_BAND,
+    OPT_MATCH,
+    OPT_MISMATCH,
+    OPT_GAP_OPEN,
+    OPT_GAP_EXTEND,
+    OPT_MEM_LIMIT,
+    OPT_COUNT
+};
+
+typedef struct {
+    const char *name;
+    int id;
+    int arity;
+} option_name;
+
+static const option_name option_names[] = {
+    { "--ascii", OPT_ASCII, 0 },
+    { "--stats", OPT_STATS, 0 },
+    { "--summary", OPT_SUMMARY, 0 },
+    { "--palindrome", OPT_PALINDROME, 0 },
+    { "--json", OPT_JSON, 0 },
+    { "--reverse", OPT_REVERSE, 0 },
+    { "--complement", OPT_COMPLEMENT, 0 },
+    { "--reverse-complement", OPT_REVERSE_COMPLEMENT, 0 },
+    { "--binary", OPT_BINARY, 0 },
+    { "--hex", OPT_HEX, 0 },
+    { "--key", OPT_KEY, 0 },
+    { "--hash", OPT_HASH, 0 },
+    { "--qrcode", OPT_QRCODE, 0 },
+    { "--histogram", OPT_HISTOGRAM, 0 },
+    { "--histogram-vertical", OPT_HISTOGRAM_VERTICAL, 0 },
+    { "--histogram-horizontal", OPT_HISTOGRAM_HORIZONTAL, 0 },
+    { "--compress", OPT_COMPRESS, 0 },
+    { "--decompress", OPT_DECOMPRESS, 0 },
+    { "--export-stats", OPT_EXPORT_STATS, 1 },
+    { "--errors", OPT_ERRORS, 1 },
+    { "--no-color", OPT_NO_COLOR, 0 },
+    { "--csv", OPT_CSV, 1 },
+    { "--stats-columns", OPT_STATS_COLUMNS, 1 },
+    { "--file", OPT_FILE, 1 },
+    { "--mutate", OPT_MUTATE, 1 },
+    { "--random", OPT_RANDOM, 1 },
+    { "--random-output", OPT_RANDOM_OUTPUT, 1 },
+    { "--sub-rate", OPT_SUB_RATE, 1 },
+    { "--ins-rate", OPT_INS_RATE, 1 },
+    { "--del-rate", OPT_DEL_RATE, 1 },
+    { "--simulate-reads", OPT_SIMULATE_READS, 1 },
+    { "--read-length", OPT_READ_LENGTH, 1 },
+    { "--paired", OPT_PAIRED, 0 },
+    { "--fragment-size", OPT_FRAGMENT_SIZE, 1 },
+    { "--fragment-sd", OPT_FRAGMENT_SD, 1 },
+    { "--error-rate", OPT_ERROR_RATE, 2 },
+    { "--error-profile", OPT_ERROR_PROFILE, 1 },
+    { "--reads-output", OPT_READS_OUTPUT, 1 },
+    { "--window", OPT_WINDOW, 1 },
+    { "--step", OPT_STEP, 1 },
+    { "--window-output", OPT_WINDOW_OUTPUT, 1 },
+    { "--mask", OPT_MASK, 0 },
+    { "--mask-format", OPT_MASK_FORMAT, 1 },
+    { "--mask-level", OPT_MASK_LEVEL, 1 },
+    { "--mask-window", OPT_MASK_WINDOW, 1 },
+    { "--mask-output", OPT_MASK_OUTPUT, 1 },
+    { "--find-palindromes", OPT_FIND_PALINDROMES, 0 },
+    { "--min-arm", OPT_MIN_ARM, 1 },
+    { "--max-arm", OPT_MAX_ARM, 1 },
+    { "--max-spacer", OPT_MAX_SPACER, 1 },
+    { "--palindrome-output", OPT_PALINDROME_OUTPUT, 1 },
+    { "--repeats", OPT_REPEATS, 0 },
+    { "--max-period", OPT_MAX_PERIOD, 1 },
+    { "--min-copies", OPT_MIN_COPIES, 1 },
+    { "--io", OPT_IO, 1 },
+    { "--repeats-output", OPT_REPEATS_OUTPUT, 1 },
+    { "--format", OPT_FORMAT, 1 },
+    { "--serve", OPT_SERVE, 0 },
+    { "--serve-socket", OPT_SERVE_SOCKET, 1 },
+    { "--seed", OPT_SEED, 1 },
+    { "--compare", OPT_COMPARE, 2 },
+    { "--find", OPT_FIND, 1 },
+    { "--encrypt", OPT_ENCRYPT, 1 },
+    { "--decrypt", OPT_DECRYPT, 1 },
+    { "--encrypt-file", OPT_ENCRYPT_FILE, 2 },
+    { "--decrypt-file", OPT_DECRYPT_FILE, 2 },
+    { "--stdin", OPT_STDIN, 0 },
+    { "--complexity", OPT_COMPLEXITY, 0 },
+    { "--translate", OPT_TRANSLATE, 0 },
+    { "--rotate", OPT_ROTATE, 1 },
+    { "--hamming", OPT_HAMMING, 1 },
+    { "--max-dist", OPT_MAX_DIST, 1 },
+    { "--hamming-top", OPT_HAMMING_TOP, 1 },
+    { "--demux", OPT_DEMUX, 1 },
+    { "--demux-mismatches", OPT_DEMUX_MISMATCHES, 1 },
+    { "--demux-prefix", OPT_DEMUX_PREFIX, 1 },
+    { "--version", OPT_VERSION, 0 },
+    { "-v", OPT_VERSION, 0 },
+    { "--benchmark", OPT_BENCHMARK, 0 },
+    { "--bench-suite", OPT_BENCH_SUITE, 0 },
+    { "--bench-size", OPT_BENCH_SIZE, 1 },
+    { "--bench-reps", OPT_BENCH_REPS, 1 },
+    { "--profile", OPT_PROFILE, 0 },
+    { "--profile-output", OPT_PROFILE_OUTPUT, 1 },
+    { "--profile-format", OPT_PROFILE_FORMAT, 1 },
+    { "--bench-output", OPT_BENCH_OUTPUT, 1 },
+    { "--help", OPT_HELP, 0 },
+    { "-h", OPT_HELP, 0 },
+    { "--log", OPT_LOG, 1 },
+    { "--fasta", OPT_FASTA, 1 },
+    { "--faidx", OPT_FAIDX, 1 },
+    { "--record", OPT_RECORD, 1 },
+    { "--region", OPT_REGION, 1 },
+    { "--regions", OPT_REGIONS, 1 },
+    { "--export-fasta", OPT_EXPORT_FASTA, 1 },
+    { "--orf", OPT_ORF, 0 },
+    { "--both-strands", OPT_BOTH_STRANDS, 0 },
+    { "--six-frame", OPT_SIX_FRAME, 0 },
+    { "--position", OPT_POSITION, 1 },
+    { "--kmers", OPT_KMERS, 1 },
+    { "--kmer-output", OPT_KMER_OUTPUT, 1 },
+    { "--threads", OPT_THREADS, 1 },
+    { "--sketch", OPT_SKETCH, 1 },
+    { "--batch", OPT_BATCH, 0 },
+    { "--batch-output", OPT_BATCH_OUTPUT, 1 },
+    { "--compare-sketch", OPT_COMPARE_SKETCH, 2 },
+    { "--sketch-k", OPT_SKETCH_K, 1 },
+    { "--sketch-size", OPT_SKETCH_SIZE, 1 },
+    { "--sketch-records", OPT_SKETCH_RECORDS, 0 },
+    { "--align", OPT_ALIGN, 0 },
+    { "--jaccard", OPT_JACCARD, 0 },
+    { "--align-fasta", OPT_ALIGN_FASTA, 2 },
+    { "--local", OPT_LOCAL, 0 },
+    { "--band", OPT_BAND, 1 },
+    { "--match", OPT_MATCH, 1 },
+    { "--mismatch", OPT_MISMATCH, 1 },
+    { "--gap-open", OPT_GAP_OPEN, 1 },
+    { "--gap-extend", OPT_GAP_EXTEND, 1 },
+    { "--mem-limit", OPT_MEM_LIMIT, 1 }
+};
+
+static int option_count = sizeof(option_names) / sizeof(option_names[0]);
+static unsigned char option_displacement[OPTION_BUCKETS];
+static short option_slots[OPTION_SLOTS];
+static int option_index_ready = 0;
+static scratch_arena option_strings;
+
+uint32_t option_hash(const char *name, uint32_t seed)
+{
+    uint32_t hash = 2166136261u ^ (seed * 0x9e3779b9u);
+
+    while (*name != '\0') 
+    {
+        hash ^= (unsigned char)*name++;
+        hash *= 16777619u;
+    }
+
+    return hash ^ (hash >> 15);
+}
+
+void option_build_index(void)
+{
+    int order[OPTION_BUCKETS];
+    int sizes[OPTION_BUCKETS];
+
+    memset(sizes, 0, sizeof(sizes));
+
+    for (int k = 0; k < OPTION_SLOTS; k++) 
+    {
+        option_slots[k] = -1;
+    }
+
+    for (int o = 0; o < option_count; o++) 
+    {
+        sizes[option_hash(option_names[o].name, 0) % OPTION_BUCKETS]++;
+    }
+
+    for (int b = 0; b < OPTION_BUCKETS; b++) 
+    {
+        int j = b;
+
+        while (j > 0 && sizes[order[j - 1]] < sizes[b]) 
+        {
+            order[j] = order[j - 1];
+            j--;
+        }
+
+        order[j] = b;
+    }
+
+    for (int k = 0; k < OPTION_BUCKETS && sizes[order[k]] > 0; k++) 
+    {
+        int bucket = order[k];
+        int placed = 0;
+
+        for (int d = 1; d < 256 && !placed; d++) 
+        {
+            int slots[OPTION_SLOTS];
+            int count = 0;
+
+            placed = 1;
+
+            for (int o = 0; o < option_count && placed; o++) 
+            {
+                if (option_hash(option_names[o].name, 0) % OPTION_BUCKETS != (uint32_t)bucket) 
+                {
+                    continue;
+                }
+
+                int slot = option_hash(option_names[o].name, d) % OPTION_SLOTS;
+
+                if (option_slots[slot] >= 0) 
+                {
+                    placed = 0;
+                }
+
+                for (int c = 0; c < count && placed; c++) 
+                {
+                    placed = option_hash(option_names[slots[c]].name, d) % OPTION_SLOTS != (uint32_t)slot;
+                }
+
+                slots[count++] = o;
+            }
+
+            if (placed) 
+            {
+                option_displacement[bucket] = d;
+
+                for (int c = 0; c < count; c++) 
+                {
+                    option_slots[option_hash(option_names[slots[c]].name, d) % OPTION_SLOTS] = slots[c];
+                }
+            }
+        }
+
+        if (!placed) 
+        {
+            printf("Error: Could not build the option lookup table.\n");
+            exit(1);
+        }
+    }
+
+    option_index_ready = 1;
+}
+
+int option_lookup(const char *name, int available)
+{
+    if (!option_index_ready) 
+    {
+        option_build_index();
+    }
+
+    int bucket = option_hash(name, 0) % OPTION_BUCKETS;
+    int slot = option_slots[option_hash(name, option_displacement[bucket]) % OPTION_SLOTS];
+
+    if (slot < 0 || strcmp(option_names[slot].name, name) != 0 || option_names[slot].arity > available) 
+    {
+        return OPT_NONE;
+    }
+
+    return option_names[slot].id;
+}
+
+const char *option_string(const char *value, int limit)
+{
+    size_t length = strnlen(value, limit - 1);
+    char *copy = arena_alloc(&option_strings, length + 1);
+
+    memcpy(copy, value, length);
+    copy[length] = '\0';
+
+    return copy;
+}
+
+double parse_rate(const char *flag, const char *value)
+{
+    double rate = atof(value);
+
+    if (rate < 0 || rate > 1) 
+    {
+        printf("Error: %s must be between 0 and 1.\n", flag);
+        exit(1);
+    }
+
+    return rate;
+}
+
+void options_init(options *config)
+{
+    config->show_ascii = 0;
+    config->show_stats = 0;
+    config->show_summary = 0;
+    config->show_json = 0;
+    config->do_reverse = 0;
+    config->do_complement = 0;
+    config->do_reverse_complement = 0;
+    config->file_mode = 0;
+    config->do_csv = 0;
+    config->do_binary = 0;
+    config->do_hex = 0;
+    config->do_key = 0;
+    config->do_hash = 0;
+    config->do_qrcode = 0;
+    config->do_histogram = 0;
+    config->histogram_vertical = 0;
+    config->do_compress = 0;
+    config->do_decompress = 0;
+    config->do_export_stats = 0;
+    config->do_stats_columns = 0;
+    config->do_find = 0;
+    config->do_complexity = 0;
+    config->mutate_count = 0;
+    config->errors_count = 0;
+    config->random_length = 0;
+    config->seed = 0;
+    config->has_seed = 0;
+    config->sub_rate = 0;
+    config->ins_rate = 0;
+    config->del_rate = 0;
+    config->simulate_reads = 0;
+    config->window_size = 0;
+    config->window_step = 0;
+    config->do_mask = 0;
+    config->mask_bed = 0;
+    config->mask_level = 20;
+    config->mask_window = 64;
+    config->do_find_palindromes = 0;
+    config->min_arm = 4;
+    config->max_arm = 0;
+    config->max_spacer = 0;
+    config->do_repeats = 0;
+    config->io_backend = IO_AUTO;
+    config->max_period = 6;
+    config->min_copies = 3;
+    config->read_length = 150;
+    config->paired = 0;
+    config->fragment_size = 400;
+    config->fragment_sd = 50;
+    config->do_serve = 0;
+    config->output_format = FORMAT_TEXT;
+    config->error_start = 0.001;
+    config->error_end = 0.01;
+    config->compare_mode = 0;
+    config->encrypt_mode = 0;
+    config->decrypt_mode = 0;
+    config->encrypt_file_mode = 0;
+    config->decrypt_file_mode = 0;
+    config->stdin_mode = 0;
+    config->no_color = 0;
+    config->show_version = 0;
+    config->do_benchmark = 0;
+    config->do_translate = 0;
+    config->rotate_n = 0;
+    config->do_hamming = 0;
+    config->do_log = 0;
+    config->do_palindrome = 0;
+    config->do_fasta_input = 0;
+    config->do_fasta_export = 0;
+    config->do_orf = 0;
+    config->both_strands = 0;
+    config->six_frame = 0;
+    config->do_position = 0;
+    config->position_base = '\0';
+    config->kmer_size = 0;
+    config->thread_count = 0;
+    config->mem_limit = 0;
+    config->do_sketch = 0;
+    config->do_compare_sketch = 0;
+    config->sketch_k = 21;
+    config->sketch_size = 1000;
+    config->sketch_per_record = 0;
+    config->sketch_input_count = 0;
+    config->sketch_inputs = NULL;
+    config->batch_input_count = 0;
+    config->batch_inputs = NULL;
+    config->do_align = 0;
+    config->do_jaccard = 0;
+    config->align_local = 0;
+    config->align_band = 0;
+    config->align_match = 2;
+    config->align_mismatch = 3;
+    config->align_gap_open = 5;
+    config->align_gap_extend = 2;
+    config->hamming_max_dist = -1;
+    config->hamming_top_n = 0;
+    config->do_bench_suite = 0;
+    config->do_profile = 0;
+    config->profile_trace = 0;
+    config->bench_reps = 15;
+    config->bench_size = 1 << 20;
+    config->do_demux = 0;
+    config->demux_mismatches = 1;
+
+    config->hamming_seq = "";
+    config->input_file = "";
+    config->output_file = "";
+    config->csv_file = "";
+    config->export_stats_file = "";
+    config->stats_columns_file = "";
+    config->compare_seq1 = "";
+    config->compare_seq2 = "";
+    config->find_pattern = "";
+    config->encrypt_text = "";
+    config->decrypt_hex = "";
+    config->encrypt_file_input = "";
+    config->encrypt_file_output = "";
+    config->decrypt_file_input = "";
+    config->decrypt_file_output = "";
+    config->log_file = "";
+    config->fasta_input_file = "";
+    config->fasta_export_file = "";
+    config->kmer_output_file = "";
+    config->sketch_output_file = "";
+    config->compare_sketch_file1 = "";
+    config->compare_sketch_file2 = "";
+    config->align_file1 = "";
+    config->align_file2 = "";
+    config->demux_barcode_file = "";
+    config->bench_output_file = "";
+    config->profile_output_file = "";
+    config->random_output_file = "";
+    config->reads_prefix = "reads";
+    config->window_prefix = "window";
+    config->mask_output_file = "-";
+    config->palindrome_output_file = "-";
+    config->repeats_output_file = "-";
+    config->region = "";
+    config->fasta_record = "";
+    config->faidx_file = "";
+    config->batch_output_file = "-";
+    config->regions_file = "";
+    config->error_profile_file = "";
+    config->serve_socket = "";
+    config->demux_prefix = "demux_";
+}
+
+options parse_args(int argc, char *argv[]) 
+{
+    options config;
+
+    options_init(&config);
+
+    for (int i = 1; i < argc; i++) 
+    {
+        int id = option_lookup(argv[i], argc - 1 - i);
+
+        switch (id) 
+        {
+            case OPT_ASCII:
+                config.show_ascii = 1;
+                break;
+
+            case OPT_STATS:
+                config.show_stats = 1;
+                break;
+
+            case OPT_SUMMARY:
+                config.show_summary = 1;
+                break;
+
+            case OPT_PALINDROME:
+                config.do_palindrome = 1;
+                break;
+
+            case OPT_JSON:
+                config.show_json = 1;
+                config.show_ascii = 0;
+                config.show_stats = 0;
+                config.show_summary = 0;
+                break;
+
+            case OPT_REVERSE:
+                config.do_reverse = 1;
+                break;
+
+            case OPT_COMPLEMENT:
+                config.do_complement = 1;
+                break;
+
+            case OPT_REVERSE_COMPLEMENT:
+                config.do_reverse_complement = 1;
+                break;
+
+            case OPT_BINARY:
+                config.do_binary = 1;
+                break;
+
+            case OPT_HEX:
+                config.do_hex = 1;
+                break;
+
+            case OPT_KEY:
+                config.do_key = 1;
+                break;
+
+            case OPT_HASH:
+                config.do_hash = 1;
+                break;
+
+            case OPT_QRCODE:
+                config.do_qrcode = 1;
+                break;
+
+            case OPT_HISTOGRAM:
+                config.do_histogram = 1;
+                break;
+
+            case OPT_HISTOGRAM_VERTICAL:
+                config.do_histogram = 1;
+                config.histogram_vertical = 1;
+                break;
+
+            case OPT_HISTOGRAM_HORIZONTAL:
+                config.do_histogram = 1;
+                config.histogram_vertical = 0;
+                break;
+
+            case OPT_COMPRESS:
+                config.do_compress = 1;
+                break;
+
+            case OPT_DECOMPRESS:
+                config.do_decompress = 1;
+                break;
+
+            case OPT_EXPORT_STATS:
+                config.export_stats_file = option_string(argv[++i], MAX_FILENAME_LENGTH);
+                config.do_export_stats = 1;
+                break;
+
+            case OPT_ERRORS:
+                config.errors_count = atoi(argv[++i]);
+                break;
+
+            case OPT_NO_COLOR:
+                config.no_color = 1;
+                break;
+
+            case OPT_CSV:
+                config.csv_file = option_string(argv[++i], MAX_FILENAME_LENGTH);
+                config.do_csv = 1;
+                break;
+
+            case OPT_STATS_COLUMNS:
+                config.stats_columns_file = option_string(argv[++i], MAX_FILENAME_LENGTH);
+                config.do_stats_columns = 1;
+                break;
+
+            case OPT_FILE:
+                config.input_file = option_string(argv[++i], MAX_FILENAME_LENGTH);
+                config.file_mode = 1;
+                break;
+
+            case OPT_MUTATE:
+                config.mutate_count = atoi(argv[++i]);
+                break;
+
+            case OPT_RANDOM:
+                config.random_length = parse_size(argv[++i]);
+
+                if (config.random_length < 0) 
+                {
+                    printf("Error: Invalid random sequence length '%s'.\n", argv[i]);
+                    exit(1);
+                }
+
+                break;
+
+            case OPT_RANDOM_OUTPUT:
+                config.random_output_file = option_string(argv[++i], MAX_FILENAME_LENGTH);
+                break;
+
+            case OPT_SUB_RATE:
+                config.sub_rate = parse_rate(argv[i], argv[i + 1]);
+                i++;
+                break;
+
+            case OPT_INS_RATE:
+                config.ins_rate = parse_rate(argv[i], argv[i + 1]);
+                i++;
+                break;
+
+            case OPT_DEL_RATE:
+                config.del_rate = parse_rate(argv[i], argv[i + 1]);
+                i++;
+                break;
+
+            case OPT_SIMULATE_READS:
+                config.simulate_reads = parse_size(argv[++i]);
+
+                if (config.simulate_reads <= 0) 
+                {
+                    printf("Error: Invalid read count '%s'.\n", argv[i]);
+                    exit(1);
+                }
+
+                break;
+
+            case OPT_READ_LENGTH:
+                config.read_length = atoi(argv[++i]);
+
+                if (config.read_length < 1) 
+                {
+                    printf("Error: Read length must be at least 1.\n");
+                    exit(1);
+                }
+
+                break;
+
+            case OPT_PAIRED:
+                config.paired = 1;
+                break;
+
+            case OPT_FRAGMENT_SIZE:
+                config.fragment_size = atoi(argv[++i]);
+                break;
+
+            case OPT_FRAGMENT_SD:
+                config.fragment_sd = atoi(argv[++i]);
+
+                if (config.fragment_sd < 0) 
+                {
+                    config.fragment_sd = 0;
+                }
+
+                break;
+
+            case OPT_ERROR_RATE:
+                config.error_start = atof(argv[++i]);
+                config.error_end = atof(argv[++i]);
+                break;
+
+            case OPT_ERROR_PROFILE:
+                config.error_profile_file = option_string(argv[++i], MAX_FILENAME_LENGTH);
+                break;
+
+            case OPT_READS_OUTPUT:
+                config.reads_prefix = option_string(argv[++i], MAX_FILENAME_LENGTH);
+                break;
+
+            case OPT_WINDOW:
+                config.window_size = parse_size(argv[++i]);
+
+                if (config.window_size <= 0) 
+                {
+                    printf("Error: Invalid window size '%s'.\n", argv[i]);
+                    exit(1);
+                }
+
+                break;
+
+            case OPT_STEP:
+                config.window_step = parse_size(argv[++i]);
+
+                if (config.window_step <= 0) 
+                {
+                    printf("Error: Invalid window step '%s'.\n", argv[i]);
+                    exit(1);
+                }
+
+                break;
+
+            case OPT_WINDOW_OUTPUT:
+                config.window_prefix = option_string(argv[++i], MAX_FILENAME_LENGTH);
+                break;
+
+            case OPT_MASK:
+                config.do_mask = 1;
+                break;
+
+            case OPT_MASK_FORMAT:
+                i++;
+
+                if (strcmp(argv[i], "fasta") == 0) 
+                {
+                    config.mask_bed = 0;
+                } 
+                else if (strcmp(argv[i], "bed") == 0) 
+                {
+                    config.mask_bed = 1;
+                } 
+                else 
+                {
+                    printf("Error: Unknown mask format '%s' (use fasta or bed).\n", argv[i]);
+                    exit(1);
+                }
+
+                break;
+
+            case OPT_MASK_LEVEL:
+                config.mask_level = atoi(argv[++i]);
+
+                if (config.mask_level < 1) 
+                {
+                    printf("Error: Mask level must be at least 1.\n");
+                    exit(1);
+                }
+
+                break;
+
+            case OPT_MASK_WINDOW:
+                config.mask_window = atoi(argv[++i]);
+
+                if (config.mask_window < 4) 
+                {
+                    printf("Error: Mask window must be at least 4.\n");
+                    exit(1);
+                }
+
+                break;
+
+            case OPT_MASK_OUTPUT:
+                config.mask_output_file = option_string(argv[++i], MAX_FILENAME_LENGTH);
+                break;
+
+            case OPT_FIND_PALINDROMES:
+                config.do_find_palindromes = 1;
+                break;
+
+            case OPT_MIN_ARM:
+                config.min_arm = atoi(argv[++i]);
+
+                if (config.min_arm < 1) 
+                {
+                    printf("Error: Minimum arm length must be at least 1.\n");
+                    exit(1);
+                }
+
+                break;
+
+            case OPT_MAX_ARM:
+                config.max_arm = atoi(argv[++i]);
+
+                if (config.max_arm < 0) 
+                {
+                    config.max_arm = 0;
+                }
+
+                break;
+
+            case OPT_MAX_SPACER:
+                config.max_spacer = atoi(argv[++i]);
+
+                if (config.max_spacer < 0) 
+                {
+                    config.max_spacer = 0;
+                }
+
+                break;
+
+            case OPT_PALINDROME_OUTPUT:
+                config.palindrome_output_file = option_string(argv[++i], MAX_FILENAME_LENGTH);
+                break;
+
+            case OPT_REPEATS:
+                config.do_repeats = 1;
+                break;
+
+            case OPT_MAX_PERIOD:
+                config.max_period = atoi(argv[++i]);
+
+                if (config.max_period < 1) 
+                {
+                    printf("Error: Maximum period must be at least 1.\n");
+                    exit(1);
+                }
+
+                break;
+
+            case OPT_MIN_COPIES:
+                config.min_copies = atoi(argv[++i]);
+
+                if (config.min_copies < 2) 
+                {
+                    printf("Error: Minimum copies must be at least 2.\n");
+                    exit(1);
+                }
+
+                break;
+
+            case OPT_IO:
+                i++;
+
+                if (strcmp(argv[i], "auto") == 0) 
+                {
+                    config.io_backend = IO_AUTO;
+                }
+                else if (strcmp(argv[i], "uring") == 0) 
+                {
+                    config.io_backend = IO_URING;
+                }
+                else if (strcmp(argv[i], "threads") == 0) 
+                {
+                    config.io_backend = IO_THREADED;
+                }
+                else if (strcmp(argv[i], "sync") == 0) 
+                {
+                    config.io_backend = IO_SYNC;
+                }
+                else 
+                {
+                    printf("Error: Unknown I/O backend '%s' (expected auto, uring, threads or sync).\n", argv[i]);
+                    exit(1);
+                }
+
+                break;
+
+            case OPT_REPEATS_OUTPUT:
+                config.repeats_output_file = option_string(argv[++i], MAX_FILENAME_LENGTH);
+                break;
+
+            case OPT_FORMAT:
+                i++;
+
+                if (strcmp(argv[i], "text") == 0) 
+                {
+                    config.output_format = FORMAT_TEXT;
+                }
+                else if (strcmp(argv[i], "ndjson") == 0) 
+                {
+                    config.output_format = FORMAT_NDJSON;
+                }
+                else if (strcmp(argv[i], "msgpack") == 0) 
+                {
+                    config.output_format = FORMAT_MSGPACK;
+                }
+                else 
+                {
+                    printf("Error: Unknown output format '%s' (expected text, ndjson or msgpack).\n", argv[i]);
+                    exit(1);
+                }
+
+                break;
+
+            case OPT_SERVE:
+                config.do_serve = 1;
+                break;
+
+            case OPT_SERVE_SOCKET:
+                config.do_serve = 1;
+                config.serve_socket = option_string(argv[++i], MAX_FILENAME_LENGTH);
+                break;
+
+            case OPT_SEED:
+                config.seed = strtoull(argv[++i], NULL, 0);
+                config.has_seed = 1;
+                break;
+
+            case OPT_COMPARE:
+                config.compare_seq1 = option_string(argv[++i], MAX_DNA_LENGTH);
+                config.compare_seq2 = option_string(argv[++i], MAX_DNA_LENGTH);
+                config.compare_mode = 1;
+                break;
+
+            case OPT_FIND:
+                config.find_pattern = option_string(argv[++i], MAX_DNA_LENGTH);
+                config.do_find = 1;
+                break;
+
+            case OPT_ENCRYPT:
+                config.encrypt_text = option_string(argv[++i], MAX_TEXT_LENGTH);
+                config.encrypt_mode = 1;
+                break;
+
+            case OPT_DECRYPT:
+                config.decrypt_hex = option_string(argv[++i], MAX_TEXT_LENGTH);
+                config.decrypt_mode = 1;
+                break;
+
+            case OPT_ENCRYPT_FILE:
+                config.encrypt_file_input = option_string(argv[++i], MAX_FILENAME_LENGTH);
+                config.encrypt_file_output = option_string(argv[++i], MAX_FILENAME_LENGTH);
+                config.encrypt_file_mode = 1;
+                break;
+
+            case OPT_DECRYPT_FILE:
+                config.decrypt_file_input = option_string(argv[++i], MAX_FILENAME_LENGTH);
+                config.decrypt_file_output = option_string(argv[++i], MAX_FILENAME_LENGTH);
+                config.decrypt_file_mode = 1;
+                break;
+
+            case OPT_STDIN:
+                config.stdin_mode = 1;
+                break;
+
+            case OPT_COMPLEXITY:
+                config.do_complexity = 1;
+                break;
+
+            case OPT_TRANSLATE:
+                config.do_translate = 1;
+                break;
+
+            case OPT_ROTATE:
+                config.rotate_n = atoi(argv[++i]);
+                break;
+
+            case OPT_HAMMING:
+                config.do_hamming = 1;
+                config.hamming_seq = option_string(argv[++i], MAX_DNA_LENGTH);
+                break;
+
+            case OPT_MAX_DIST:
+                config.hamming_max_dist = atoi(argv[++i]);
+                break;
+
+            case OPT_HAMMING_TOP:
+                config.hamming_top_n = atoi(argv[++i]);
+                break;
+
+            case OPT_DEMUX:
+                config.do_demux = 1;
+                config.demux_barcode_file = option_string(argv[++i], MAX_FILENAME_LENGTH);
+                break;
+
+            case OPT_DEMUX_MISMATCHES:
+            {
+                int mismatches = atoi(argv[++i]);
+
+                if (mismatches >= 0 && mismatches <= 2) 
+                {
+                    config.demux_mismatches = mismatches;
+                }
+                else 
+                {
+                    printf("Error: Demultiplexing mismatches must be between 0 and 2.\n");
+                    exit(1);
+                }
+
+                break;
+            }
+
+            case OPT_DEMUX_PREFIX:
+                config.demux_prefix = option_string(argv[++i], MAX_FILENAME_LENGTH);
+                break;
+
+            case OPT_VERSION:
+                config.show_version = 1;
+                break;
+
+            case OPT_BENCHMARK:
+                config.do_benchmark = 1;
+                break;
+
+            case OPT_BENCH_SUITE:
+                config.do_bench_suite = 1;
+                break;
+
+            case OPT_BENCH_SIZE:
+                config.bench_size = parse_size(argv[++i]);
+
+                if (config.bench_size <= 0) 
+                {
+                    printf("Error: Invalid benchmark size '%s'.\n", argv[i]);
+                    exit(1);
+                }
+
+                break;
+
+            case OPT_BENCH_REPS:
+                config.bench_reps = atoi(argv[++i]);
+
+                if (config.bench_reps < 1) 
+                {
+                    printf("Error: Benchmark repetitions must be at least 1.\n");
+                    exit(1);
+                }
+
+                break;
+
+            case OPT_PROFILE:
+                config.do_profile = 1;
+                break;
+
+            case OPT_PROFILE_OUTPUT:
+                config.do_profile = 1;
+                config.profile_output_file = option_string(argv[++i], MAX_FILENAME_LENGTH);
+                break;
+
+            case OPT_PROFILE_FORMAT:
+                i++;
+
+                if (strcmp(argv[i], "json") == 0) 
+                {
+                    config.profile_trace = 0;
+                }
+                else if (strcmp(argv[i], "trace") == 0) 
+                {
+                    config.profile_trace = 1;
+                }
+                else 
+                {
+                    printf("Error: Unknown profile format '%s' (expected json or trace).\n", argv[i]);
+                    exit(1);
+                }
+
+                break;
+
+            case OPT_BENCH_OUTPUT:
+                config.bench_output_file = option_string(argv[++i], MAX_FILENAME_LENGTH);
+                break;
+
+            case OPT_HELP:
+                print_help(argv[0]);
+                exit(0);
+                break;
+
+            case OPT_LOG:
+                config.log_file = option_string(argv[++i], MAX_FILENAME_LENGTH);
+                config.do_log = 1;
+                break;
+
+            case OPT_FASTA:
+                config.fasta_input_file = option_string(argv[++i], MAX_FILENAME_LENGTH);
+                config.do_fasta_input = 1;
+                break;
+
+            case OPT_FAIDX:
+                config.faidx_file = option_string(argv[++i], MAX_FILENAME_LENGTH);
+                break;
+
+            case OPT_RECORD:
+                config.fasta_record = option_string(argv[++i], MAX_FILENAME_LENGTH);
+                break;
+
+            case OPT_REGION:
+                config.region = option_string(argv[++i], MAX_FILENAME_LENGTH);
+                break;
+
+            case OPT_REGIONS:
+                config.regions_file = option_string(argv[++i], MAX_FILENAME_LENGTH);
+                break;
+
+            case OPT_EXPORT_FASTA:
+                config.fasta_export_file = option_string(argv[++i], MAX_FILENAME_LENGTH);
+                config.do_fasta_export = 1;
+                break;
+
+            case OPT_ORF:
+                config.do_orf = 1;
+                break;
+
+            case OPT_BOTH_STRANDS:
+                config.both_strands = 1;
+                break;
+
+            case OPT_SIX_FRAME:
+                config.six_frame = 1;
+                break;
+
+            case OPT_POSITION:
+            {
+                char b = toupper(argv[++i][0]);
+
+                if (is_valid_base(b)) 
+                {
+                    config.do_position = 1;
+                    config.position_base = b;
+                }
+
+                break;
+            }
+
+            case OPT_KMERS:
+            {
+                int k = atoi(argv[++i]);
+
+                if (k >= 1 && k <= MAX_KMER_SIZE) 
+                {
+                    config.kmer_size = k;
+                }
+                else 
+                {
+                    printf("Error: K-mer size must be between 1 and %d.\n", MAX_KMER_SIZE);
+                    exit(1);
+                }
+
+                break;
+            }
+
+            case OPT_KMER_OUTPUT:
+                config.kmer_output_file = option_string(argv[++i], MAX_FILENAME_LENGTH);
+                break;
+
+            case OPT_THREADS:
+                config.thread_count = atoi(argv[++i]);
+                break;
+
+            case OPT_SKETCH:
+                config.sketch_output_file = option_string(argv[++i], MAX_FILENAME_LENGTH);
+                config.do_sketch = 1;
+                config.sketch_inputs = &argv[i + 1];
+                config.sketch_input_count = 0;
+
+                while (i + 1 < argc && strncmp(argv[i + 1], "--", 2) != 0) 
+                {
+                    config.sketch_input_count++;
+                    i++;
+                }
+
+                break;
+
+            case OPT_BATCH:
+                config.batch_inputs = &argv[i + 1];
+                config.batch_input_count = 0;
+
+                while (i + 1 < argc && strncmp(argv[i + 1], "--", 2) != 0) 
+                {
+                    config.batch_input_count++;
+                    i++;
+                }
+
+                if (config.batch_input_count == 0) 
+                {
+                    printf("Error: --batch needs at least one file, glob or @manifest.\n");
+                    exit(1);
+                }
+
+                break;
+
+            case OPT_BATCH_OUTPUT:
+                config.batch_output_file = option_string(argv[++i], MAX_FILENAME_LENGTH);
+                break;
+
+            case OPT_COMPARE_SKETCH:
+                config.compare_sketch_file1 = option_string(argv[++i], MAX_FILENAME_LENGTH);
+                config.compare_sketch_file2 = option_string(argv[++i], MAX_FILENAME_LENGTH);
+                config.do_compare_sketch = 1;
+                break;
+
+            case OPT_SKETCH_K:
+                config.sketch_k = atoi(argv[++i]);
+
+                if (config.sketch_k < 1 || config.sketch_k > MAX_KMER_SIZE) 
+                {
+                    printf("Error: Sketch k-mer size must be between 1 and %d.\n", MAX_KMER_SIZE);
+                    exit(1);
+                }
+
+                break;
+
+            case OPT_SKETCH_SIZE:
+                config.sketch_size = atoi(argv[++i]);
+
+                if (config.sketch_size < 1) 
+                {
+                    printf("Error: Sketch size must be positive.\n");
+                    exit(1);
+                }
+
+                break;
+
+            case OPT_SKETCH_RECORDS:
+                config.sketch_per_record = 1;
+                break;
+
+            case OPT_ALIGN:
+                config.do_align = 1;
+                break;
+
+            case OPT_JACCARD:
+                config.do_jaccard = 1;
+                break;
+
+            case OPT_ALIGN_FASTA:
+                config.align_file1 = option_string(argv[++i], MAX_FILENAME_LENGTH);
+                config.align_file2 = option_string(argv[++i], MAX_FILENAME_LENGTH);
+                config.do_align = 1;
+                break;
+
+            case OPT_LOCAL:
+                config.align_local = 1;
+                break;
+
+            case OPT_BAND:
+                config.align_band = atoi(argv[++i]);
+                break;
+
+            case OPT_MATCH:
+                config.align_match = abs(atoi(argv[++i]));
+                break;
+
+            case OPT_MISMATCH:
+                config.align_mismatch = abs(atoi(argv[++i]));
+                break;
+
+            case OPT_GAP_OPEN:
+                config.align_gap_open = abs(atoi(argv[++i]));
+                break;
+
+            case OPT_GAP_EXTEND:
+                config.align_gap_extend = abs(atoi(argv[++i]));
+                break;
+
+            case OPT_MEM_LIMIT:
+                config.mem_limit = parse_size(argv[++i]);
+
+                if (config.mem_limit <= 0) 
+                {
+                    printf("Error: Invalid memory limit '%s'.\n", argv[i]);
+                    exit(1);
+                }
+
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    if (config.sub_rate + config.ins_rate + config.del_rate > 1 + 1e-9) 
+    {
+        printf("Error: --sub-rate, --ins-rate and --del-rate must add up to at most 1.\n");
+        exit(1);
+    }
+
+    if ((config.region[0] != '\0' || config.regions_file[0] != '\0') && config.do_fasta_input == 0) 
+    {
+        printf("Error: --region and --regions require --fasta <file>.\n");
+        exit(1);
+    }
+
+    if (config.fasta_record[0] != '\0' && config.do_fasta_input == 0) 
+    {
+        printf("Error: --record requires --fasta <file>.\n");
+        exit(1);
+    }
+
+    if (config.do_sketch == 1 && config.sketch_input_count == 0 && config.do_fasta_input == 0 && config.file_mode == 0) 
+    {
+        printf("Error: --sketch needs at least one input file (or --fasta/--file).\n");
+        exit(1);
+    }
+
+    return config;
+}
+
+char translate_codon(const char *codon)
+{
+    char c1 = codon[0];
+    char c2 = codon[1];
+    char c3 = codon[2];
+
+    if (c1 == 'T') 
+    {
+        if (c2 == 'T') 
+        {
+            if (c3 == 'T' || c3 == 'C') 
+            {
+                return 'F';
+            }
+            else if (c3 == 'A' || c3 == 'G') 
+            {
+                return 'L';
+            }
+        }
+        else if (c2 == 'C') 
+        {
+            return 'S';
+        }
+        else if (c2 == 'A') 
+        {
+            if (c3 == 'T' || c3 == 'C') 
+            {
+                return 'Y';
+            }
+            else if (c3 == 'A' || c3 == 'G') 
+            {
+                return '*';
+            }
+        }
+        else if (c2 == 'G') 
+        {
+            if (c3 == 'T' || c3 == 'C') 
+            {
+                return 'C';
+            }
+            else if (c3 == 'A') 
+            {
+                return '*';
+            }
+            else if (c3 == 'G') 
+            {
+                return 'W';
+            }
+        }
+    }
+    else if (c1 == 'C') 
+    {
+        if (c2 == 'T') 
+        {
+            return 'L';
+        }
+        else if (c2 == 'C') 
+        {
+            return 'P';
+        }
+        else if (c2 == 'A') 
+        {
+            if (c3 == 'T' || c3 == 'C') 
+            {
+                return 'H';
+            }
+            else if (c3 == 'A' || c3 == 'G') 
+            {
+                return 'Q';
+            }
+        }
+        else if (c2 == 'G') 
+        {
+            return 'R';
+        }
+    }
+    else if (c1 == 'A') 
+    {
+        if (c2 == 'T') 
+        {
+            if (c3 == 'T' || c3 == 'C' || c3 == 'A') 
+            {
+                return 'I';
+            }
+            else if (c3 == 'G') 
+            {
+                return 'M';
+            }
+        }
+        else if (c2 == 'C') 
+        {
+            return 'T';
+        }
+        else if (c2 == 'A') 
+        {
+            if (c3 == 'T' || c3 == 'C') 
+            {
+                return 'N';
+            }
+            else if (c3 == 'A' || c3 == 'G') 
+            {
+                return 'K';
+            }
+        }
+        else if (c2 == 'G') 
+        {
+            if (c3 == 'T' || c3 == 'C') 
+            {
+                return 'S';
+            }
+            else if (c3 == 'A' || c3 == 'G') 
+            {
+                return 'R';
+            }
+        }
+    }
+    else if (c1 == 'G') 
+    {
+        if (c2 == 'T') 
+        {
+            return 'V';
+        }
+        else if (c2 == 'C') 
+        {
+            return 'A';
+        }
+        else if (c2 == 'A') 
+        {
+            if (c3 == 'T' || c3 == 'C') 
+            {
+                return 'D';
+            }
+            else if (c3 == 'A' || c3 == 'G') 
+            {
+                return 'E';
+            }
+        }
+        else if (c2 == 'G') 
+        {
+            return 'G';
+        }
+    }
+
+    return 'X';
+}
+
+int translate_to_protein_view(const sequence_view *view, char *protein) 
+{
+    int len = view->length;
+    int start_index = -1;
+    int count = 0;
+    int i;
+    view_cursor cursor;
+
+    view_cursor_init(&cursor, view);
+
+    for (i = 0; i + 2 < len; i++) 
+    {
+        if (strncmp(view_cursor_span(&cursor, i, 3), "ATG", 3) == 0) 
+        {
+            start_index = i;
+            break;
+        }
+    }
+
+    if (start_index == -1) 
+    {
+        protein[0] = '\0';
+        return -1;
+    }
+
+    for (i = start_index; i + 2 < len; i += 3) 
+    {
+        char aa = translate_codon(view_cursor_span(&cursor, i, 3));
+
+        if (aa == '*') 
+        {
+            break;
+        }
+
+        protein[count++] = aa;
+    }
+
+    protein[count] = '\0';
+
+    return count;
+}
+
+int translate_to_protein(const char *sequence, int len, char *protein) 
+{
+    sequence_view view;
+
+    sequence_view_init(&view, (char *)sequence, len);
+
+    return translate_to_protein_view(&view, protein);
+}
+
+void print_six_frame_translation(const sequence_view *view, scratch_arena *arena)
+{
+    char *protein = arena_alloc(arena, view->length / 3 + 1);
+    sequence_view strands[2];
+
+    strands[0] = *view;
+    strands[1] = *view;
+    sequence_view_complement(&strands[1]);
+    sequence_view_reverse(&strands[1]);
+
+    log_printf("\n=== Six-Frame Translation ===\n\n");
+
+    for (int strand = 0; strand < 2; strand++) 
+    {
+        view_cursor cursor;
+
+        view_cursor_init(&cursor, &strands[strand]);
+
+        for (int frame = 0; frame < 3; frame++) 
+        {
+            int count = 0;
+
+            for (int64_t i = frame; i + 2 < view->length; i += 3) 
+            {
+                protein[count++] = translate_codon(view_cursor_span(&cursor, i, 3));
+            }
+
+            protein[count] = '\0';
+            log_printf("%c%d: %s\n", strand == 0 ? '+' : '-', frame + 1, protein);
+        }
+    }
+}
+
+void translate_sequence(const char *sequence, scratch_arena *arena) 
+{
+    log_printf("\n=== Translation to Amino Acids ===\n\n");
+
+    int len = strlen(sequence);
+    char *protein = arena_alloc(arena, len / 3 + 1);
+
+    if (translate_to_protein(sequence, len, protein) < 0) 
+    {
+        log_printf("No start codon found.\n");
+        log_printf("\n");
+        return;
+    }
+
+    log_printf("%s\n", protein);
+}
+
+void rotate_sequence(char *sequence, int n)
+{
+    int length = strlen(sequence);
+
+    if (length == 0) 
+    {
+        return;
+    }
+
+    if (n < 0) 
+    {
+        n = length + (n % length);
+    } 
+    else 
+    {
+        n = n % length;
+    }
+
+    if (n == 0) 
+    {
+        return;
+    }
+
+    rotate_left_range(sequence, length, length - n);
+}
+
+int is_dna_palindrome_view(const sequence_view *view)
+{
+    if (view->length == 0) 
+    {
+        return 0;
+    }
+
+    for (int64_t i = 0, j = view->length - 1; i <= j; i++, j--) 
+    {
+        char left = sequence_view_at(view, i);
+        char right = sequence_view_at(view, j);
+
+        if (left != complement_base(right) || right != complement_base(left)) 
+        {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+int is_dna_palindrome(const char *sequence)
+{
+    sequence_view view;
+
+    sequence_view_init(&view, (char *)sequence, strlen(sequence));
+
+    return is_dna_palindrome_view(&view);
+}
+
+void check_palindrome(const sequence_view *view)
+{
+    log_printf("\nPalindrome: %s\n", is_dna_palindrome_view(view) ? "Yes" : "No");
+}
+
+int export_fasta_sequence(const char *filename, const char *sequence) 
+{
+    FILE *file = fopen(filename, "w");
+
+    if (file == NULL) 
+    {
+        log_printf("Error: Could not open output FASTA file '%s' for writing\n", filename);
+        return 0;
+    }
+
+    fprintf(file, ">dnashield_output\n");
+
+    int length = strlen(sequence);
+    int pos = 0;
+
+    while (pos < length) 
+    {
+        int line_len = 60;
+
+        if (length - pos < 60) 
+        {
+            line_len = length - pos;
+        }
+
+        fwrite(sequence + pos, 1, line_len, file);
+        fprintf(file, "\n");
+
+        pos += line_len;
+    }
+
+    fclose(file);
+
+    return 1;
+}
+
+typedef struct {
+    FILE *file;
+    int owns_file;
+    io_reader *io;
+    char *buffer;
+    int buffer_pos;
+    int buffer_len;
+    int at_line_start;
+    int format_known;
+    int line_records;
+    int record_open;
+    int eof;
+    int hold_record;
+    long record_index;
+    int64_t record_position;
+    char *tail;
+    int tail_len;
+    int tail_capacity;
+    char name[MAX_FILENAME_LENGTH];
+} fasta_reader;
+
+static char fasta_base_table[256];
+
+void init_fasta_base_table(void)
+{
+    for (int ch = 0; ch < 256; ch++) 
+    {
+        fasta_base_table[ch] = isalpha(ch) ? (is_valid_base(toupper(ch)) ? toupper(ch) : 'N') : 0;
+    }
+}
+
+int fasta_reader_open(fasta_reader *reader, const char *filename)
+{
+    memset(reader, 0, sizeof(*reader));
+
+    if (filename == NULL || filename[0] == '\0' || strcmp(filename, "-") == 0) 
+    {
+        reader->file = stdin;
+        reader->owns_file = 0;
+    } 
+    else 
+    {
+        reader->io = xmalloc(sizeof(io_reader));
+
+        if (!io_reader_open(reader->io, filename)) 
+        {
+            free(reader->io);
+            reader->io = NULL;
+            reader->file = fopen(filename, "rb");
+            reader->owns_file = 1;
+        }
+
+        if (reader->io == NULL && reader->file == NULL) 
+        {
+            log_printf("Error: Could not open input file '%s'\n", filename);
+            return 0;
+        }
+    }
+
+    reader->buffer = reader->io == NULL ? xmalloc(FASTA_READ_BUFFER) : NULL;
+    reader->at_line_start = 1;
+    reader->record_index = -1;
+
+    return 1;
+}
+
+void fasta_reader_close(fasta_reader *reader)
+{
+    if (reader->owns_file && reader->file != NULL) 
+    {
+        fclose(reader->file);
+    }
+
+    if (reader->io != NULL) 
+    {
+        io_reader_close(reader->io);
+        free(reader->io);
+    }
+    else 
+    {
+        free(reader->buffer);
+    }
+
+    free(reader->tail);
+
+    reader->file = NULL;
+    reader->io = NULL;
+    reader->buffer = NULL;
+    reader->tail = NULL;
+}
+
+int fasta_peek(fasta_reader *reader)
+{
+    if (reader->buffer_pos >= reader->buffer_len) 
+    {
+        if (reader->eof) 
+        {
+            return EOF;
+        }
+
+        if (reader->io != NULL) 
+        {
+            reader->buffer_len = (int)io_reader_next(reader->io, &reader->buffer);
+        }
+        else 
+        {
+            reader->buffer_len = (int)fread(reader->buffer, 1, FASTA_READ_BUFFER, reader->file);
+        }
+
+        reader->buffer_pos = 0;
+
+        if (reader->buffer_len <= 0) 
+        {
+            reader->buffer_len = 0;
+            reader->eof = 1;
+            return EOF;
+        }
+    }
+
+    return (unsigned char)reader->buffer[reader->buffer_pos];
+}
+
+void fasta_read_header(fasta_reader *reader)
+{
+    int length = 0;
+    int in_name = 1;
+    int ch;
+
+    reader->buffer_pos++;
+
+    while ((ch = fasta_peek(reader)) != EOF) 
+    {
+        reader->buffer_pos++;
+
+        if (ch == '\n') 
+        {
+            break;
+        }
+
+        if (isspace(ch)) 
+        {
+            if (length > 0) 
+            {
+                in_name = 0;
+            }
+
+            continue;
+        }
+
+        if (in_name && length < MAX_FILENAME_LENGTH - 1) 
+        {
+            reader->name[length++] = (char)ch;
+        }
+    }
+
+    reader->name[length] = '\0';
+    reader->at_line_start = 1;
+}
+
+int fasta_read_chunk(fasta_reader *reader, char *chunk, int capacity, int overlap, int64_t *position)
+{
+    int length = 0;
+
+    if (overlap > 0 && reader->record_open && reader->tail_len > 0) 
+    {
+        length = reader->tail_len < overlap ? reader->tail_len : overlap;
+        memcpy(chunk, reader->tail + reader->tail_len - length, length);
+    }
+
+    int carried = length;
+
+    while (length < capacity) 
+    {
+        if (reader->record_open && !reader->at_line_start) 
+        {
+            int position = reader->buffer_pos;
+            int limit = reader->buffer_len - position < capacity - length ? reader->buffer_len : position + capacity - length;
+
+            while (position < limit && fasta_base_table[(unsigned char)reader->buffer[position]] != 0) 
+            {
+                chunk[length++] = fasta_base_table[(unsigned char)reader->buffer[position++]];
+            }
+
+            reader->buffer_pos = position;
+
+            if (length == capacity) 
+            {
+                break;
+            }
+        }
+
+        int ch = fasta_peek(reader);
+
+        if (ch == EOF) 
+        {
+            break;
+        }
+
+        if (!reader->format_known && !isspace(ch)) 
+        {
+            reader->format_known = 1;
+            reader->line_records = ch != '>';
+        }
+
+        if (ch == '>' && reader->at_line_start && !reader->line_records) 
+        {
+            if (length > carried || reader->hold_record) 
+            {
+                break;
+            }
+
+            fasta_read_header(reader);
+            reader->record_open = 0;
+            length = 0;
+            carried = 0;
+            continue;
+        }
+
+        if (ch == '\n') 
+        {
+            reader->buffer_pos++;
+            reader->at_line_start = 1;
+
+            if (reader->line_records && reader->record_open) 
+            {
+                reader->record_open = 0;
+
+                if (length > carried || reader->hold_record) 
+                {
+                    break;
+                }
+
+                length = 0;
+                carried = 0;
+            }
+
+            continue;
+        }
+
+        reader->at_line_start = 0;
+
+        if (!isalpha(ch)) 
+        {
+            reader->buffer_pos++;
+            continue;
+        }
+
+        if (!reader->record_open) 
+        {
+            if (length > carried || reader->hold_record) 
+            {
+                break;
+            }
+
+            reader->record_open = 1;
+            reader->record_index++;
+            reader->record_position = 0;
+            reader->tail_len = 0;
+            length = 0;
+            carried = 0;
+
+            if (reader->line_records) 
+            {
+                snprintf(reader->name, MAX_FILENAME_LENGTH, "seq%ld", reader->record_index + 1);
+            }
+        }
+
+        char base = toupper(ch);
+        chunk[length++] = is_valid_base(base) ? base : 'N';
+        reader->buffer_pos++;
+    }
+
+    if (length == carried) 
+    {
+        return 0;
+    }
+
+    *position = reader->record_position - carried;
+    reader->record_position += length - carried;
+
+    if (overlap > 0) 
+    {
+        if (reader->tail_capacity < overlap) 
+        {
+            reader->tail = xrealloc(reader->tail, overlap);
+            reader->tail_capacity = overlap;
+        }
+
+        reader->tail_len = length < overlap ? length : overlap;
+        memcpy(reader->tail, chunk + length - reader->tail_len, reader->tail_len);
+    }
+
+    return length;
+}
+
+int fasta_read_record(fasta_reader *reader, char **sequence, int64_t *capacity, int64_t *length)
+{
+    int64_t position;
+
+    *length = 0;
+    reader->hold_record = 0;
+
+    while (1) 
+    {
+        if (*capacity - *length < FASTA_READ_BUFFER + 1) 
+        {
+            int64_t grown = *capacity * 2;
+
+            if (grown < *length + 2 * FASTA_READ_BUFFER) 
+            {
+                grown = *length + 2 * FASTA_READ_BUFFER;
+            }
+
+            *sequence = xrealloc(*sequence, (size_t)grown);
+            *capacity = grown;
+        }
+
+        int64_t space = *capacity - *length - 1;
+        int chunk = fasta_read_chunk(reader, *sequence + *length, space > (1 << 30) ? (1 << 30) : (int)space, 0, &position);
+
+        if (chunk == 0) 
+        {
+            break;
+        }
+
+        *length += chunk;
+        reader->hold_record = 1;
+    }
+
+    reader->hold_record = 0;
+    (*sequence)[*length] = '\0';
+
+    return *length > 0;
+}
+
+typedef struct {
+    const char *name;
+    int name_length;
+    int64_t length;
+    int64_t offset;
+    int64_t line_bases;
+    int64_t line_width;
+} fai_entry;
+
+typedef struct {
+    fai_entry *entries;
+    fai_entry **sorted;
+    int count;
+    char *data;
+    size_t size;
+    int mapped;
+} fai_index;
+
+int fai_add_line(fai_entry *entry, int64_t bytes, int carriage_return, int *short_line)
+{
+    int64_t bases = bytes - (carriage_return ? 1 : 0);
+
+    if (bases <= 0) 
+    {
+        *short_line = 1;
+        return 1;
+    }
+
+    if (*short_line || (entry->line_bases > 0 && (bases > entry->line_bases || (bases == entry->line_bases && bytes + 1 != entry->line_width)))) 
+    {
+        return 0;
+    }
+
+    if (entry->line_bases == 0) 
+    {
+        entry->line_bases = bases;
+        entry->line_width = bytes + 1;
+    }
+    else if (bases < entry->line_bases) 
+    {
+        *short_line = 1;
+    }
+
+    entry->length += bases;
+
+    return 1;
+}
+
+void fai_write_entry(FILE *out, const char *name, const fai_entry *entry)
+{
+    fprintf(out, "%s\t%lld\t%lld\t%lld\t%lld\n", name, (long long)entry->length, (long long)entry->offset, (long long)entry->line_bases, (long long)entry->line_width);
+}
+
+int fai_build(const char *fasta_file, const char *index_file)
+{
+    FILE *in = fopen(fasta_file, "rb");
+
+    if (in == NULL) 
+    {
+        log_printf("Error: Could not open FASTA file '%s'\n", fasta_file);
+        return 0;
+    }
+
+    FILE *out = fopen(index_file, "wb");
+
+    if (out == NULL) 
+    {
+        log_printf("Error: Could not open index file '%s' for writing\n", index_file);
+        fclose(in);
+        return 0;
+    }
+
+    char *buffer = xmalloc(FASTA_READ_BUFFER);
+    char name[MAX_FILENAME_LENGTH];
+    fai_entry entry;
+    int name_length = 0;
+    int name_done = 0;
+    int in_header = 0;
+    int at_line_start = 1;
+    int record_open = 0;
+    int short_line = 0;
+    int status = 1;
+    char last = 0;
+    int64_t offset = 0;
+    int64_t line_bytes = 0;
+    size_t count;
+
+    memset(&entry, 0, sizeof(entry));
+    name[0] = '\0';
+
+    while (status && (count = fread(buffer, 1, FASTA_READ_BUFFER, in)) > 0) 
+    {
+        size_t pos = 0;
+
+        while (pos < count) 
+        {
+            if (at_line_start) 
+            {
+                at_line_start = 0;
+                line_bytes = 0;
+                last = 0;
+
+                if (buffer[pos] == '>') 
+                {
+                    if (record_open) 
+                    {
+                        fai_write_entry(out, name, &entry);
+                    }
+
+                    memset(&entry, 0, sizeof(entry));
+                    in_header = 1;
+                    record_open = 1;
+                    short_line = 0;
+                    name_length = 0;
+                    name_done = 0;
+                    pos++;
+                    continue;
+                }
+
+                if (!record_open && !isspace((unsigned char)buffer[pos])) 
+                {
+                    log_printf("Error: '%s' is not a FASTA file; cannot index\n", fasta_file);
+                    status = 0;
+                    break;
+                }
+            }
+
+            char *newline = memchr(buffer + pos, '\n', count - pos);
+            size_t end = newline != NULL ? (size_t)(newline - buffer) : count;
+
+            if (in_header) 
+            {
+                for (; pos < end; pos++) 
+                {
+                    if (isspace((unsigned char)buffer[pos])) 
+                    {
+                        name_done = name_length > 0;
+                    }
+                    else if (!name_done && name_length < MAX_FILENAME_LENGTH - 1) 
+                    {
+                        name[name_length++] = buffer[pos];
+                    }
+                }
+
+                name[name_length] = '\0';
+            }
+            else if (end > pos) 
+            {
+                line_bytes += end - pos;
+                last = buffer[end - 1];
+            }
+
+            pos = end;
+
+            if (newline == NULL) 
+            {
+                continue;
+            }
+
+            pos++;
+            at_line_start = 1;
+
+            if (in_header) 
+            {
+                in_header = 0;
+                entry.offset = offset + pos;
+            }
+            else if (record_open && !fai_add_line(&entry, line_bytes, last == '\r', &short_line)) 
+            {
+                log_printf("Error: Record '%s' in '%s' has uneven line lengths; cannot index\n", name, fasta_file);
+                status = 0;
+                break;
+            }
+        }
+
+        offset += count;
+    }
+
+    if (status && record_open && !at_line_start) 
+    {
+        if (in_header) 
+        {
+            entry.offset = offset;
+        }
+        else if (!fai_add_line(&entry, line_bytes, last == '\r', &short_line)) 
+        {
+            log_printf("Error: Record '%s' in '%s' has uneven line lengths; cannot index\n", name, fasta_file);
+            status = 0;
+        }
+    }
+
+    if (status && record_open) 
+    {
+        fai_write_entry(out, name, &entry);
+    }
+
+    free(buffer);
+    fclose(in);
+
+    if (fclose(out) != 0 && status) 
+    {
+        log_printf("Error: Could not write index file '%s'\n", index_file);
+        status = 0;
+    }
+
+    if (!status) 
+    {
+        remove(index_file);
+    }
+
+    return status;
+}
+
+int fai_parse_field(const char **cursor, const char *end, int64_t *value)
+{
+    const char *text = *cursor;
+    int64_t result = 0;
+
+    if (text >= end || !isdigit((unsigned char)*text)) 
+    {
+        return 0;
+    }
+
+    while (text < end && isdigit((unsigned char)*text)) 
+    {
+        result = result * 10 + (*text++ - '0');
+    }
+
+    if (text < end && *text == '\t') 
+    {
+        text++;
+    }
+
+    *cursor = text;
+    *value = result;
+
+    return 1;
+}
+
+int compare_fai_entries(const void *a, const void *b)
+{
+    const fai_entry *left = *(const fai_entry * const *)a;
+    const fai_entry *right = *(const fai_entry * const *)b;
+    int shared = left->name_length < right->name_length ? left->name_length : right->name_length;
+    int order = memcmp(left->name, right->name, (size_t)shared);
+
+    return order != 0 ? order : left->name_length - right->name_length;
+}
+
+int fai_map(fai_index *index, const char *filename)
+{
+#ifdef _WIN32
+    FILE *file = fopen(filename, "rb");
+
+    if (file == NULL) 
+    {
+        return 0;
+    }
+
+    _fseeki64(file, 0, SEEK_END);
+    index->size = (size_t)_ftelli64(file);
+    rewind(file);
+    index->data = xmalloc(index->size + 1);
+    index->mapped = 0;
+
+    int ok = fread(index->data, 1, index->size, file) == index->size;
+
+    fclose(file);
+
+    return ok;
+#else
+    int fd = open(filename, O_RDONLY);
+    struct stat info;
+
+    if (fd < 0) 
+    {
+        return 0;
+    }
+
+    if (fstat(fd, &info) != 0) 
+    {
+        close(fd);
+        return 0;
+    }
+
+    index->size = (size_t)info.st_size;
+    index->data = NULL;
+    index->mapped = index->size > 0;
+
+    if (index->mapped) 
+    {
+        void *data = mmap(NULL, index->size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        if (data == MAP_FAILED) 
+        {
+            close(fd);
+            return 0;
+        }
+
+        index->data = data;
+    }
+
+    close(fd);
+
+    return 1;
+#endif
+}
+
+void fai_close(fai_index *index)
+{
+#ifndef _WIN32
+    if (index->mapped) 
+    {
+        munmap(index->data, index->size);
+        index->data = NULL;
+    }
+#endif
+
+    free(index->data);
+    free(index->entries);
+    free(index->sorted);
+
+    index->data = NULL;
+    index->entries = NULL;
+    index->sorted = NULL;
+    index->count = 0;
+}
+
+int fai_load(fai_index *index, const char *filename)
+{
+    memset(index, 0, sizeof(*index));
+
+    if (!fai_map(index, filename)) 
+    {
+        log_printf("Error: Could not read index file '%s'\n", filename);
+        return 0;
+    }
+
+    const char *cursor = index->data;
+    const char *end = index->data + index->size;
+    int capacity = 0;
+
+    while (cursor < end) 
+    {
+        const char *line_end = memchr(cursor, '\n', (size_t)(end - cursor));
+        const char *tab;
+        fai_entry entry;
+
+        if (line_end == NULL) 
+        {
+            line_end = end;
+        }
+
+        tab = memchr(cursor, '\t', (size_t)(line_end - cursor));
+
+        if (tab == NULL || tab == cursor) 
+        {
+            log_printf("Error: Malformed index file '%s'\n", filename);
+            fai_close(index);
+            return 0;
+        }
+
+        entry.name = cursor;
+        entry.name_length = (int)(tab - cursor);
+        cursor = tab + 1;
+
+        if (!fai_parse_field(&cursor, line_end, &entry.length) || !fai_parse_field(&cursor, line_end, &entry.offset) || !fai_parse_field(&cursor, line_end, &entry.line_bases) || !fai_parse_field(&cursor, line_end, &entry.line_width) || (entry.length > 0 && entry.line_bases <= 0)) 
+        {
+            log_printf("Error: Malformed index file '%s'\n", filename);
+            fai_close(index);
+            return 0;
+        }
+
+        if (index->count == capacity) 
+        {
+            capacity = capacity > 0 ? capacity * 2 : 64;
+            index->entries = xrealloc(index->entries, sizeof(fai_entry) * capacity);
+        }
+
+        index->entries[index->count++] = entry;
+        cursor = line_end + 1;
+    }
+
+    index->sorted = xmalloc(sizeof(fai_entry *) * (index->count > 0 ? index->count : 1));
+
+    for (int i = 0; i < index->count; i++) 
+    {
+        index->sorted[i] = &index->entries[i];
+    }
+
+    qsort(index->sorted, index->count, sizeof(fai_entry *), compare_fai_entries);
+
+    return 1;
+}
+
+int fai_open(fai_index *index, const char *fasta_file)
+{
+    char index_file[MAX_FILENAME_LENGTH + 4];
+    struct stat fasta_info;
+    struct stat index_info;
+
+    snprintf(index_file, sizeof(index_file), "%s.fai", fasta_file);
+
+    if (stat(fasta_file, &fasta_info) != 0) 
+    {
+        log_printf("Error: Could not open FASTA file '%s'\n", fasta_file);
+        return 0;
+    }
+
+    if (stat(index_file, &index_info) != 0 || index_info.st_mtime < fasta_info.st_mtime) 
+    {
+        if (!fai_build(fasta_file, index_file)) 
+        {
+            return 0;
+        }
+    }
+
+    return fai_load(index, index_file);
+}
+
+const fai_entry *fai_find(const fai_index *index, const char *name, int name_length)
+{
+    int low = 0;
+    int high = index->count - 1;
+
+    while (low <= high) 
+    {
+        int middle = low + (high - low) / 2;
+        const fai_entry *entry = index->sorted[middle];
+        int shared = entry->name_length < name_length ? entry->name_length : name_length;
+        int order = memcmp(entry->name, name, (size_t)shared);
+
+        if (order == 0) 
+        {
+            order = entry->name_length - name_length;
+        }
+
+        if (order == 0) 
+        {
+            return entry;
+        }
+
+        if (order < 0) 
+        {
+            low = middle + 1;
+        }
+        else 
+        {
+            high = middle - 1;
+        }
+    }
+
+    return NULL;
+}
+
+int64_t fai_offset(const fai_entry *entry, int64_t position)
+{
+    return entry->offset + position / entry->line_bases * entry->line_width + position % entry->line_bases;
+}
+
+int64_t fai_fetch(FILE *file, const fai_entry *entry, int64_t begin, int64_t end, char **sequence, int64_t *capacity)
+{
+    int64_t first = fai_offset(entry, begin);
+    int64_t span = fai_offset(entry, end - 1) + 1 - first;
+    int64_t length = 0;
+
+    if (*capacity < span + 1) 
+    {
+        *sequence = xrealloc(*sequence, (size_t)span + 1);
+        *capacity = span + 1;
+    }
+
+    if (file_seek(file, first) != 0 || fread(*sequence, 1, (size_t)span, file) != (size_t)span) 
+    {
+        log_printf("Error: Could not read %.*s:%lld-%lld from FASTA file\n", entry->name_length, entry->name, (long long)begin + 1, (long long)end);
+        return -1;
+    }
+
+    for (int64_t i = 0; i < span; i++) 
+    {
+        char base = fasta_base_table[(unsigned char)(*sequence)[i]];
+
+        if (base != 0) 
+        {
+            (*sequence)[length++] = base;
+        }
+    }
+
+    (*sequence)[length] = '\0';
+
+    return length;
+}
+
+int read_fasta_single_sequence(const char *filename, const char *record, char *sequence) 
+{
+    FILE *file = fopen(filename, "r");
+
+    if (file == NULL) 
+    {
+        log_printf("Error: Could not open FASTA file '%s'\n", filename);
+        return 0;
+    }
+
+    char line[1024];
+    int seq_started = 0;
+    int seq_len = 0;
+
+    if (record != NULL && record[0] != '\0') 
+    {
+        fai_index index;
+
+        if (!fai_open(&index, filename)) 
+        {
+            fclose(file);
+            return 0;
+        }
+
+        const fai_entry *entry = fai_find(&index, record, strlen(record));
+
+        if (entry == NULL || file_seek(file, entry->offset) != 0) 
+        {
+            log_printf("Error: Record '%s' not found in FASTA file '%s'\n", record, filename);
+            fai_close(&index);
+            fclose(file);
+            return 0;
+        }
+
+        fai_close(&index);
+        seq_started = 1;
+    }
+
+    while (fgets(line, sizeof(line), file) != NULL) 
+    {
+        if (line[0] == '>') 
+        {
+            if (seq_started) 
+            {
+                break;
+            }
+
+            seq_started = 1;
+            continue;
+        }
+
+        if (!seq_started) 
+        {
+            continue;
+        }
+
+        int i = 0;
+
+        while (line[i] != '\0' && line[i] != '\n' && line[i] != '\r') 
+        {
+            char base = toupper(line[i]);
+
+            if (is_valid_base(base)) 
+            {
+                if (seq_len < MAX_DNA_LENGTH - 1) 
+                {
+                    sequence[seq_len] = base;
+                    seq_len++;
+                }
+            }
+
+            i++;
+        }
+
+        if (seq_len == MAX_DNA_LENGTH - 1) 
+        {
+            break;
+        }
+    }
+
+    fclose(file);
+
+    sequence[seq_len] = '\0';
+
+    if (seq_len == 0) 
+    {
+        log_printf("Error: No DNA sequence found in FASTA file '%s'\n", filename);
+        return 0;
+    }
+
+    return 1;
+}
+
+int fasta_reader_open_record(fasta_reader *reader, const char *filename, const char *record)
+{
+    if (!fasta_reader_open(reader, filename)) 
+    {
+        return 0;
+    }
+
+    if (record == NULL || record[0] == '\0') 
+    {
+        return 1;
+    }
+
+    fai_index index;
+
+    if (!fai_open(&index, filename)) 
+    {
+        fasta_reader_close(reader);
+        return 0;
+    }
+
+    const fai_entry *entry = fai_find(&index, record, strlen(record));
+
+    if (entry == NULL || reader->io == NULL) 
+    {
+        log_printf("Error: Record '%s' not found in FASTA file '%s'\n", record, filename);
+        fai_close(&index);
+        fasta_reader_close(reader);
+        return 0;
+    }
+
+    io_reader_start(reader->io, entry->offset, entry->length > 0 ? fai_offset(entry, entry->length - 1) + 1 - entry->offset : 0);
+    reader->format_known = 1;
+    reader->line_records = 0;
+    snprintf(reader->name, MAX_FILENAME_LENGTH, "%.*s", entry->name_length, entry->name);
+    fai_close(&index);
+
+    return 1;
+}
+
+int run_faidx_mode(const options *config)
+{
+    char index_file[MAX_FILENAME_LENGTH + 4];
+    int64_t start = now_ns();
+    int64_t bases = 0;
+    fai_index index;
+
+    snprintf(index_file, sizeof(index_file), "%s.fai", config->faidx_file);
+
+    if (!fai_build(config->faidx_file, index_file) || !fai_load(&index, index_file)) 
+    {
+        return 0;
+    }
+
+    for (int i = 0; i < index.count; i++) 
+    {
+        bases += index.entries[i].length;
+    }
+
+    log_printf("\n=== FASTA Index ===\n\n");
+    log_printf("Index file : %s\n", index_file);
+    log_printf("Records    : %d\n", index.count);
+    log_printf("Bases      : %lld\n", (long long)bases);
+    log_printf("Time       : %.3f seconds\n\n", (now_ns() - start) / 1e9);
+
+    fai_close(&index);
+
+    return 1;
+}
+
+typedef struct {
+    int frame;
+    int start;
+    int end;
+} orf_hit;
+
+void print_orf(const sequence_view *view, int frame, int start, int end, int reverse, scratch_arena *arena) 
+{
+    int length = end - start + 1;
+
+    if (length <= 0) 
+    {
+        return;
+    }
+
+    char *aa_sequence = arena_alloc(arena, length / 3 + 1);
+    int aa_index = 0;
+    view_cursor cursor;
+
+    view_cursor_init(&cursor, view);
+
+    for (int i = start; i + 2 <= end; i += 3) 
+    {
+        char aa = translate_codon(view_cursor_span(&cursor, i, 3));
+
+        if (aa == '*') 
+        {
+            break;
+        }
+
+        aa_sequence[aa_index] = aa;
+        aa_index++;
+    }
+
+    aa_sequence[aa_index] = '\0';
+
+    if (reverse) 
+    {
+        log_printf("Frame %d: Start=%d End=%d Length=%d\n", frame, view->length - 1 - end, view->length - 1 - start, length);
+    }
+    else 
+    {
+        log_printf("Frame %d: Start=%d End=%d Length=%d\n", frame, start, end, length);
+    }
+    log_printf("Amino Acid Sequence: %s\n\n", aa_sequence);
+}
+
+void orf_push(orf_hit **hits, int *count, int *capacity, int frame, int start, int end, scratch_arena *arena) 
+{
+    if (*count == *capacity) 
+    {
+        int grown = *capacity == 0 ? 16 : *capacity * 2;
+
+        *hits = arena_grow(arena, *hits, sizeof(orf_hit) * *capacity, sizeof(orf_hit) * grown);
+        *capacity = grown;
+    }
+
+    (*hits)[*count].frame = frame;
+    (*hits)[*count].start = start;
+    (*hits)[*count].end = end;
+    (*count)++;
+}
+
+int collect_orfs_view(const sequence_view *view, orf_hit **hits, scratch_arena *arena) 
+{
+    int seq_len = view->length;
+    int count = 0;
+    int capacity = 0;
+    view_cursor cursor;
+
+    *hits = NULL;
+    view_cursor_init(&cursor, view);
+
+    for (int frame = 0; frame < 3; frame++) 
+    {
+        int i = frame;
+
+        while (i + 2 < seq_len) 
+        {
+            const char *codon = view_cursor_span(&cursor, i, 3);
+
+            if (codon[0] == 'A' && codon[1] == 'T' && codon[2] == 'G') 
+            {
+                int start = i;
+                int j = i + 3;
+                int found_stop = 0;
+
+                while (j + 2 < seq_len) 
+                {
+                    codon = view_cursor_span(&cursor, j, 3);
+
+                    if (strncmp(codon, "TAA", 3) == 0 || strncmp(codon, "TAG", 3) == 0 || strncmp(codon, "TGA", 3) == 0) 
+                    {
+                        found_stop = 1;
+                        break;
+                    }
+
+                    j += 3;
+                }
+
+                if (found_stop) 
+                {
+                    orf_push(hits, &count, &capacity, frame, start, j + 2, arena);
+                    i = j + 3;
+                } 
+                else 
+                {
+                    orf_push(hits, &count, &capacity, frame, start, seq_len - 1, arena);
+                    break;
+                }
+            } 
+            else 
+            {
+                i += 3;
+            }
+        }
+    }
+
+    return count;
+}
+
+int collect_orfs(const char *sequence, int seq_len, orf_hit **hits, scratch_arena *arena) 
+{
+    sequence_view view;
+
+    sequence_view_init(&view, (char *)sequence, seq_len);
+
+    return collect_orfs_view(&view, hits, arena);
+}
+
+void find_orfs_view(const sequence_view *view, const char *title, int reverse, scratch_arena *arena) 
+{
+    orf_hit *hits;
+    int count = collect_orfs_view(view, &hits, arena);
+
+    log_printf("\n=== %s ===\n\n", title);
+
+    for (int h = 0; h < count; h++) 
+    {
+        print_orf(view, hits[h].frame, hits[h].start, hits[h].end, reverse, arena);
+    }
+}
+
+void find_orfs(const char *sequence, scratch_arena *arena) 
+{
+    sequence_view view;
+
+    sequence_view_init(&view, (char *)sequence, strlen(sequence));
+    find_orfs_view(&view, "Open Reading Frames (ORFs)", 0, arena);
+}
+
+typedef struct {
+    uint64_t kmer;
+    uint64_t count;
+} kmer_entry;
+
+typedef struct {
+    kmer_entry *slots;
+    size_t capacity;
+    size_t used;
+} kmer_table;
+
+typedef struct {
+    int partition;
+    int64_t offset;
+    size_t count;
+} kmer_run;
+
+typedef struct {
+    fasta_reader *reader;
+    worker_mutex *reader_lock;
+    int k;
+    size_t memory_budget;
+    size_t memory_used;
+    kmer_table tables[KMER_PARTITIONS];
+    FILE *spill_file;
+    kmer_run *runs;
+    int run_count;
+    int run_capacity;
+    uint64_t total_kmers;
+} kmer_worker;
+
+typedef struct {
+    kmer_entry *memory;
+    FILE *file;
+    int64_t offset;
+    size_t remaining;
+    kmer_entry *buffer;
+    size_t buffer_pos;
+    size_t buffer_len;
+} kmer_source;
+
+uint64_t mix64(uint64_t value)
+{
+    value ^= value >> 30;
+    value *= 0xBF58476D1CE4E5B9ULL;
+    value ^= value >> 27;
+    value *= 0x94D049BB133111EBULL;
+    value ^= value >> 31;
+
+    return value;
+}
+
+int base_code(char base)
+{
+    if (base == 'A') 
+    {
+        return 0;
+    }
+
+    if (base == 'C') 
+    {
+        return 1;
+    }
+
+    if (base == 'G') 
+    {
+        return 2;
+    }
+
+    if (base == 'T') 
+    {
+        return 3;
+    }
+
+    return -1;
+}
+
+void kmer_decode(uint64_t kmer, int k, char *out)
+{
+    const char bases[] = { 'A', 'C', 'G', 'T' };
+
+    for (int i = k - 1; i >= 0; i--) 
+    {
+        out[i] = bases[kmer & 3];
+        kmer >>= 2;
+    }
+
+    out[k] = '\0';
+}
+
+int compare_kmer_entries(const void *a, const void *b)
+{
+    uint64_t x = ((const kmer_entry *)a)->kmer;
+    uint64_t y = ((const kmer_entry *)b)->kmer;
+
+    return (x > y) - (x < y);
+}
+
+void kmer_table_init(kmer_table *table, size_t capacity)
+{
+    table->slots = calloc(capacity, sizeof(kmer_entry));
+
+    if (table->slots == NULL) 
+    {
+        fprintf(stderr, "Error: Out of memory (k-mer table).\n");
+        exit(1);
+    }
+
+    table->capacity = capacity;
+    table->used = 0;
+}
+
+size_t kmer_table_compact(kmer_table *table)
+{
+    size_t out = 0;
+
+    for (size_t i = 0; i < table->capacity; i++) 
+    {
+        if (table->slots[i].count != 0) 
+        {
+            table->slots[out++] = table->slots[i];
+        }
+    }
+
+    qsort(table->slots, out, sizeof(kmer_entry), compare_kmer_entries);
+
+    return out;
+}
+
+void kmer_table_insert_hashed(kmer_table *table, uint64_t kmer, uint64_t hash, uint64_t count)
+{
+    size_t mask = table->capacity - 1;
+    size_t slot = hash & mask;
+
+    while (table->slots[slot].count != 0) 
+    {
+        if (table->slots[slot].kmer == kmer) 
+        {
+            table->slots[slot].count += count;
+            return;
+        }
+
+        slot = (slot + 1) & mask;
+    }
+
+    table->slots[slot].kmer = kmer;
+    table->slots[slot].count = count;
+    table->used++;
+}
+
+void kmer_table_grow(kmer_table *table)
+{
+    kmer_table grown;
+
+    kmer_table_init(&grown, table->capacity * 2);
+
+    for (size_t i = 0; i < table->capacity; i++) 
+    {
+        if (table->slots[i].count != 0) 
+        {
+            kmer_table_insert_hashed(&grown, table->slots[i].kmer, mix64(table->slots[i].kmer), table->slots[i].count);
+        }
+    }
+
+    free(table->slots);
+    *table = grown;
+}
+
+void kmer_worker_spill(kmer_worker *worker, int partition)
+{
+    kmer_table *table = &worker->tables[partition];
+
+    if (table->used == 0) 
+    {
+        return;
+    }
+
+    if (worker->spill_file == NULL) 
+    {
+        worker->spill_file = tmpfile();
+
+        if (worker->spill_file == NULL) 
+        {
+            fprintf(stderr, "Error: Could not create temporary spill file.\n");
+            exit(1);
+        }
+    }
+
+    size_t count = kmer_table_compact(table);
+
+    if (worker->run_count == worker->run_capacity) 
+    {
+        worker->run_capacity = worker->run_capacity == 0 ? 64 : worker->run_capacity * 2;
+        worker->runs = xrealloc(worker->runs, sizeof(kmer_run) * worker->run_capacity);
+    }
+
+    fseek(worker->spill_file, 0, SEEK_END);
+
+    kmer_run *run = &worker->runs[worker->run_count++];
+    run->partition = partition;
+    run->offset = file_tell(worker->spill_file);
+    run->count = count;
+
+    if (fwrite(table->slots, sizeof(kmer_entry), count, worker->spill_file) != count) 
+    {
+        fprintf(stderr, "Error: Failed to write k-mer spill file.\n");
+        exit(1);
+    }
+
+    worker->memory_used -= table->capacity * sizeof(kmer_entry);
+    free(table->slots);
+    kmer_table_init(table, 1024);
+    worker->memory_used += table->capacity * sizeof(kmer_entry);
+}
+
+void kmer_worker_add(kmer_worker *worker, uint64_t kmer)
+{
+    uint64_t hash = mix64(kmer);
+    int partition = (int)(hash >> 58);
+    kmer_table *table = &worker->tables[partition];
+
+    if ((table->used + 1) * 10 > table->capacity * 7) 
+    {
+        size_t extra = table->capacity * sizeof(kmer_entry) * 2;
+
+        while (worker->memory_used + extra > worker->memory_budget) 
+        {
+            int largest = 0;
+
+            for (int p = 1; p < KMER_PARTITIONS; p++) 
+            {
+                if (worker->tables[p].used > worker->tables[largest].used) 
+                {
+                    largest = p;
+                }
+            }
+
+            if (worker->tables[largest].used == 0) 
+            {
+                break;
+            }
+
+            kmer_worker_spill(worker, largest);
+
+            if (largest == partition) 
+            {
+                break;
+            }
+        }
+
+        if ((table->used + 1) * 10 > table->capacity * 7) 
+        {
+            worker->memory_used -= table->capacity * sizeof(kmer_entry);
+            kmer_table_grow(table);
+            worker->memory_used += table->capacity * sizeof(kmer_entry);
+        }
+    }
+
+    kmer_table_insert_hashed(table, kmer, hash, 1);
+}
+
+void count_kmers_in_chunk(kmer_worker *worker, const char *chunk, int length)
+{
+    int k = worker->k;
+    uint64_t mask = k == 32 ? ~(uint64_t)0 : (((uint64_t)1 << (2 * k)) - 1);
+    int shift = 2 * (k - 1);
+    uint64_t forward = 0;
+    uint64_t reverse = 0;
+    int valid = 0;
+
+    for (int i = 0; i < length; i++) 
+    {
+        int code = base_code(chunk[i]);
+
+        if (code < 0) 
+        {
+            valid = 0;
+            continue;
+        }
+
+        forward = ((forward << 2) | (uint64_t)code) & mask;
+        reverse = (reverse >> 2) | ((uint64_t)(3 - code) << shift);
+        valid++;
+
+        if (valid >= k) 
+        {
+            kmer_worker_add(worker, forward < reverse ? forward : reverse);
+            worker->total_kmers++;
+        }
+    }
+}
+
+void *kmer_count_worker(void *arg)
+{
+    kmer_worker *worker = arg;
+    char *chunk = xmalloc(KMER_CHUNK_SIZE + MAX_KMER_SIZE);
+
+    while (1) 
+    {
+        int64_t position;
+
+        worker_mutex_lock(worker->reader_lock);
+        int length = fasta_read_chunk(worker->reader, chunk, KMER_CHUNK_SIZE + worker->k - 1, worker->k - 1, &position);
+        worker_mutex_unlock(worker->reader_lock);
+
+        if (length == 0) 
+        {
+            break;
+        }
+
+        count_kmers_in_chunk(worker, chunk, length);
+    }
+
+    free(chunk);
+
+    return NULL;
+}
+
+void *kmer_sort_worker(void *arg)
+{
+    kmer_worker *worker = arg;
+
+    for (int p = 0; p < KMER_PARTITIONS; p++) 
+    {
+        worker->tables[p].used = kmer_table_compact(&worker->tables[p]);
+    }
+
+    return NULL;
+}
+
+int kmer_source_next(kmer_source *source, kmer_entry *entry)
+{
+    if (source->buffer_pos == source->buffer_len) 
+    {
+        if (source->remaining == 0) 
+        {
+            return 0;
+        }
+
+        size_t batch = source->remaining < KMER_RUN_BUFFER ? source->remaining : KMER_RUN_BUFFER;
+
+        if (source->memory != NULL) 
+        {
+            source->buffer = source->memory;
+            source->memory += batch;
+        } 
+        else 
+        {
+            file_seek(source->file, source->offset);
+
+            if (fread(source->buffer, sizeof(kmer_entry), batch, source->file) != batch) 
+            {
+                fprintf(stderr, "Error: Failed to read k-mer spill file.\n");
+                exit(1);
+            }
+
+            source->offset += (int64_t)(batch * sizeof(kmer_entry));
+        }
+
+        source->remaining -= batch;
+        source->buffer_pos = 0;
+        source->buffer_len = batch;
+    }
+
+    *entry = source->buffer[source->buffer_pos++];
+
+    return 1;
+}
+
+void kmer_heap_sift_down(int *heap, int size, int index, const kmer_entry *heads)
+{
+    while (1) 
+    {
+        int smallest = index;
+        int left = 2 * index + 1;
+        int right = left + 1;
+
+        if (left < size && heads[heap[left]].kmer < heads[heap[smallest]].kmer) 
+        {
+            smallest = left;
+        }
+
+        if (right < size && heads[heap[right]].kmer < heads[heap[smallest]].kmer) 
+        {
+            smallest = right;
+        }
+
+        if (smallest == index) 
+        {
+            return;
+        }
+
+        int temp = heap[index];
+        heap[index] = heap[smallest];
+        heap[smallest] = temp;
+        index = smallest;
+    }
+}
+
+uint64_t merge_kmer_partition(kmer_worker *workers, int worker_count, int partition, FILE *out, int k)
+{
+    int source_count = 0;
+
+    for (int w = 0; w < worker_count; w++) 
+    {
+        source_count++;
+
+        for (int r = 0; r < workers[w].run_count; r++) 
+        {
+            if (workers[w].runs[r].partition == partition) 
+            {
+                source_count++;
+            }
+        }
+    }
+
+    kmer_source *sources = xmalloc(sizeof(kmer_source) * source_count);
+    kmer_entry *heads = xmalloc(sizeof(kmer_entry) * source_count);
+    int *heap = xmalloc(sizeof(int) * source_count);
+    int used = 0;
+
+    for (int w = 0; w < worker_count; w++) 
+    {
+        kmer_source *source = &sources[used++];
+
+        memset(source, 0, sizeof(*source));
+        source->memory = workers[w].tables[partition].slots;
+        source->remaining = workers[w].tables[partition].used;
+
+        for (int r = 0; r < workers[w].run_count; r++) 
+        {
+            if (workers[w].runs[r].partition != partition) 
+            {
+                continue;
+            }
+
+            source = &sources[used++];
+            memset(source, 0, sizeof(*source));
+            source->file = workers[w].spill_file;
+            source->offset = workers[w].runs[r].offset;
+            source->remaining = workers[w].runs[r].count;
+            source->buffer = xmalloc(sizeof(kmer_entry) * KMER_RUN_BUFFER);
+        }
+    }
+
+    int heap_size = 0;
+
+    for (int s = 0; s < source_count; s++) 
+    {
+        if (kmer_source_next(&sources[s], &heads[s])) 
+        {
+            heap[heap_size++] = s;
+        }
+    }
+
+    for (int i = heap_size / 2 - 1; i >= 0; i--) 
+    {
+        kmer_heap_sift_down(heap, heap_size, i, heads);
+    }
+
+    uint64_t distinct = 0;
+    char text[MAX_KMER_SIZE + 1];
+
+    while (heap_size > 0) 
+    {
+        uint64_t kmer = heads[heap[0]].kmer;
+        uint64_t count = 0;
+
+        while (heap_size > 0 && heads[heap[0]].kmer == kmer) 
+        {
+            int s = heap[0];
+
+            count += heads[s].count;
+
+            if (!kmer_source_next(&sources[s], &heads[s])) 
+            {
+                heap[0] = heap[--heap_size];
+            }
+
+            kmer_heap_sift_down(heap, heap_size, 0, heads);
+        }
+
+        kmer_decode(kmer, k, text);
+        fprintf(out, "%s\t%llu\n", text, (unsigned long long)count);
+        distinct++;
+    }
+
+    for (int s = 0; s < source_count; s++) 
+    {
+        if (sources[s].memory == NULL) 
+        {
+            free(sources[s].buffer);
+        }
+    }
+
+    free(heap);
+    free(heads);
+    free(sources);
+
+    return distinct;
+}
+
+void run_kmer_count_mode(const options *config)
+{
+    const char *input = NULL;
+
+    if (config->do_fasta_input == 1) 
+    {
+        input = config->fasta_input_file;
+    } 
+    else if (config->file_mode == 1) 
+    {
+        input = config->input_file;
+    }
+
+    fasta_reader reader;
+
+    if (!fasta_reader_open_record(&reader, input, config->fasta_record)) 
+    {
+        return;
+    }
+
+    FILE *out = stdout;
+    char *out_buffer = NULL;
+
+    if (config->kmer_output_file[0] != '\0') 
+    {
+        out = fopen(config->kmer_output_file, "w");
+
+        if (out == NULL) 
+        {
+            log_printf("Error: Could not open k-mer output file '%s'\n", config->kmer_output_file);
+            fasta_reader_close(&reader);
+            return;
+        }
+
+        out_buffer = xmalloc(1 << 20);
+        setvbuf(out, out_buffer, _IOFBF, 1 << 20);
+    }
+
+    int thread_count = config->thread_count > 0 ? config->thread_count : default_thread_count();
+    int64_t mem_limit = config->mem_limit > 0 ? config->mem_limit : DEFAULT_MEM_LIMIT;
+    size_t initial_bytes = (size_t)KMER_PARTITIONS * 1024 * sizeof(kmer_entry);
+    worker_mutex reader_lock;
+
+    worker_mutex_init(&reader_lock);
+
+    kmer_worker *workers = xmalloc(sizeof(kmer_worker) * thread_count);
+
+    for (int w = 0; w < thread_count; w++) 
+    {
+        memset(&workers[w], 0, sizeof(kmer_worker));
+        workers[w].reader = &reader;
+        workers[w].reader_lock = &reader_lock;
+        workers[w].k = config->kmer_size;
+        workers[w].memory_budget = (size_t)(mem_limit / thread_count);
+
+        if (workers[w].memory_budget < initial_bytes * 2) 
+        {
+            workers[w].memory_budget = initial_bytes * 2;
+        }
+
+        for (int p = 0; p < KMER_PARTITIONS; p++) 
+        {
+            kmer_table_init(&workers[w].tables[p], 1024);
+        }
+
+        workers[w].memory_used = initial_bytes;
+    }
+
+    run_workers(thread_count, kmer_count_worker, workers, sizeof(kmer_worker));
+    run_workers(thread_count, kmer_sort_worker, workers, sizeof(kmer_worker));
+
+    uint64_t total = 0;
+    uint64_t distinct = 0;
+    int spilled_runs = 0;
+
+    for (int w = 0; w < thread_count; w++) 
+    {
+        total += workers[w].total_kmers;
+        spilled_runs += workers[w].run_count;
+    }
+
+    for (int p = 0; p < KMER_PARTITIONS; p++) 
+    {
+        distinct += merge_kmer_partition(workers, thread_count, p, out, config->kmer_size);
+    }
+
+    fflush(out);
+
+    if (out != stdout) 
+    {
+        fclose(out);
+        free(out_buffer);
+    }
+
+    for (int w = 0; w < thread_count; w++) 
+    {
+        for (int p = 0; p < KMER_PARTITIONS; p++) 
+        {
+            free(workers[w].tables[p].slots);
+        }
+
+        if (workers[w].spill_file != NULL) 
+        {
+            fclose(workers[w].spill_file);
+        }
+
+        free(workers[w].runs);
+    }
+
+    free(workers);
+    worker_mutex_destroy(&reader_lock);
+    fasta_reader_close(&reader);
+
+    log_printf("\n=== K-mer Counting ===\n\n");
+    log_printf("K-mer size      : %d\n", config->kmer_size);
+    log_printf("Threads         : %d\n", thread_count);
+    log_printf("Memory limit    : %lld bytes\n", (long long)mem_limit);
+    log_printf("Total k-mers    : %llu\n", (unsigned long long)total);
+    log_printf("Distinct k-mers : %llu\n", (unsigned long long)distinct);
+    log_printf("Spilled runs    : %d\n\n", spilled_runs);
+}
+
+typedef struct {
+    char name[MAX_FILENAME_LENGTH];
+    uint64_t kmer_total;
+    uint64_t *hashes;
+    int count;
+    int capacity;
+    int size;
+    uint64_t threshold;
+} minhash_sketch;
+
+typedef struct {
+    int k;
+    int size;
+    minhash_sketch *entries;
+    int count;
+    int capacity;
+} sketch_set;
+
+typedef struct {
+    const char *path;
+    int k;
+    int size;
+    int per_record;
+    minhash_sketch *entries;
+    int count;
+    int capacity;
+    int failed;
+} sketch_job;
+
+typedef struct {
+    sketch_job *jobs;
+    int job_count;
+    int *next_job;
+    worker_mutex *lock;
+} sketch_worker;
+
+typedef struct {
+    const sketch_set *queries;
+    const sketch_set *references;
+    int row_start;
+    int row_end;
+    int *next_row;
+    worker_mutex *lock;
+    int *shared;
+    int *considered;
+} sketch_compare_worker;
+
+int compare_u64(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+void sketch_init(minhash_sketch *sketch, const char *name, int size)
+{
+    memset(sketch, 0, sizeof(*sketch));
+    strncpy(sketch->name, name, MAX_FILENAME_LENGTH - 1);
+    sketch->size = size;
+    sketch->capacity = size * 4;
+    sketch->hashes = xmalloc(sizeof(uint64_t) * sketch->capacity);
+    sketch->threshold = UINT64_MAX;
+}
+
+void sketch_compact(minhash_sketch *sketch)
+{
+    qsort(sketch->hashes, sketch->count, sizeof(uint64_t), compare_u64);
+
+    int unique = 0;
+
+    for (int i = 0; i < sketch->count; i++) 
+    {
+        if (unique == 0 || sketch->hashes[unique - 1] != sketch->hashes[i]) 
+        {
+            sketch->hashes[unique++] = sketch->hashes[i];
+        }
+    }
+
+    if (unique > sketch->size) 
+    {
+        unique = sketch->size;
+    }
+
+    sketch->count = unique;
+
+    if (unique == sketch->size) 
+    {
+        sketch->threshold = sketch->hashes[unique - 1];
+    }
+}
+
+void sketch_add_sequence(minhash_sketch *sketch, const char *sequence, int length, int k)
+{
+    uint64_t mask = k == 32 ? ~(uint64_t)0 : (((uint64_t)1 << (2 * k)) - 1);
+    int shift = 2 * (k - 1);
+    uint64_t forward = 0;
+    uint64_t reverse = 0;
+    int valid = 0;
+
+    for (int i = 0; i < length; i++) 
+    {
+        int code = base_code(sequence[i]);
+
+        if (code < 0) 
+        {
+            valid = 0;
+            continue;
+        }
+
+        forward = ((forward << 2) | (uint64_t)code) & mask;
+        reverse = (reverse >> 2) | ((uint64_t)(3 - code) << shift);
+        valid++;
+
+        if (valid < k) 
+        {
+            continue;
+        }
+
+        uint64_t hash = mix64(forward < reverse ? forward : reverse);
+
+        sketch->kmer_total++;
+
+        if (hash > sketch->threshold) 
+        {
+            continue;
+        }
+
+        if (sketch->count == sketch->capacity) 
+        {
+            sketch_compact(sketch);
+        }
+
+        sketch->hashes[sketch->count++] = hash;
+    }
+}
+
+void sketch_finish(minhash_sketch *sketch)
+{
+    sketch_compact(sketch);
+    sketch->capacity = sketch->count;
+}
+
+double sketch_jaccard(const minhash_sketch *a, const minhash_sketch *b, int *shared_out, int *considered_out)
+{
+    int size = a->size < b->size ? a->size : b->size;
+    int i = 0;
+    int j = 0;
+    int shared = 0;
+    int considered = 0;
+
+    while (considered < size && i < a->count && j < b->count) 
+    {
+        if (a->hashes[i] == b->hashes[j]) 
+        {
+            shared++;
+            i++;
+            j++;
+        } 
+        else if (a->hashes[i] < b->hashes[j]) 
+        {
+            i++;
+        } 
+        else 
+        {
+            j++;
+        }
+
+        considered++;
+    }
+
+    while (considered < size && (i < a->count || j < b->count)) 
+    {
+        if (i < a->count) 
+        {
+            i++;
+        } 
+        else 
+        {
+            j++;
+        }
+
+        considered++;
+    }
+
+    *shared_out = shared;
+    *considered_out = considered;
+
+    if (considered == 0) 
+    {
+        return 0.0;
+    }
+
+    return (double)shared / considered;
+}
+
+double mash_distance(double jaccard, int k)
+{
+    if (jaccard <= 0.0) 
+    {
+        return 1.0;
+    }
+
+    if (jaccard >= 1.0) 
+    {
+        return 0.0;
+    }
+
+    double distance = -log(2.0 * jaccard / (1.0 + jaccard)) / k;
+
+    return distance > 1.0 ? 1.0 : distance;
+}
+
+void sketch_job_push(sketch_job *job, const char *name)
+{
+    if (job->count == job->capacity) 
+    {
+        job->capacity = job->capacity == 0 ? 4 : job->capacity * 2;
+        job->entries = xrealloc(job->entries, sizeof(minhash_sketch) * job->capacity);
+    }
+
+    sketch_init(&job->entries[job->count++], name, job->size);
+}
+
+void build_sketches_for_file(sketch_job *job)
+{
+    fasta_reader reader;
+
+    if (!fasta_reader_open(&reader, job->path)) 
+    {
+        job->failed = 1;
+        return;
+    }
+
+    char *chunk = xmalloc(KMER_CHUNK_SIZE + MAX_KMER_SIZE);
+    long last_record = -1;
+    int64_t position;
+    int length;
+
+    while ((length = fasta_read_chunk(&reader, chunk, KMER_CHUNK_SIZE + job->k - 1, job->k - 1, &position)) > 0) 
+    {
+        if (job->count == 0 || (job->per_record && reader.record_index != last_record)) 
+        {
+            const char *name = job->path != NULL && job->path[0] != '\0' ? job->path : "stdin";
+
+            sketch_job_push(job, job->per_record ? reader.name : name);
+            last_record = reader.record_index;
+        }
+
+        sketch_add_sequence(&job->entries[job->count - 1], chunk, length, job->k);
+    }
+
+    for (int i = 0; i < job->count; i++) 
+    {
+        sketch_finish(&job->entries[i]);
+    }
+
+    free(chunk);
+    fasta_reader_close(&reader);
+}
+
+void *sketch_build_worker(void *arg)
+{
+    sketch_worker *worker = arg;
+
+    while (1) 
+    {
+        worker_mutex_lock(worker->lock);
+        int index = *worker->next_job < worker->job_count ? (*worker->next_job)++ : -1;
+        worker_mutex_unlock(worker->lock);
+
+        if (index < 0) 
+        {
+            break;
+        }
+
+        build_sketches_for_file(&worker->jobs[index]);
+    }
+
+    return NULL;
+}
+
+void write_u32(FILE *file, uint32_t value)
+{
+    unsigned char bytes[4];
+
+    for (int i = 0; i < 4; i++) 
+    {
+        bytes[i] = (unsigned char)(value >> (8 * i));
+    }
+
+    fwrite(bytes, 1, 4, file);
+}
+
+void write_u64(FILE *file, uint64_t value)
+{
+    unsigned char bytes[8];
+
+    for (int i = 0; i < 8; i++) 
+    {
+        bytes[i] = (unsigned char)(value >> (8 * i));
+    }
+
+    fwrite(bytes, 1, 8, file);
+}
+
+void write_varint(FILE *file, uint64_t value)
+{
+    while (value >= 0x80) 
+    {
+        fputc((int)(value & 0x7F) | 0x80, file);
+        value >>= 7;
+    }
+
+    fputc((int)value, file);
+}
+
+int read_u32(FILE *file, uint32_t *value)
+{
+    unsigned char bytes[4];
+
+    if (fread(bytes, 1, 4, file) != 4) 
+    {
+        return 0;
+    }
+
+    *value = 0;
+
+    for (int i = 0; i < 4; i++) 
+    {
+        *value |= (uint32_t)bytes[i] << (8 * i);
+    }
+
+    return 1;
+}
+
+int read_u64(FILE *file, uint64_t *value)
+{
+    unsigned char bytes[8];
+
+    if (fread(bytes, 1, 8, file) != 8) 
+    {
+        return 0;
+    }
+
+    *value = 0;
+
+    for (int i = 0; i < 8; i++) 
+    {
+        *value |= (uint64_t)bytes[i] << (8 * i);
+    }
+
+    return 1;
+}
+
+int read_varint(FILE *file, uint64_t *value)
+{
+    int shift = 0;
+    int ch;
+
+    *value = 0;
+
+    while ((ch = fgetc(file)) != EOF) 
+    {
+        *value |= (uint64_t)(ch & 0x7F) << shift;
+
+        if ((ch & 0x80) == 0) 
+        {
+            return 1;
+        }
+
+        shift += 7;
+
+        if (shift > 63) 
+        {
+            return 0;
+        }
+    }
+
+    return 0;
+}
+
+int write_sketch_file(const char *filename, const sketch_set *set)
+{
+    FILE *file = fopen(filename, "wb");
+
+    if (file == NULL) 
+    {
+        log_printf("Error: Could not open sketch file '%s' for writing\n", filename);
+        return 0;
+    }
+
+    fwrite("DNASKT01", 1, 8, file);
+    write_u32(file, (uint32_t)set->k);
+    write_u32(file, (uint32_t)set->size);
+    write_u32(file, (uint32_t)set->count);
+
+    for (int i = 0; i < set->count; i++) 
+    {
+        const minhash_sketch *sketch = &set->entries[i];
+        uint32_t name_len = (uint32_t)strlen(sketch->name);
+        uint64_t previous = 0;
+
+        write_u32(file, name_len);
+        fwrite(sketch->name, 1, name_len, file);
+        write_u64(file, sketch->kmer_total);
+        write_u32(file, (uint32_t)sketch->count);
+
+        for (int h = 0; h < sketch->count; h++) 
+        {
+            write_varint(file, sketch->hashes[h] - previous);
+            previous = sketch->hashes[h];
+        }
+    }
+
+    int ok = !ferror(file);
+
+    fclose(file);
+
+    if (!ok) 
+    {
+        log_printf("Error: Failed to write sketch file '%s'\n", filename);
+    }
+
+    return ok;
+}
+
+void free_sketch_set(sketch_set *set)
+{
+    for (int i = 0; i < set->count; i++) 
+    {
+        free(set->entries[i].hashes);
+    }
+
+    free(set->entries);
+    set->entries = NULL;
+    set->count = 0;
+}
+
+int read_sketch_file(const char *filename, sketch_set *set)
+{
+    memset(set, 0, sizeof(*set));
+
+    FILE *file = fopen(filename, "rb");
+
+    if (file == NULL) 
+    {
+        log_printf("Error: Could not open sketch file '%s'\n", filename);
+        return 0;
+    }
+
+    char magic[8];
+    uint32_t k;
+    uint32_t size;
+    uint32_t count;
+
+    if (fread(magic, 1, 8, file) != 8 || memcmp(magic, "DNASKT01", 8) != 0 ||
+        !read_u32(file, &k) || !read_u32(file, &size) || !read_u32(file, &count)) 
+    {
+        log_printf("Error: '%s' is not a DNAShield sketch file\n", filename);
+        fclose(file);
+        return 0;
+    }
+
+    set->k = (int)k;
+    set->size = (int)size;
+    set->entries = xmalloc(sizeof(minhash_sketch) * (count > 0 ? count : 1));
+
+    for (uint32_t i = 0; i < count; i++) 
+    {
+        minhash_sketch *sketch = &set->entries[i];
+        uint32_t name_len;
+        uint32_t hash_count;
+        int ok = read_u32(file, &name_len) && name_len < MAX_FILENAME_LENGTH;
+
+        memset(sketch, 0, sizeof(*sketch));
+
+        ok = ok && fread(sketch->name, 1, name_len, file) == name_len;
+        ok = ok && read_u64(file, &sketch->kmer_total) && read_u32(file, &hash_count) && hash_count <= size;
+
+        if (!ok) 
+        {
+            log_printf("Error: Sketch file '%s' is truncated or corrupt\n", filename);
+            fclose(file);
+            free_sketch_set(set);
+            return 0;
+        }
+
+        sketch->size = (int)size;
+        sketch->count = (int)hash_count;
+        sketch->capacity = (int)hash_count;
+        sketch->hashes = xmalloc(sizeof(uint64_t) * (hash_count > 0 ? hash_count : 1));
+        set->count++;
+
+        uint64_t previous = 0;
+
+        for (uint32_t h = 0; h < hash_count; h++) 
+        {
+            uint64_t delta;
+
+            if (!read_varint(file, &delta)) 
+            {
+                log_printf("Error: Sketch file '%s' is truncated or corrupt\n", filename);
+                fclose(file);
+                free_sketch_set(set);
+                return 0;
+            }
+
+            previous += delta;
+            sketch->hashes[h] = previous;
+        }
+    }
+
+    fclose(file);
+
+    return 1;
+}
+
+void run_sketch_mode(const options *config)
+{
+    int job_count = config->sketch_input_count;
+    const char *fallback = NULL;
+
+    if (job_count == 0) 
+    {
+        if (config->do_fasta_input == 1) 
+        {
+            fallback = config->fasta_input_file;
+        } 
+        else if (config->file_mode == 1) 
+        {
+            fallback = config->input_file;
+        }
+
+        job_count = 1;
+    }
+
+    sketch_job *jobs = xmalloc(sizeof(sketch_job) * job_count);
+
+    for (int i = 0; i < job_count; i++) 
+    {
+        memset(&jobs[i], 0, sizeof(sketch_job));
+        jobs[i].path = config->sketch_input_count > 0 ? config->sketch_inputs[i] : fallback;
+        jobs[i].k = config->sketch_k;
+        jobs[i].size = config->sketch_size;
+        jobs[i].per_record = config->sketch_per_record;
+    }
+
+    int thread_count = config->thread_count > 0 ? config->thread_count : default_thread_count();
+
+    if (thread_count > job_count) 
+    {
+        thread_count = job_count;
+    }
+
+    worker_mutex lock;
+    worker_mutex_init(&lock);
+
+    sketch_worker *workers = xmalloc(sizeof(sketch_worker) * thread_count);
+    int next_job = 0;
+
+    for (int w = 0; w < thread_count; w++) 
+    {
+        workers[w].jobs = jobs;
+        workers[w].job_count = job_count;
+        workers[w].next_job = &next_job;
+        workers[w].lock = &lock;
+    }
+
+    run_workers(thread_count, sketch_build_worker, workers, sizeof(sketch_worker));
+
+    sketch_set set;
+    memset(&set, 0, sizeof(set));
+    set.k = config->sketch_k;
+    set.size = config->sketch_size;
+
+    int failed = 0;
+
+    for (int i = 0; i < job_count; i++) 
+    {
+        failed += jobs[i].failed;
+
+        for (int e = 0; e < jobs[i].count; e++) 
+        {
+            if (set.count == set.capacity) 
+            {
+                set.capacity = set.capacity == 0 ? 16 : set.capacity * 2;
+                set.entries = xrealloc(set.entries, sizeof(minhash_sketch) * set.capacity);
+            }
+
+            set.entries[set.count++] = jobs[i].entries[e];
+        }
+
+        free(jobs[i].entries);
+    }
+
+    free(workers);
+    free(jobs);
+    worker_mutex_destroy(&lock);
+
+    if (write_sketch_file(config->sketch_output_file, &set)) 
+    {
+        log_printf("\n=== MinHash Sketch ===\n\n");
+        log_printf("K-mer size  : %d\n", set.k);
+        log_printf("Sketch size : %d\n", set.size);
+        log_printf("Sketches    : %d\n", set.count);
+
+        if (failed > 0) 
+        {
+            log_printf("Failed      : %d input(s)\n", failed);
+        }
+
+        log_printf("Output      : %s\n\n", config->sketch_output_file);
+    }
+
+    free_sketch_set(&set);
+}
+
+void *sketch_compare_rows(void *arg)
+{
+    sketch_compare_worker *worker = arg;
+    int columns = worker->references->count;
+
+    while (1) 
+    {
+        worker_mutex_lock(worker->lock);
+        int row = *worker->next_row < worker->row_end ? (*worker->next_row)++ : -1;
+        worker_mutex_unlock(worker->lock);
+
+        if (row < 0) 
+        {
+            break;
+        }
+
+        int offset = (row - worker->row_start) * columns;
+
+        for (int j = 0; j < columns; j++) 
+        {
+            sketch_jaccard(&worker->queries->entries[row], &worker->references->entries[j],
+                           &worker->shared[offset + j], &worker->considered[offset + j]);
+        }
+    }
+
+    return NULL;
+}
+
+void run_compare_sketch_mode(const options *config)
+{
+    sketch_set queries;
+    sketch_set references;
+
+    if (!read_sketch_file(config->compare_sketch_file1, &queries)) 
+    {
+        return;
+    }
+
+    if (!read_sketch_file(config->compare_sketch_file2, &references)) 
+    {
+        free_sketch_set(&queries);
+        return;
+    }
+
+    if (queries.k != references.k) 
+    {
+        log_printf("Error: Sketches use different k-mer sizes (%d vs %d).\n", queries.k, references.k);
+        free_sketch_set(&queries);
+        free_sketch_set(&references);
+        return;
+    }
+
+    int thread_count = config->thread_count > 0 ? config->thread_count : default_thread_count();
+    int block_rows = 64;
+    int columns = references.count;
+    int *shared = xmalloc(sizeof(int) * block_rows * (columns > 0 ? columns : 1));
+    int *considered = xmalloc(sizeof(int) * block_rows * (columns > 0 ? columns : 1));
+    sketch_compare_worker *workers = xmalloc(sizeof(sketch_compare_worker) * thread_count);
+    worker_mutex lock;
+
+    worker_mutex_init(&lock);
+
+    log_printf("\n=== Sketch Comparison ===\n\n");
+    log_printf("query\treference\tjaccard\tdistance\tani\tshared\n");
+
+    for (int start = 0; start < queries.count; start += block_rows) 
+    {
+        int end = start + block_rows < queries.count ? start + block_rows : queries.count;
+        int next_row = start;
+
+        for (int w = 0; w < thread_count; w++) 
+        {
+            workers[w].queries = &queries;
+            workers[w].references = &references;
+            workers[w].row_start = start;
+            workers[w].row_end = end;
+            workers[w].next_row = &next_row;
+            workers[w].lock = &lock;
+            workers[w].shared = shared;
+            workers[w].considered = considered;
+        }
+
+        run_workers(thread_count, sketch_compare_rows, workers, sizeof(sketch_compare_worker));
+
+        for (int i = start; i < end; i++) 
+        {
+            for (int j = 0; j < columns; j++) 
+            {
+                int index = (i - start) * columns + j;
+                double jaccard = considered[index] > 0 ? (double)shared[index] / considered[index] : 0.0;
+                double distance = mash_distance(jaccard, queries.k);
+
+                log_printf("%s\t%s\t%.6f\t%.6f\t%.4f\t%d/%d\n", queries.entries[i].name, references.entries[j].name,
+                           jaccard, distance, 100.0 * (1.0 - distance), shared[index], considered[index]);
+            }
+        }
+    }
+
+    log_printf("\n");
+
+    worker_mutex_destroy(&lock);
+    free(workers);
+    free(shared);
+    free(considered);
+    free_sketch_set(&queries);
+    free_sketch_set(&references);
+}
+
+typedef struct {
+    int match;
+    int mismatch;
+    int gap_open;
+    int gap_extend;
+} align_scoring;
+
+typedef struct {
+    char *ops;
+    int64_t length;
+    int64_t capacity;
+} align_path;
+
+typedef struct {
+    const align_scoring *scoring;
+    int *cc;
+    int *dd;
+    int *rr;
+    int *ss;
+    align_path *path;
+} myers_miller_context;
+
+typedef struct {
+    int score;
+    int a_start;
+    int a_end;
+    int b_start;
+    int b_end;
+} align_result;
+
+void align_path_push(align_path *path, char op, int count)
+{
+    if (path->length + count > path->capacity) 
+    {
+        path->capacity = (path->length + count) * 2 + 64;
+        path->ops = xrealloc(path->ops, (size_t)path->capacity);
+    }
+
+    memset(path->ops + path->length, op, count);
+    path->length += count;
+}
+
+int align_substitution(char a, char b, const align_scoring *scoring)
+{
+    if (a == b && a != 'N') 
+    {
+        return scoring->match;
+    }
+
+    return -scoring->mismatch;
+}
+
+int align_gap_cost(int length, const align_scoring *scoring)
+{
+    if (length <= 0) 
+    {
+        return 0;
+    }
+
+    return scoring->gap_open + scoring->gap_extend * length;
+}
+
+int myers_miller_diff(myers_miller_context *ctx, const char *a, const char *b, int m, int n, int tb, int te)
+{
+    const align_scoring *scoring = ctx->scoring;
+    int g = scoring->gap_open;
+    int h = scoring->gap_extend;
+    int *cc = ctx->cc;
+    int *dd = ctx->dd;
+    int *rr = ctx->rr;
+    int *ss = ctx->ss;
+
+    if (n <= 0) 
+    {
+        if (m > 0) 
+        {
+            align_path_push(ctx->path, 'D', m);
+        }
+
+        return align_gap_cost(m, scoring);
+    }
+
+    if (m <= 1) 
+    {
+        if (m <= 0) 
+        {
+            align_path_push(ctx->path, 'I', n);
+            return align_gap_cost(n, scoring);
+        }
+
+        int delete_first = tb <= te;
+
+        if (tb > te) 
+        {
+            tb = te;
+        }
+
+        int midc = (tb + h) + align_gap_cost(n, scoring);
+        int midj = 0;
+
+        for (int j = 1; j <= n; j++) 
+        {
+            int c = align_gap_cost(j - 1, scoring) - align_substitution(a[0], b[j - 1], scoring) + align_gap_cost(n - j, scoring);
+
+            if (c < midc) 
+            {
+                midc = c;
+                midj = j;
+            }
+        }
+
+        if (midj == 0) 
+        {
+            if (delete_first) 
+            {
+                align_path_push(ctx->path, 'D', 1);
+                align_path_push(ctx->path, 'I', n);
+            } 
+            else 
+            {
+                align_path_push(ctx->path, 'I', n);
+                align_path_push(ctx->path, 'D', 1);
+            }
+        } 
+        else 
+        {
+            if (midj > 1) 
+            {
+                align_path_push(ctx->path, 'I', midj - 1);
+            }
+
+            align_path_push(ctx->path, 'M', 1);
+
+            if (midj < n) 
+            {
+                align_path_push(ctx->path, 'I', n - midj);
+            }
+        }
+
+        return midc;
+    }
+
+    int imid = m / 2;
+    int t = g;
+    int s;
+    int c;
+    int e;
+    int d;
+
+    cc[0] = 0;
+
+    for (int j = 1; j <= n; j++) 
+    {
+        t += h;
+        cc[j] = t;
+        dd[j] = t + g;
+    }
+
+    t = tb;
+
+    for (int i = 1; i <= imid; i++) 
+    {
+        s = cc[0];
+        t += h;
+        c = t;
+        cc[0] = c;
+        e = t + g;
+
+        for (int j = 1; j <= n; j++) 
+        {
+            if (c + g + h < e + h) 
+            {
+                e = c + g + h;
+            } 
+            else 
+            {
+                e = e + h;
+            }
+
+            if (cc[j] + g + h < dd[j] + h) 
+            {
+                d = cc[j] + g + h;
+            } 
+            else 
+            {
+                d = dd[j] + h;
+            }
+
+            c = s - align_substitution(a[i - 1], b[j - 1], scoring);
+
+            if (e < c) 
+            {
+                c = e;
+            }
+
+            if (d < c) 
+            {
+                c = d;
+            }
+
+            s = cc[j];
+            cc[j] = c;
+            dd[j] = d;
+        }
+    }
+
+    dd[0] = cc[0];
+    rr[n] = 0;
+    t = g;
+
+    for (int j = n - 1; j >= 0; j--) 
+    {
+        t += h;
+        rr[j] = t;
+        ss[j] = t + g;
+    }
+
+    t = te;
+
+    for (int i = m - 1; i >= imid; i--) 
+    {
+        s = rr[n];
+        t += h;
+        c = t;
+        rr[n] = c;
+        e = t + g;
+
+        for (int j = n - 1; j >= 0; j--) 
+        {
+            if (c + g + h < e + h) 
+            {
+                e = c + g + h;
+            } 
+            else 
+            {
+                e = e + h;
+            }
+
+            if (rr[j] + g + h < ss[j] + h) 
+            {
+                d = rr[j] + g + h;
+            } 
+            else 
+            {
+                d = ss[j] + h;
+            }
+
+            c = s - align_substitution(a[i], b[j], scoring);
+
+            if (e < c) 
+            {
+                c = e;
+            }
+
+            if (d < c) 
+            {
+                c = d;
+            }
+
+            s = rr[j];
+            rr[j] = c;
+            ss[j] = d;
+        }
+    }
+
+    ss[n] = rr[n];
+
+    int midc = cc[0] + rr[0];
+    int midj = 0;
+    int type = 1;
+
+    for (int j = 0; j <= n; j++) 
+    {
+        c = cc[j] + rr[j];
+
+        if (c <= midc) 
+        {
+            if (c < midc || (cc[j] != dd[j] && rr[j] == ss[j])) 
+            {
+                midc = c;
+                midj = j;
+            }
+        }
+    }
+
+    for (int j = n; j >= 0; j--) 
+    {
+        c = dd[j] + ss[j] - g;
+
+        if (c < midc) 
+        {
+            midc = c;
+            midj = j;
+            type = 2;
+        }
+    }
+
+    if (type == 1) 
+    {
+        myers_miller_diff(ctx, a, b, imid, midj, tb, g);
+        myers_miller_diff(ctx, a + imid, b + midj, m - imid, n - midj, g, te);
+    } 
+    else 
+    {
+        myers_miller_diff(ctx, a, b, imid - 1, midj, tb, 0);
+        align_path_push(ctx->path, 'D', 2);
+        myers_miller_diff(ctx, a + imid + 1, b + midj, m - imid - 1, n - midj, 0, te);
+    }
+
+    return midc;
+}
+
+int align_path_score(const align_path *path, const char *a, const char *b, const align_scoring *scoring)
+{
+    int score = 0;
+    int i = 0;
+    int j = 0;
+    char previous = 'M';
+
+    for (int64_t k = 0; k < path->length; k++) 
+    {
+        char op = path->ops[k];
+
+        if (op == 'M') 
+        {
+            score += align_substitution(a[i++], b[j++], scoring);
+        } 
+        else 
+        {
+            if (op != previous) 
+            {
+                score -= scoring->gap_open;
+            }
+
+            score -= scoring->gap_extend;
+
+            if (op == 'D') 
+            {
+                i++;
+            } 
+            else 
+            {
+                j++;
+            }
+        }
+
+        previous = op;
+    }
+
+    return score;
+}
+
+void align_global_linear(const char *a, int m, const char *b, int n, const align_scoring *scoring, align_path *path)
+{
+    myers_miller_context ctx;
+
+    ctx.scoring = scoring;
+    ctx.cc = xmalloc(sizeof(int) * (n + 1));
+    ctx.dd = xmalloc(sizeof(int) * (n + 1));
+    ctx.rr = xmalloc(sizeof(int) * (n + 1));
+    ctx.ss = xmalloc(sizeof(int) * (n + 1));
+    ctx.path = path;
+
+    myers_miller_diff(&ctx, a, b, m, n, scoring->gap_open, scoring->gap_open);
+
+    free(ctx.cc);
+    free(ctx.dd);
+    free(ctx.rr);
+    free(ctx.ss);
+}
+
+#define ALIGN_NEG_INF (-(1 << 29))
+#define TRACE_DIAG 0
+#define TRACE_E 1
+#define TRACE_F 2
+#define TRACE_START 3
+#define TRACE_E_EXTEND 4
+#define TRACE_F_EXTEND 8
+
+int align_banded(const char *a, int m, const char *b, int n, const align_scoring *scoring, int band, int local,
+                 align_path *path, align_result *result)
+{
+    int lo = (n - m < 0 ? n - m : 0) - band;
+    int hi = (n - m > 0 ? n - m : 0) + band;
+    int width = hi - lo + 1;
+    int open = scoring->gap_open + scoring->gap_extend;
+    int extend = scoring->gap_extend;
+    unsigned char *trace = xmalloc((size_t)(m + 1) * width);
+    int *h_row = xmalloc(sizeof(int) * (n + 2));
+    int *f_row = xmalloc(sizeof(int) * (n + 2));
+    int best = local ? 0 : ALIGN_NEG_INF;
+    int best_i = 0;
+    int best_j = 0;
+
+    for (int j = 0; j <= n; j++) 
+    {
+        h_row[j] = ALIGN_NEG_INF;
+        f_row[j] = ALIGN_NEG_INF;
+    }
+
+    for (int i = 0; i <= m; i++) 
+    {
+        int j_lo = i + lo < 0 ? 0 : i + lo;
+        int j_hi = i + hi > n ? n : i + hi;
+        int diag = ALIGN_NEG_INF;
+        int e = ALIGN_NEG_INF;
+        int left = ALIGN_NEG_INF;
+
+        if (j_lo > 0) 
+        {
+            diag = h_row[j_lo - 1];
+            h_row[j_lo - 1] = ALIGN_NEG_INF;
+        }
+
+        for (int j = j_lo; j <= j_hi; j++) 
+        {
+            unsigned char *cell = &trace[(size_t)i * width + (j - i - lo)];
+            int up = h_row[j];
+            int h;
+
+            if (i == 0 && j == 0) 
+            {
+                h = 0;
+                *cell = TRACE_START;
+                diag = up;
+                h_row[j] = h;
+                f_row[j] = ALIGN_NEG_INF;
+                left = h;
+                continue;
+            }
+
+            *cell = 0;
+
+            if (left - open >= e - extend) 
+            {
+                e = left - open;
+            } 
+            else 
+            {
+                e = e - extend;
+                *cell |= TRACE_E_EXTEND;
+            }
+
+            int f;
+
+            if (up - open >= f_row[j] - extend) 
+            {
+                f = up - open;
+            } 
+            else 
+            {
+                f = f_row[j] - extend;
+                *cell |= TRACE_F_EXTEND;
+            }
+
+            if (i > 0 && j > 0) 
+            {
+                h = diag + align_substitution(a[i - 1], b[j - 1], scoring);
+                *cell |= TRACE_DIAG;
+            } 
+            else 
+            {
+                h = ALIGN_NEG_INF;
+                *cell |= (i == 0) ? TRACE_E : TRACE_F;
+            }
+
+            if (e > h) 
+            {
+                h = e;
+                *cell = (*cell & ~3) | TRACE_E;
+            }
+
+            if (f > h) 
+            {
+                h = f;
+                *cell = (*cell & ~3) | TRACE_F;
+            }
+
+            if (local && h <= 0) 
+            {
+                h = 0;
+                *cell = (*cell & ~3) | TRACE_START;
+            }
+
+            if (h < ALIGN_NEG_INF) 
+            {
+                h = ALIGN_NEG_INF;
+            }
+
+            if (e < ALIGN_NEG_INF) 
+            {
+                e = ALIGN_NEG_INF;
+            }
+
+            if (f < ALIGN_NEG_INF) 
+            {
+                f = ALIGN_NEG_INF;
+            }
+
+            if (local && h > best) 
+            {
+                best = h;
+                best_i = i;
+                best_j = j;
+            }
+
+            diag = up;
+            h_row[j] = h;
+            f_row[j] = f;
+            left = h;
+        }
+
+        if (j_hi + 1 <= n) 
+        {
+            h_row[j_hi + 1] = ALIGN_NEG_INF;
+            f_row[j_hi + 1] = ALIGN_NEG_INF;
+        }
+    }
+
+    if (!local) 
+    {
+        best = h_row[n];
+        best_i = m;
+        best_j = n;
+    }
+
+    int i = best_i;
+    int j = best_j;
+    int state = TRACE_DIAG;
+
+    while (i > 0 || j > 0) 
+    {
+        unsigned char cell = trace[(size_t)i * width + (j - i - lo)];
+
+        if (state == TRACE_DIAG) 
+        {
+            int source = cell & 3;
+
+            if (source == TRACE_START) 
+            {
+                break;
+            }
+
+            if (source == TRACE_DIAG) 
+            {
+                align_path_push(path, 'M', 1);
+                i--;
+                j--;
+                continue;
+            }
+
+            state = source;
+        }
+
+        if (state == TRACE_E) 
+        {
+            align_path_push(path, 'I', 1);
+            state = (cell & TRACE_E_EXTEND) ? TRACE_E : TRACE_DIAG;
+            j--;
+        } 
+        else 
+        {
+            align_path_push(path, 'D', 1);
+            state = (cell & TRACE_F_EXTEND) ? TRACE_F : TRACE_DIAG;
+            i--;
+        }
+    }
+
+    for (int64_t k = 0; k < path->length / 2; k++) 
+    {
+        char temp = path->ops[k];
+        path->ops[k] = path->ops[path->length - 1 - k];
+        path->ops[path->length - 1 - k] = temp;
+    }
+
+    result->score = best;
+    result->a_start = i;
+    result->a_end = best_i;
+    result->b_start = j;
+    result->b_end = best_j;
+
+    free(trace);
+    free(h_row);
+    free(f_row);
+
+    return best;
+}
+
+int local_score_scalar(const char *a, int m, const char *b, int n, const align_scoring *scoring, int *a_end, int *b_end)
+{
+    int open = scoring->gap_open + scoring->gap_extend;
+    int extend = scoring->gap_extend;
+    int *h_row = xmalloc(sizeof(int) * (n + 1));
+    int *e_row = xmalloc(sizeof(int) * (n + 1));
+    int best = 0;
+
+    *a_end = 0;
+    *b_end = 0;
+
+    for (int j = 0; j <= n; j++) 
+    {
+        h_row[j] = 0;
+        e_row[j] = ALIGN_NEG_INF;
+    }
+
+    for (int i = 1; i <= m; i++) 
+    {
+        int diag = 0;
+        int f = ALIGN_NEG_INF;
+        int left = 0;
+
+        for (int j = 1; j <= n; j++) 
+        {
+            int up = h_row[j];
+            int e = e_row[j] - extend > up - open ? e_row[j] - extend : up - open;
+
+            f = f - extend > left - open ? f - extend : left - open;
+
+            int h = diag + align_substitution(a[i - 1], b[j - 1], scoring);
+
+            if (e > h) 
+            {
+                h = e;
+            }
+
+            if (f > h) 
+            {
+                h = f;
+            }
+
+            if (h < 0) 
+            {
+                h = 0;
+            }
+
+            if (h > best) 
+            {
+                best = h;
+                *a_end = i;
+                *b_end = j;
+            }
+
+            diag = up;
+            h_row[j] = h;
+            e_row[j] = e;
+            left = h;
+        }
+    }
+
+    free(h_row);
+    free(e_row);
+
+    return best;
+}
+
+#if defined(__SSE2__)
+int horizontal_max_epi16(__m128i value)
+{
+    value = _mm_max_epi16(value, _mm_srli_si128(value, 8));
+    value = _mm_max_epi16(value, _mm_srli_si128(value, 4));
+    value = _mm_max_epi16(value, _mm_srli_si128(value, 2));
+
+    return (int16_t)_mm_extract_epi16(value, 0);
+}
+
+int local_score_striped(const char *a, int m, const char *b, int n, const align_scoring *scoring, int *a_end, int *b_end)
+{
+    int seg_len = (n + 7) / 8;
+    __m128i *profile = _mm_malloc(sizeof(__m128i) * seg_len * 5, 16);
+    __m128i *h_store = _mm_malloc(sizeof(__m128i) * seg_len, 16);
+    __m128i *h_load = _mm_malloc(sizeof(__m128i) * seg_len, 16);
+    __m128i *e_store = _mm_malloc(sizeof(__m128i) * seg_len, 16);
+    __m128i *best_row = _mm_malloc(sizeof(__m128i) * seg_len, 16);
+    __m128i gap_open = _mm_set1_epi16((short)(scoring->gap_open + scoring->gap_extend));
+    __m128i gap_extend = _mm_set1_epi16((short)scoring->gap_extend);
+    __m128i zero = _mm_setzero_si128();
+    int limit = 32767 - scoring->match;
+    int best = 0;
+
+    *a_end = 0;
+    *b_end = 0;
+
+    for (int code = 0; code < 5; code++) 
+    {
+        int16_t *row = (int16_t *)(profile + code * seg_len);
+
+        for (int seg = 0; seg < seg_len; seg++) 
+        {
+            for (int lane = 0; lane < 8; lane++) 
+            {
+                int pos = lane * seg_len + seg;
+                int score = -scoring->mismatch;
+
+                if (pos < n && code < 4 && base_code(b[pos]) == code) 
+                {
+                    score = scoring->match;
+                }
+
+                row[seg * 8 + lane] = (int16_t)score;
+            }
+        }
+    }
+
+    for (int seg = 0; seg < seg_len; seg++) 
+    {
+        h_store[seg] = zero;
+        h_load[seg] = zero;
+        e_store[seg] = zero;
+    }
+
+    for (int i = 0; i < m; i++) 
+    {
+        int code = base_code(a[i]);
+        const __m128i *vp = profile + (code < 0 ? 4 : code) * seg_len;
+        __m128i vf = zero;
+        __m128i vmax = zero;
+        __m128i vh = _mm_slli_si128(h_store[seg_len - 1], 2);
+        __m128i *swap = h_load;
+
+        h_load = h_store;
+        h_store = swap;
+
+        for (int seg = 0; seg < seg_len; seg++) 
+        {
+            vh = _mm_adds_epi16(vh, vp[seg]);
+
+            __m128i ve = e_store[seg];
+
+            vh = _mm_max_epi16(vh, ve);
+            vh = _mm_max_epi16(vh, vf);
+            vh = _mm_max_epi16(vh, zero);
+            vmax = _mm_max_epi16(vmax, vh);
+            h_store[seg] = vh;
+
+            vh = _mm_subs_epi16(vh, gap_open);
+            ve = _mm_max_epi16(_mm_subs_epi16(ve, gap_extend), vh);
+            e_store[seg] = ve;
+            vf = _mm_max_epi16(_mm_subs_epi16(vf, gap_extend), vh);
+            vh = h_load[seg];
+        }
+
+        vf = _mm_slli_si128(vf, 2);
+        int seg = 0;
+
+        while (_mm_movemask_epi8(_mm_cmpgt_epi16(vf, _mm_max_epi16(_mm_subs_epi16(h_store[seg], gap_open), zero))) != 0) 
+        {
+            vh = _mm_max_epi16(h_store[seg], vf);
+            h_store[seg] = vh;
+            vmax = _mm_max_epi16(vmax, vh);
+            e_store[seg] = _mm_max_epi16(e_store[seg], _mm_subs_epi16(vh, gap_open));
+            vf = _mm_subs_epi16(vf, gap_extend);
+
+            if (++seg >= seg_len) 
+            {
+                seg = 0;
+                vf = _mm_slli_si128(vf, 2);
+            }
+        }
+
+        int column_max = horizontal_max_epi16(vmax);
+
+        if (column_max > best) 
+        {
+            best = column_max;
+            *a_end = i + 1;
+            memcpy(best_row, h_store, sizeof(__m128i) * seg_len);
+        }
+
+        if (best >= limit) 
+        {
+            best = -1;
+            break;
+        }
+    }
+
+    if (best > 0) 
+    {
+        const int16_t *values = (const int16_t *)best_row;
+        int first = n;
+
+        for (int s = 0; s < seg_len; s++) 
+        {
+            for (int lane = 0; lane < 8; lane++) 
+            {
+                int pos = lane * seg_len + s;
+
+                if (pos < first && values[s * 8 + lane] == best) 
+                {
+                    first = pos;
+                }
+            }
+        }
+
+        *b_end = first + 1;
+    }
+
+    _mm_free(profile);
+    _mm_free(h_store);
+    _mm_free(h_load);
+    _mm_free(e_store);
+    _mm_free(best_row);
+
+    return best;
+}
+
+__m128i max_epi32(__m128i a, __m128i b)
+{
+    __m128i greater = _mm_cmpgt_epi32(a, b);
+
+    return _mm_or_si128(_mm_and_si128(greater, a), _mm_andnot_si128(greater, b));
+}
+
+int horizontal_max_epi32(__m128i value)
+{
+    value = max_epi32(value, _mm_srli_si128(value, 8));
+    value = max_epi32(value, _mm_srli_si128(value, 4));
+
+    return _mm_cvtsi128_si32(value);
+}
+
+int local_score_striped32(const char *a, int m, const char *b, int n, const align_scoring *scoring, int *a_end, int *b_end)
+{
+    int seg_len = (n + 3) / 4;
+    __m128i *profile = _mm_malloc(sizeof(__m128i) * seg_len * 5, 16);
+    __m128i *h_store = _mm_malloc(sizeof(__m128i) * seg_len, 16);
+    __m128i *h_load = _mm_malloc(sizeof(__m128i) * seg_len, 16);
+    __m128i *e_store = _mm_malloc(sizeof(__m128i) * seg_len, 16);
+    __m128i *best_row = _mm_malloc(sizeof(__m128i) * seg_len, 16);
+    __m128i gap_open = _mm_set1_epi32(scoring->gap_open + scoring->gap_extend);
+    __m128i gap_extend = _mm_set1_epi32(scoring->gap_extend);
+    __m128i zero = _mm_setzero_si128();
+    int best = 0;
+
+    *a_end = 0;
+    *b_end = 0;
+
+    for (int code = 0; code < 5; code++) 
+    {
+        int32_t *row = (int32_t *)(profile + code * seg_len);
+
+        for (int seg = 0; seg < seg_len; seg++) 
+        {
+            for (int lane = 0; lane < 4; lane++) 
+            {
+                int pos = lane * seg_len + seg;
+                int score = -scoring->mismatch;
+
+                if (pos < n && code < 4 && base_code(b[pos]) == code) 
+                {
+                    score = scoring->match;
+                }
+
+                row[seg * 4 + lane] = score;
+            }
+        }
+    }
+
+    for (int seg = 0; seg < seg_len; seg++) 
+    {
+        h_store[seg] = zero;
+        h_load[seg] = zero;
+        e_store[seg] = zero;
+    }
+
+    for (int i = 0; i < m; i++) 
+    {
+        int code = base_code(a[i]);
+        const __m128i *vp = profile + (code < 0 ? 4 : code) * seg_len;
+        __m128i vf = zero;
+        __m128i vmax = zero;
+        __m128i vh = _mm_slli_si128(h_store[seg_len - 1], 4);
+        __m128i *swap = h_load;
+
+        h_load = h_store;
+        h_store = swap;
+
+        for (int seg = 0; seg < seg_len; seg++) 
+        {
+            vh = _mm_add_epi32(vh, vp[seg]);
+
+            __m128i ve = e_store[seg];
+
+            vh = max_epi32(vh, ve);
+            vh = max_epi32(vh, vf);
+            vh = max_epi32(vh, zero);
+            vmax = max_epi32(vmax, vh);
+            h_store[seg] = vh;
+
+            vh = _mm_sub_epi32(vh, gap_open);
+            ve = max_epi32(_mm_sub_epi32(ve, gap_extend), vh);
+            e_store[seg] = ve;
+            vf = max_epi32(_mm_sub_epi32(vf, gap_extend), vh);
+            vh = h_load[seg];
+        }
+
+        vf = _mm_slli_si128(vf, 4);
+        int seg = 0;
+
+        while (_mm_movemask_epi8(_mm_cmpgt_epi32(vf, max_epi32(_mm_sub_epi32(h_store[seg], gap_open), zero))) != 0) 
+        {
+            vh = max_epi32(h_store[seg], vf);
+            h_store[seg] = vh;
+            vmax = max_epi32(vmax, vh);
+            e_store[seg] = max_epi32(e_store[seg], _mm_sub_epi32(vh, gap_open));
+            vf = _mm_sub_epi32(vf, gap_extend);
+
+            if (++seg >= seg_len) 
+            {
+                seg = 0;
+                vf = _mm_slli_si128(vf, 4);
+            }
+        }
+
+        int column_max = horizontal_max_epi32(vmax);
+
+        if (column_max > best) 
+        {
+            best = column_max;
+            *a_end = i + 1;
+            memcpy(best_row, h_store, sizeof(__m128i) * seg_len);
+        }
+    }
+
+    if (best > 0) 
+    {
+        const int32_t *values = (const int32_t *)best_row;
+        int first = n;
+
+        for (int s = 0; s < seg_len; s++) 
+        {
+            for (int lane = 0; lane < 4; lane++) 
+            {
+                int pos = lane * seg_len + s;
+
+                if (pos < first && values[s * 4 + lane] == best) 
+                {
+                    first = pos;
+                }
+            }
+        }
+
+        *b_end = first + 1;
+    }
+
+    _mm_free(profile);
+    _mm_free(h_store);
+    _mm_free(h_load);
+    _mm_free(e_store);
+    _mm_free(best_row);
+
+    return best;
+}
+
+void local_start_striped32(const char *a, const char *b, int a_end, int b_end, const align_scoring *scoring, int best,
+                           int *a_start, int *b_start)
+{
+    int n = b_end;
+    int seg_len = (n + 3) / 4;
+    int open = scoring->gap_open + scoring->gap_extend;
+    int extend = scoring->gap_extend;
+    __m128i *profile = _mm_malloc(sizeof(__m128i) * seg_len * 5, 16);
+    __m128i *h_store = _mm_malloc(sizeof(__m128i) * seg_len, 16);
+    __m128i *h_load = _mm_malloc(sizeof(__m128i) * seg_len, 16);
+    __m128i *e_store = _mm_malloc(sizeof(__m128i) * seg_len, 16);
+    __m128i gap_open = _mm_set1_epi32(open);
+    __m128i gap_extend = _mm_set1_epi32(extend);
+    __m128i neg_lane = _mm_cvtsi32_si128(ALIGN_NEG_INF);
+
+    *a_start = a_end - 1;
+    *b_start = b_end - 1;
+
+    for (int code = 0; code < 5; code++) 
+    {
+        int32_t *row = (int32_t *)(profile + code * seg_len);
+
+        for (int seg = 0; seg < seg_len; seg++) 
+        {
+            for (int lane = 0; lane < 4; lane++) 
+            {
+                int pos = lane * seg_len + seg;
+                int score = -scoring->mismatch;
+
+                if (pos < n && code < 4 && base_code(b[b_end - 1 - pos]) == code) 
+                {
+                    score = scoring->match;
+                }
+
+                row[seg * 4 + lane] = score;
+            }
+        }
+    }
+
+    for (int seg = 0; seg < seg_len; seg++) 
+    {
+        int32_t *values = (int32_t *)(h_store + seg);
+
+        for (int lane = 0; lane < 4; lane++) 
+        {
+            values[lane] = -(open + extend * (lane * seg_len + seg));
+        }
+
+        e_store[seg] = _mm_sub_epi32(h_store[seg], gap_open);
+    }
+
+    for (int i = 1; i <= a_end; i++) 
+    {
+        int code = base_code(a[a_end - i]);
+        const __m128i *vp = profile + (code < 0 ? 4 : code) * seg_len;
+        int diag = i == 1 ? 0 : -(open + extend * (i - 2));
+        __m128i vf = _mm_set_epi32(ALIGN_NEG_INF, ALIGN_NEG_INF, ALIGN_NEG_INF, -(open + extend * (i - 1)) - open);
+        __m128i vh = _mm_or_si128(_mm_slli_si128(h_store[seg_len - 1], 4), _mm_cvtsi32_si128(diag));
+        __m128i vmax = _mm_set1_epi32(ALIGN_NEG_INF);
+        __m128i *swap = h_load;
+
+        h_load = h_store;
+        h_store = swap;
+
+        for (int seg = 0; seg < seg_len; seg++) 
+        {
+            vh = _mm_add_epi32(vh, vp[seg]);
+
+            __m128i ve = e_store[seg];
+
+            vh = max_epi32(vh, ve);
+            vh = max_epi32(vh, vf);
+            vmax = max_epi32(vmax, vh);
+            h_store[seg] = vh;
+
+            vh = _mm_sub_epi32(vh, gap_open);
+            ve = max_epi32(_mm_sub_epi32(ve, gap_extend), vh);
+            e_store[seg] = ve;
+            vf = max_epi32(_mm_sub_epi32(vf, gap_extend), vh);
+            vh = h_load[seg];
+        }
+
+        vf = _mm_or_si128(_mm_slli_si128(vf, 4), neg_lane);
+        int seg = 0;
+
+        while (_mm_movemask_epi8(_mm_cmpgt_epi32(vf, _mm_sub_epi32(h_store[seg], gap_open))) != 0) 
+        {
+            vh = max_epi32(h_store[seg], vf);
+            h_store[seg] = vh;
+            vmax = max_epi32(vmax, vh);
+            e_store[seg] = max_epi32(e_store[seg], _mm_sub_epi32(vh, gap_open));
+            vf = _mm_sub_epi32(vf, gap_extend);
+
+            if (++seg >= seg_len) 
+            {
+                seg = 0;
+                vf = _mm_or_si128(_mm_slli_si128(vf, 4), neg_lane);
+            }
+        }
+
+        if (horizontal_max_epi32(vmax) < best) 
+        {
+            continue;
+        }
+
+        const int32_t *values = (const int32_t *)h_store;
+        int first = n;
+
+        for (int s = 0; s < seg_len; s++) 
+        {
+            for (int lane = 0; lane < 4; lane++) 
+            {
+                int pos = lane * seg_len + s;
+
+                if (pos < first && values[s * 4 + lane] == best) 
+                {
+                    first = pos;
+                }
+            }
+        }
+
+        if (first < n) 
+        {
+            *a_start = a_end - i;
+            *b_start = b_end - 1 - first;
+            break;
+        }
+    }
+
+    _mm_free(profile);
+    _mm_free(h_store);
+    _mm_free(h_load);
+    _mm_free(e_store);
+}
+#endif
+
+void local_start_scan(const char *a, const char *b, int a_end, int b_end, const align_scoring *scoring, int best,
+                      int *a_start, int *b_start)
+{
+    int open = scoring->gap_open + scoring->gap_extend;
+    int extend = scoring->gap_extend;
+    int *h_row = xmalloc(sizeof(int) * (b_end + 1));
+    int *e_row = xmalloc(sizeof(int) * (b_end + 1));
+
+    *a_start = a_end - 1;
+    *b_start = b_end - 1;
+
+    h_row[0] = 0;
+    e_row[0] = ALIGN_NEG_INF;
+
+    for (int j = 1; j <= b_end; j++) 
+    {
+        h_row[j] = -(open + extend * (j - 1));
+        e_row[j] = ALIGN_NEG_INF;
+    }
+
+    for (int i = 1; i <= a_end; i++) 
+    {
+        int diag = h_row[0];
+        int f = ALIGN_NEG_INF;
+        int found = 0;
+
+        h_row[0] = -(open + extend * (i - 1));
+
+        int left = h_row[0];
+
+        for (int j = 1; j <= b_end; j++) 
+        {
+            int up = h_row[j];
+            int e = e_row[j] - extend > up - open ? e_row[j] - extend : up - open;
+
+            f = f - extend > left - open ? f - extend : left - open;
+
+            int h = diag + align_substitution(a[a_end - i], b[b_end - j], scoring);
+
+            if (e > h) 
+            {
+                h = e;
+            }
+
+            if (f > h) 
+            {
+                h = f;
+            }
+
+            if (h < ALIGN_NEG_INF) 
+            {
+                h = ALIGN_NEG_INF;
+            }
+
+            if (h == best && !found) 
+            {
+                *a_start = a_end - i;
+                *b_start = b_end - j;
+                found = 1;
+            }
+
+            diag = up;
+            h_row[j] = h;
+            e_row[j] = e < ALIGN_NEG_INF ? ALIGN_NEG_INF : e;
+            left = h;
+        }
+
+        if (found) 
+        {
+            break;
+        }
+    }
+
+    free(h_row);
+    free(e_row);
+}
+
+void align_print_cigar(const align_path *path)
+{
+    int64_t k = 0;
+
+    while (k < path->length) 
+    {
+        char op = path->ops[k];
+        int64_t run = 0;
+
+        while (k < path->length && path->ops[k] == op) 
+        {
+            run++;
+            k++;
+        }
+
+        log_printf("%lld%c", (long long)run, op);
+    }
+
+    log_printf("\n");
+}
+
+void align_print_view(const align_path *path, const char *a, const char *b, const align_result *result)
+{
+    int i = result->a_start;
+    int j = result->b_start;
+    char line_a[61];
+    char line_m[61];
+    char line_b[61];
+    int column = 0;
+
+    log_printf("\n");
+
+    for (int64_t k = 0; k <= path->length; k++) 
+    {
+        if (column == 60 || (k == path->length && column > 0)) 
+        {
+            line_a[column] = '\0';
+            line_m[column] = '\0';
+            line_b[column] = '\0';
+            log_printf("Seq1: %s\n      %s\nSeq2: %s\n\n", line_a, line_m, line_b);
+            column = 0;
+        }
+
+        if (k == path->length) 
+        {
+            break;
+        }
+
+        char op = path->ops[k];
+        char x = op == 'I' ? '-' : a[i++];
+        char y = op == 'D' ? '-' : b[j++];
+
+        line_a[column] = x;
+        line_b[column] = y;
+        line_m[column] = (op == 'M' && x == y) ? '|' : ' ';
+        column++;
+    }
+}
+
+void run_alignment(const char *a, int m, const char *b, int n, const options *config)
+{
+    align_scoring scoring;
+    align_path path;
+    align_result result;
+    const char *method;
+
+    scoring.match = config->align_match;
+    scoring.mismatch = config->align_mismatch;
+    scoring.gap_open = config->align_gap_open;
+    scoring.gap_extend = config->align_gap_extend;
+
+    memset(&path, 0, sizeof(path));
+    memset(&result, 0, sizeof(result));
+
+    if (config->align_band > 0) 
+    {
+        align_banded(a, m, b, n, &scoring, config->align_band, config->align_local, &path, &result);
+        method = config->align_local ? "local, banded (Gotoh)" : "global, banded (Gotoh)";
+    } 
+    else if (!config->align_local) 
+    {
+        align_global_linear(a, m, b, n, &scoring, &path);
+        result.a_end = m;
+        result.b_end = n;
+        method = "global, linear space (Myers-Miller)";
+    } 
+    else 
+    {
+        int best = -1;
+        int a_end = 0;
+        int b_end = 0;
+
+        method = "local, scalar (Smith-Waterman)";
+
+#if defined(__SSE2__)
+        if (n > 0) 
+        {
+            best = local_score_striped(a, m, b, n, &scoring, &a_end, &b_end);
+            method = "local, striped SSE2 (Farrar)";
+
+            if (best < 0) 
+            {
+                best = local_score_striped32(a, m, b, n, &scoring, &a_end, &b_end);
+                method = "local, striped SSE2 32-bit (Farrar)";
+            }
+        }
+#endif
+
+        if (best < 0) 
+        {
+            best = local_score_scalar(a, m, b, n, &scoring, &a_end, &b_end);
+            method = "local, scalar (Smith-Waterman)";
+        }
+
+        if (best > 0) 
+        {
+#if defined(__SSE2__)
+            local_start_striped32(a, b, a_end, b_end, &scoring, best, &result.a_start, &result.b_start);
+#else
+            local_start_scan(a, b, a_end, b_end, &scoring, best, &result.a_start, &result.b_start);
+#endif
+            align_global_linear(a + result.a_start, a_end - result.a_start, b + result.b_start, b_end - result.b_start, &scoring, &path);
+        }
+
+        result.a_end = a_end;
+        result.b_end = b_end;
+    }
+
+    result.score = align_path_score(&path, a + result.a_start, b + result.b_start, &scoring);
+
+    int64_t matches = 0;
+    int i = result.a_start;
+    int j = result.b_start;
+
+    for (int64_t k = 0; k < path.length; k++) 
+    {
+        if (path.ops[k] == 'M') 
+        {
+            matches += a[i] == b[j];
+            i++;
+            j++;
+        } 
+        else if (path.ops[k] == 'D') 
+        {
+            i++;
+        } 
+        else 
+        {
+            j++;
+        }
+    }
+
+    log_printf("\n=== Alignment ===\n\n");
+    log_printf("Method    : %s\n", method);
+    log_printf("Scoring   : match %d, mismatch -%d, gap open -%d, gap extend -%d\n",
+               scoring.match, scoring.mismatch, scoring.gap_open, scoring.gap_extend);
+    log_printf("Score     : %d\n", result.score);
+
+    if (path.length > 0) 
+    {
+        log_printf("Identity  : %.2f%% (%lld/%lld)\n", 100.0 * matches / path.length, (long long)matches, (long long)path.length);
+        log_printf("Seq1 range: %d-%d\n", result.a_start + 1, result.a_end);
+        log_printf("Seq2 range: %d-%d\n", result.b_start + 1, result.b_end);
+        log_printf("CIGAR     : ");
+        align_print_cigar(&path);
+
+        if (path.length <= MAX_DNA_LENGTH) 
+        {
+            align_print_view(&path, a, b, &result);
+        }
+    } 
+    else 
+    {
+        log_printf("No alignment found.\n");
+    }
+
+    free(path.ops);
+}
+
+void run_align_fasta_mode(const options *config)
+{
+    char *sequences[2] = { NULL, NULL };
+    int64_t lengths[2] = { 0, 0 };
+    const char *files[2] = { config->align_file1, config->align_file2 };
+
+    for (int s = 0; s < 2; s++) 
+    {
+        fasta_reader reader;
+        int64_t capacity = 0;
+
+        if (!fasta_reader_open(&reader, files[s])) 
+        {
+            free(sequences[0]);
+            return;
+        }
+
+        if (!fasta_read_record(&reader, &sequences[s], &capacity, &lengths[s]) || lengths[s] > INT32_MAX / 2) 
+        {
+            log_printf("Error: No usable DNA sequence found in '%s'\n", files[s]);
+            fasta_reader_close(&reader);
+            free(sequences[0]);
+            free(sequences[1]);
+            return;
+        }
+
+        fasta_reader_close(&reader);
+    }
+
+    run_alignment(sequences[0], (int)lengths[0], sequences[1], (int)lengths[1], config);
+
+    free(sequences[0]);
+    free(sequences[1]);
+}
+
+#ifndef _WIN32
+static pthread_mutex_t exporter_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+void run_sequence_exporters(const char *work_seq, const options *config) 
+{
+#ifndef _WIN32
+    pthread_mutex_lock(&exporter_lock);
+#endif
+
+    if (config->do_csv == 1) 
+    {
+        profile_mark mark = profile_begin();
+
+        export_csv(config->csv_file, work_seq);
+
+        profile_end_sequence(STAGE_CSV, mark, work_seq);
+    }
+
+    if (config->do_stats_columns == 1) 
+    {
+        profile_mark mark = profile_begin();
+
+        export_stats_row(config->stats_columns_file, STATS_COLUMNAR, work_seq);
+
+        profile_end_sequence(STAGE_STATS_COLUMNS, mark, work_seq);
+    }
+
+    if (config->do_export_stats == 1) 
+    {
+        profile_mark mark = profile_begin();
+
+        export_stats_json(config->export_stats_file, work_seq);
+
+        profile_end_sequence(STAGE_EXPORT_STATS, mark, work_seq);
+    }
+
+    if (config->do_fasta_export == 1) 
+    {
+        profile_mark mark = profile_begin();
+        int success = export_fasta_sequence(config->fasta_export_file, work_seq);
+
+        if (success && config->output_format == FORMAT_TEXT) 
+        {
+            log_printf("\nFASTA export completed: %s\n\n", config->fasta_export_file);
+        }
+
+        profile_end_sequence(STAGE_FASTA_EXPORT, mark, work_seq);
+    }
+
+#ifndef _WIN32
+    pthread_mutex_unlock(&exporter_lock);
+#endif
+}
+
+typedef struct {
+    int format;
+    text_buffer buffer;
+    int depth;
+    int is_map[RECORD_MAX_DEPTH];
+    int items[RECORD_MAX_DEPTH];
+    size_t header[RECORD_MAX_DEPTH];
+} record_writer;
+
+static THREAD_LOCAL record_writer output_record;
+static THREAD_LOCAL int64_t output_record_index = 0;
+static THREAD_LOCAL const char *output_record_file = NULL;
+static THREAD_LOCAL const char *output_record_name = NULL;
+static THREAD_LOCAL int64_t output_record_offset = 0;
+
+void record_put_byte(record_writer *writer, unsigned char value)
+{
+    text_reserve(&writer->buffer, 1);
+    writer->buffer.data[writer->buffer.length++] = (char)value;
+}
+
+void record_put_be(record_writer *writer, uint64_t value, int bytes)
+{
+    text_reserve(&writer->buffer, bytes);
+
+    for (int i = bytes - 1; i >= 0; i--) 
+    {
+        writer->buffer.data[writer->buffer.length++] = (char)((value >> (8 * i)) & 0xFF);
+    }
+}
+
+void record_value_prefix(record_writer *writer)
+{
+    if (writer->depth == 0 || writer->is_map[writer->depth - 1]) 
+    {
+        return;
+    }
+
+    if (writer->format == FORMAT_NDJSON && writer->items[writer->depth - 1] > 0) 
+    {
+        text_append(&writer->buffer, ",", 1);
+    }
+
+    writer->items[writer->depth - 1]++;
+}
+
+void record_open(record_writer *writer, int is_map)
+{
+    record_value_prefix(writer);
+
+    writer->is_map[writer->depth] = is_map;
+    writer->items[writer->depth] = 0;
+    writer->header[writer->depth] = writer->buffer.length;
+    writer->depth++;
+
+    if (writer->format == FORMAT_NDJSON) 
+    {
+        text_append(&writer->buffer, is_map ? "{" : "[", 1);
+    }
+    else 
+    {
+        record_put_byte(writer, 0xDF - (unsigned char)(is_map ? 0 : 2));
+        record_put_be(writer, 0, 4);
+    }
+}
+
+void record_close(record_writer *writer)
+{
+    writer->depth--;
+
+    if (writer->format == FORMAT_NDJSON) 
+    {
+        text_append(&writer->buffer, writer->is_map[writer->depth] ? "}" : "]", 1);
+        return;
+    }
+
+    uint32_t count = (uint32_t)writer->items[writer->depth];
+    char *header = writer->buffer.data + writer->header[writer->depth] + 1;
+
+    for (int i = 0; i < 4; i++) 
+    {
+        header[i] = (char)((count >> (8 * (3 - i))) & 0xFF);
+    }
+}
+
+void record_begin_map(record_writer *writer)
+{
+    record_open(writer, 1);
+}
+
+void record_begin_array(record_writer *writer)
+{
+    record_open(writer, 0);
+}
+
+void record_raw_string(record_writer *writer, const char *text, size_t length)
+{
+    if (writer->format == FORMAT_NDJSON) 
+    {
+        text_append_json_string(&writer->buffer, text, length);
+        return;
+    }
+
+    if (length < 32) 
+    {
+        record_put_byte(writer, 0xA0 | (unsigned char)length);
+    }
+    else if (length < 256) 
+    {
+        record_put_byte(writer, 0xD9);
+        record_put_be(writer, length, 1);
+    }
+    else if (length < 65536) 
+    {
+        record_put_byte(writer, 0xDA);
+        record_put_be(writer, length, 2);
+    }
+    else 
+    {
+        record_put_byte(writer, 0xDB);
+        record_put_be(writer, length, 4);
+    }
+
+    text_append(&writer->buffer, text, length);
+}
+
+void record_key(record_writer *writer, const char *key)
+{
+    if (writer->format == FORMAT_NDJSON && writer->items[writer->depth - 1] > 0) 
+    {
+        text_append(&writer->buffer, ",", 1);
+    }
+
+    writer->items[writer->depth - 1]++;
+    record_raw_string(writer, key, strlen(key));
+
+    if (writer->format == FORMAT_NDJSON) 
+    {
+        text_append(&writer->buffer, ":", 1);
+    }
+}
+
+void record_string(record_writer *writer, const char *text, size_t length)
+{
+    record_value_prefix(writer);
+    record_raw_string(writer, text, length);
+}
+
+void record_int(record_writer *writer, int64_t value)
+{
+    record_value_prefix(writer);
+
+    if (writer->format == FORMAT_NDJSON) 
+    {
+        char digits[24];
+        int length = snprintf(digits, sizeof(digits), "%lld", (long long)value);
+
+        text_append(&writer->buffer, digits, length);
+    }
+    else if (value >= 0 && value < 128) 
+    {
+        record_put_byte(writer, (unsigned char)value);
+    }
+    else if (value < 0 && value >= -32) 
+    {
+        record_put_byte(writer, (unsigned char)(value & 0xFF));
+    }
+    else if (value >= INT32_MIN && value <= INT32_MAX) 
+    {
+        record_put_byte(writer, 0xD2);
+        record_put_be(writer, (uint32_t)(int32_t)value, 4);
+    }
+    else 
+    {
+        record_put_byte(writer, 0xD3);
+        record_put_be(writer, (uint64_t)value, 8);
+    }
+}
+
+void record_double(record_writer *writer, double value)
+{
+    record_value_prefix(writer);
+
+    if (writer->format == FORMAT_NDJSON) 
+    {
+        text_printf(&writer->buffer, "%.4f", value);
+    }
+    else 
+    {
+        uint64_t bits;
+
+        memcpy(&bits, &value, sizeof(bits));
+        record_put_byte(writer, 0xCB);
+        record_put_be(writer, bits, 8);
+    }
+}
+
+void record_bool(record_writer *writer, int value)
+{
+    record_value_prefix(writer);
+
+    if (writer->format == FORMAT_NDJSON) 
+    {
+        text_append(&writer->buffer, value ? "true" : "false", value ? 4 : 5);
+    }
+    else 
+    {
+        record_put_byte(writer, value ? 0xC3 : 0xC2);
+    }
+}
+
+void record_null(record_writer *writer)
+{
+    record_value_prefix(writer);
+
+    if (writer->format == FORMAT_NDJSON) 
+    {
+        text_append(&writer->buffer, "null", 4);
+    }
+    else 
+    {
+        record_put_byte(writer, 0xC0);
+    }
+}
+
+void record_json(record_writer *writer, const char *value, size_t length)
+{
+    record_value_prefix(writer);
+    text_append(&writer->buffer, value, length);
+}
+
+void record_hex(record_writer *writer, const unsigned char *bytes, int count)
+{
+    char hex[2 * 64 + 1];
+
+    for (int i = 0; i < count && i < 64; i++) 
+    {
+        snprintf(hex + 2 * i, 3, "%02X", bytes[i]);
+    }
+
+    record_string(writer, hex, 2 * (count < 64 ? count : 64));
+}
+
+void record_flush(record_writer *writer)
+{
+    if (writer->format == FORMAT_NDJSON) 
+    {
+        text_append(&writer->buffer, "\n", 1);
+    }
+
+    if (log_capture != NULL) 
+    {
+        text_append(log_capture, writer->buffer.data, writer->buffer.length);
+        writer->buffer.length = 0;
+        writer->depth = 0;
+        return;
+    }
+
+    fwrite(writer->buffer.data, 1, writer->buffer.length, stdout);
+
+    if (log_fp != NULL && writer->format == FORMAT_NDJSON) 
+    {
+        fwrite(writer->buffer.data, 1, writer->buffer.length, log_fp);
+    }
+
+    writer->buffer.length = 0;
+    writer->depth = 0;
+}
+
+void record_matches(record_writer *writer, const char *key, const char *sequence, int length, const char *pattern, int reverse)
+{
+    int positions[MAX_MATCHES + 1];
+    int pattern_length = strlen(pattern);
+    int matches = find_pattern_positions(sequence, length, pattern, positions, MAX_MATCHES + 1);
+    char truncated_key[64];
+
+    record_key(writer, key);
+    record_begin_array(writer);
+
+    for (int m = 0; m < matches && m < MAX_MATCHES; m++) 
+    {
+        record_int(writer, reverse ? length - positions[m] - pattern_length + 1 : positions[m] + 1);
+    }
+
+    record_close(writer);
+    snprintf(truncated_key, sizeof(truncated_key), "%s_truncated", key);
+    record_key(writer, truncated_key);
+    record_bool(writer, matches > MAX_MATCHES);
+}
+
+void record_orfs(record_writer *writer, const char *key, const char *sequence, int length, int reverse, scratch_arena *arena)
+{
+    orf_hit *hits;
+    int hit_count = collect_orfs(sequence, length, &hits, arena);
+    char *protein = arena_alloc(arena, length / 3 + 2);
+
+    record_key(writer, key);
+    record_begin_array(writer);
+
+    for (int h = 0; h < hit_count; h++) 
+    {
+        int protein_length = translate_to_protein(sequence + hits[h].start, hits[h].end - hits[h].start + 1, protein);
+
+        record_begin_map(writer);
+        record_key(writer, "frame");
+        record_int(writer, hits[h].frame);
+        record_key(writer, "start");
+        record_int(writer, reverse ? length - 1 - hits[h].end : hits[h].start);
+        record_key(writer, "end");
+        record_int(writer, reverse ? length - 1 - hits[h].start : hits[h].end);
+        record_key(writer, "protein");
+        record_string(writer, protein, protein_length > 0 ? protein_length : 0);
+        record_close(writer);
+    }
+
+    record_close(writer);
+}
+
+void record_six_frames(record_writer *writer, const char *sequence, const char *reverse, int length, scratch_arena *arena)
+{
+    char *protein = arena_alloc(arena, length / 3 + 1);
+
+    record_key(writer, "six_frame");
+    record_begin_map(writer);
+
+    for (int strand = 0; strand < 2; strand++) 
+    {
+        const char *source = strand == 0 ? sequence : reverse;
+
+        for (int frame = 0; frame < 3; frame++) 
+        {
+            char label[3] = { strand == 0 ? '+' : '-', (char)('1' + frame), '\0' };
+            int count = 0;
+
+            for (int i = frame; i + 2 < length; i += 3) 
+            {
+                protein[count++] = translate_codon(source + i);
+            }
+
+            record_key(writer, label);
+            record_string(writer, protein, count);
+        }
+    }
+
+    record_close(writer);
+}
+
+void write_sequence_fields(record_writer *writer, const char *sequence, int length, const options *config, int transformed, scratch_arena *arena)
+{
+    record_key(writer, "length");
+    record_int(writer, length);
+
+    if (transformed || config->show_ascii == 1) 
+    {
+        record_key(writer, "sequence");
+        record_string(writer, sequence, length);
+    }
+
+    if (config->show_stats == 1 || config->show_summary == 1 || config->show_json == 1 || config->do_complexity == 1) 
+    {
+        int a, c, g, t;
+
+        count_bases(sequence, &a, &c, &g, &t);
+        record_key(writer, "stats");
+        record_begin_map(writer);
+        record_key(writer, "A");
+        record_int(writer, a);
+        record_key(writer, "C");
+        record_int(writer, c);
+        record_key(writer, "G");
+        record_int(writer, g);
+        record_key(writer, "T");
+        record_int(writer, t);
+        record_key(writer, "gc_percent");
+        record_double(writer, a + c + g + t > 0 ? 100.0 * (c + g) / (a + c + g + t) : 0.0);
+
+        if (config->do_complexity == 1) 
+        {
+            record_key(writer, "entropy");
+            record_double(writer, base_entropy(a, c, g, t));
+        }
+
+        record_close(writer);
+    }
+
+    char *reverse = NULL;
+
+    if (config->both_strands == 1 || config->six_frame == 1) 
+    {
+        reverse = arena_alloc(arena, length + 1);
+        memcpy(reverse, sequence, length + 1);
+        reverse_complement_sequence(reverse);
+    }
+
+    if (config->do_find == 1 && config->find_pattern[0] != '\0') 
+    {
+        record_matches(writer, "matches", sequence, length, config->find_pattern, 0);
+
+        if (config->both_strands == 1) 
+        {
+            record_matches(writer, "reverse_matches", reverse, length, config->find_pattern, 1);
+        }
+    }
+
+    if (config->do_palindrome == 1) 
+    {
+        record_key(writer, "palindrome");
+        record_bool(writer, is_dna_palindrome(sequence));
+    }
+
+    if (config->do_orf == 1) 
+    {
+        record_orfs(writer, "orfs", sequence, length, 0, arena);
+
+        if (config->six_frame == 1) 
+        {
+            record_orfs(writer, "reverse_orfs", reverse, length, 1, arena);
+        }
+    }
+
+    if (config->do_position == 1) 
+    {
+        record_key(writer, "positions");
+        record_begin_array(writer);
+
+        for (int i = 0; i < length; i++) 
+        {
+            if (sequence[i] == config->position_base) 
+            {
+                record_int(writer, i);
+            }
+        }
+
+        record_close(writer);
+    }
+
+    if (config->do_key == 1) 
+    {
+        unsigned char key[KEY_SIZE];
+
+        derive_key_bytes(sequence, key);
+        record_key(writer, "key");
+        record_hex(writer, key, KEY_SIZE);
+    }
+
+    if (config->do_hash == 1) 
+    {
+        unsigned char hash[32];
+
+        derive_hash_bytes(sequence, hash);
+        record_key(writer, "hash");
+        record_hex(writer, hash, 32);
+    }
+
+    if (config->do_compress == 1) 
+    {
+        char *compressed = arena_alloc(arena, 2 * (size_t)length + 2);
+
+        compress_sequence(sequence, compressed);
+        record_key(writer, "compressed");
+        record_string(writer, compressed, strlen(compressed));
+    }
+
+    if (config->do_translate == 1) 
+    {
+        char *protein = arena_alloc(arena, length / 3 + 2);
+        int protein_length = translate_to_protein(sequence, length, protein);
+
+        record_key(writer, "translation");
+
+        if (protein_length < 0) 
+        {
+            record_null(writer);
+        }
+        else 
+        {
+            record_string(writer, protein, protein_length);
+        }
+    }
+
+    if (config->six_frame == 1) 
+    {
+        record_six_frames(writer, sequence, reverse, length, arena);
+    }
+
+}
+
+void write_sequence_results(const char *sequence, const options *config, int transformed)
+{
+    record_writer *writer = &output_record;
+
+    writer->format = config->output_format;
+    writer->buffer.length = 0;
+    writer->depth = 0;
+
+    record_begin_map(writer);
+    record_key(writer, "index");
+    record_int(writer, output_record_index++);
+
+    if (output_record_file != NULL) 
+    {
+        record_key(writer, "file");
+        record_string(writer, output_record_file, strlen(output_record_file));
+        record_key(writer, "record");
+        record_string(writer, output_record_name, strlen(output_record_name));
+        record_key(writer, "offset");
+        record_int(writer, output_record_offset);
+    }
+
+    write_sequence_fields(writer, sequence, strlen(sequence), config, transformed, &global_arena);
+    record_close(writer);
+    record_flush(writer);
+}
+
+void process_sequence(char *sequence, const options *config) 
+{
+    char *work_seq = sequence;
+    profile_mark sequence_mark = profile_begin();
+
+    if (config->do_decompress == 1) 
+    {
+        char decompressed[MAX_DNA_LENGTH];
+        profile_mark mark = profile_begin();
+
+        decompress_sequence(work_seq, decompressed);
+
+        if (config->output_format == FORMAT_TEXT) 
+        {
+            log_printf("\n=== Decompressed Sequence ===\n\n");
+            log_printf("%s\n", decompressed);
+        }
+
+        memcpy(work_seq, decompressed, strlen(decompressed) + 1);
+        profile_end_sequence(STAGE_DECOMPRESS, mark, work_seq);
+    } 
+    else 
+    {
+        profile_mark mark = profile_begin();
+
+        clean_sequence(work_seq);
+
+        profile_end_sequence(STAGE_CLEAN, mark, work_seq);
+    }
+
+    if (config->mutate_count > 0) 
+    {
+        profile_mark mark = profile_begin();
+
+        mutate_sequence(work_seq, config->mutate_count);
+
+        profile_end_sequence(STAGE_MUTATE, mark, work_seq);
+    }
+
+    if (config->errors_count > 0) 
+    {
+        profile_mark mark = profile_begin();
+
+        inject_errors(work_seq, config->errors_count);
+
+        profile_end_sequence(STAGE_ERRORS, mark, work_seq);
+    }
+
+    if (config->sub_rate > 0 || config->ins_rate > 0 || config->del_rate > 0) 
+    {
+        profile_mark mark = profile_begin();
+        mutation_engine engine;
+        char mutated[2 * MAX_DNA_LENGTH];
+
+        mutation_engine_init(&engine, &global_rng, config->sub_rate, config->ins_rate, config->del_rate);
+
+        int64_t length = mutation_engine_apply(&engine, work_seq, strlen(work_seq), mutated);
+
+        if (length > MAX_DNA_LENGTH - 1) 
+        {
+            length = MAX_DNA_LENGTH - 1;
+        }
+
+        memcpy(work_seq, mutated, (size_t)length);
+        work_seq[length] = '\0';
+
+        profile_end_sequence(STAGE_RATES, mark, work_seq);
+    }
+
+    sequence_view view;
+
+    sequence_view_init(&view, work_seq, strlen(work_seq));
+
+    if (config->do_reverse_complement == 1 || config->do_complement == 1 || config->do_reverse == 1 || config->rotate_n != 0) 
+    {
+        profile_mark mark = profile_begin();
+
+        if (config->do_reverse_complement == 1 || config->do_complement == 1) 
+        {
+            sequence_view_complement(&view);
+        }
+
+        if (config->do_reverse_complement == 1 || config->do_reverse == 1) 
+        {
+            sequence_view_reverse(&view);
+        }
+
+        sequence_view_rotate(&view, config->rotate_n);
+
+        profile_end_sequence(STAGE_TRANSFORM, mark, work_seq);
+    }
+
+    if (config->output_format != FORMAT_TEXT) 
+    {
+        profile_mark materialize_mark = profile_begin();
+
+        sequence_view_materialize(&view);
+        profile_end_sequence(STAGE_TRANSFORM, materialize_mark, work_seq);
+
+        int transformed = config->do_decompress == 1 || config->mutate_count > 0 || config->errors_count > 0 || config->sub_rate > 0 || config->ins_rate > 0 || config->del_rate > 0 || config->do_reverse_complement == 1 || config->do_complement == 1 || config->do_reverse == 1 || config->rotate_n != 0;
+        profile_mark mark = profile_begin();
+
+        write_sequence_results(work_seq, config, transformed);
+
+        profile_end_sequence(STAGE_RECORD, mark, work_seq);
+        run_sequence_exporters(work_seq, config);
+        profile_end_sequence(STAGE_SEQUENCE, sequence_mark, work_seq);
+        arena_reset(&global_arena);
+        return;
+    }
+
+    if (config->do_find == 1 && config->find_pattern[0] != '\0') 
+    {
+        profile_mark mark = profile_begin();
+
+        find_pattern_view(&view, config->find_pattern, config->no_color ? 0 : 1, config->both_strands);
+
+        profile_end_sequence(STAGE_FIND, mark, work_seq);
+    }
+
+    if (config->do_palindrome == 1) 
+    {
+        profile_mark mark = profile_begin();
+
+        check_palindrome(&view);
+
+        profile_end_sequence(STAGE_PALINDROME, mark, work_seq);
+    }
+
+    if (config->do_orf == 1) 
+    {
+        profile_mark mark = profile_begin();
+
+        find_orfs_view(&view, "Open Reading Frames (ORFs)", 0, &global_arena);
+
+        if (config->six_frame == 1) 
+        {
+            sequence_view reverse = view;
+
+            sequence_view_complement(&reverse);
+            sequence_view_reverse(&reverse);
+            find_orfs_view(&reverse, "Open Reading Frames (ORFs), reverse strand", 1, &global_arena);
+        }
+
+        profile_end_sequence(STAGE_ORF, mark, work_seq);
+    }
+
+    if (!sequence_view_is_identity(&view)) 
+    {
+        profile_mark mark = profile_begin();
+
+        sequence_view_materialize(&view);
+
+        profile_end_sequence(STAGE_TRANSFORM, mark, work_seq);
+    }
+
+    if (config->do_position == 1) 
+    {
+        profile_mark mark = profile_begin();
+
+        print_positions_of_base(work_seq, config->position_base);
+
+        profile_end_sequence(STAGE_POSITION, mark, work_seq);
+    }
+
+    if (config->show_json == 1) 
+    {
+        profile_mark mark = profile_begin();
+
+        print_json(work_seq);
+
+        profile_end_sequence(STAGE_JSON, mark, work_seq);
+    }
+
+    if (config->do_binary == 1) 
+    {
+        profile_mark mark = profile_begin();
+
+        print_binary(work_seq);
+
+        profile_end_sequence(STAGE_BINARY, mark, work_seq);
+    }
+
+    if (config->do_hex == 1) 
+    {
+        profile_mark mark = profile_begin();
+
+        print_hex(work_seq);
+
+        profile_end_sequence(STAGE_HEX, mark, work_seq);
+    }
+
+    if (config->do_key == 1) 
+    {
+        profile_mark mark = profile_begin();
+
+        derive_key(work_seq);
+
+        profile_end_sequence(STAGE_KEY, mark, work_seq);
+    }
+
+    if (config->do_hash == 1) 
+    {
+        profile_mark mark = profile_begin();
+
+        derive_hash(work_seq);
+
+        profile_end_sequence(STAGE_HASH, mark, work_seq);
+    }
+
+    if (config->encrypt_mode == 1) 
+    {
+        profile_mark mark = profile_begin();
+
+        encrypt_text_with_dna_key(work_seq, config->encrypt_text);
+
+        profile_end_sequence(STAGE_ENCRYPT, mark, work_seq);
+    }
+
+    if (config->decrypt_mode == 1) 
+    {
+        profile_mark mark = profile_begin();
+
+        decrypt_hex_with_dna_key(work_seq, config->decrypt_hex);
+
+        profile_end_sequence(STAGE_DECRYPT, mark, work_seq);
+    }
+
+    if (config->do_qrcode == 1) 
+    {
+        profile_mark mark = profile_begin();
+
+        print_qrcode(work_seq);
+
+        profile_end_sequence(STAGE_QRCODE, mark, work_seq);
+    }
+
+    if (config->do_histogram == 1) 
+    {
+        profile_mark mark = profile_begin();
+
+        if (config->histogram_vertical) 
+        {
+            print_histogram_vertical(work_seq, config->no_color);
+        } 
+        else 
+        {
+            print_histogram_horizontal(work_seq, config->no_color);
+        }
+
+        profile_end_sequence(STAGE_HISTOGRAM, mark, work_seq);
+    }
+
+    if (config->do_compress == 1) 
+    {
+        profile_mark mark = profile_begin();
+
+        print_compressed(work_seq);
+
+        profile_end_sequence(STAGE_COMPRESS, mark, work_seq);
+    }
+
+    if (config->do_complexity == 1) 
+    {
+        profile_mark mark = profile_begin();
+
+        print_complexity(work_seq);
+
+        profile_end_sequence(STAGE_COMPLEXITY, mark, work_seq);
+    }
+
+    if (config->do_translate == 1 || config->six_frame == 1) 
+    {
+        profile_mark mark = profile_begin();
+
+        if (config->six_frame == 1) 
+        {
+            print_six_frame_translation(&view, &global_arena);
+        }
+        else 
+        {
+            translate_sequence(work_seq, &global_arena);
+        }
+
+        profile_end_sequence(STAGE_TRANSLATE, mark, work_seq);
+    }
+
+    if (config->show_ascii == 1) 
+    {
+        profile_mark mark = profile_begin();
+
+        print_sequence(work_seq);
+
+        profile_end_sequence(STAGE_ASCII, mark, work_seq);
+    }
+
+    if (config->show_stats == 1) 
+    {
+        profile_mark mark = profile_begin();
+
+        print_stats(work_seq);
+
+        profile_end_sequence(STAGE_STATS, mark, work_seq);
+    }
+
+    if (config->show_summary == 1) 
+    {
+        profile_mark mark = profile_begin();
+
+        print_summary(work_seq);
+
+        profile_end_sequence(STAGE_SUMMARY, mark, work_seq);
+    }
+
+    run_sequence_exporters(work_seq, config);
+
+    log_printf("\n");
+
+    profile_end_sequence(STAGE_SEQUENCE, sequence_mark, work_seq);
+    arena_reset(&global_arena);
+}
+
+void run_compare_mode(const options *config) 
+{
+    char seq1[MAX_DNA_LENGTH];
+    char seq2[MAX_DNA_LENGTH];
+
+    strcpy(seq1, config->compare_seq1);
+    strcpy(seq2, config->compare_seq2);
+    clean_sequence(seq1);
+    clean_sequence(seq2);
+
+    int diff = count_differences(seq1, seq2);
+
+    log_printf("\n=== Comparing Sequences ===\n\n");
+
+    log_printf("Sequence 1: %s\n", seq1);
+    log_printf("Sequence 2: %s\n", seq2);
+    log_printf("Differences: %d base(s)\n", diff);
+
+    if (config->do_align == 1) 
+    {
+        run_alignment(seq1, strlen(seq1), seq2, strlen(seq2), config);
+    }
+
+    int len1 = strlen(seq1);
+    int len2 = strlen(seq2);
+
+    if (config->do_jaccard == 1 && len1 >= config->sketch_k && len2 >= config->sketch_k) 
+    {
+        minhash_sketch sketch1;
+        minhash_sketch sketch2;
+        int shared;
+        int considered;
+
+        sketch_init(&sketch1, "seq1", len1 + len2);
+        sketch_init(&sketch2, "seq2", len1 + len2);
+        sketch_add_sequence(&sketch1, seq1, len1, config->sketch_k);
+        sketch_add_sequence(&sketch2, seq2, len2, config->sketch_k);
+        sketch_finish(&sketch1);
+        sketch_finish(&sketch2);
+
+        double jaccard = sketch_jaccard(&sketch1, &sketch2, &shared, &considered);
+        double distance = mash_distance(jaccard, config->sketch_k);
+
+        log_printf("Jaccard (k=%d): %.4f (%d/%d shared k-mers)\n", config->sketch_k, jaccard, shared, considered);
+        log_printf("Estimated ANI: %.2f%%\n", 100.0 * (1.0 - distance));
+
+        free(sketch1.hashes);
+        free(sketch2.hashes);
+    }
+
+    process_sequence(seq1, config);
+    process_sequence(seq2, config);
+}
+
+typedef struct {
+    uint64_t *words;
+    int word_count;
+    int length;
+    int capacity;
+} packed_sequence;
+
+typedef struct {
+    int distance;
+    long line;
+    char *sequence;
+} hamming_hit;
+
+typedef struct {
+    packed_sequence reference;
+    packed_sequence input;
+    int max_dist;
+    int top_n;
+    hamming_hit *hits;
+    int hit_count;
+    long line_number;
+} hamming_state;
+
+int popcount64(uint64_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(value);
+#else
+    value = value - ((value >> 1) & 0x5555555555555555ULL);
+    value = (value & 0x3333333333333333ULL) + ((value >> 2) & 0x3333333333333333ULL);
+    value = (value + (value >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+
+    return (int)((value * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+int trailing_zeros64(uint64_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return value == 0 ? 64 : __builtin_ctzll(value);
+#else
+    return popcount64((value & (0 - value)) - 1);
+#endif
+}
+
+void pack_sequence(const char *sequence, packed_sequence *packed)
+{
+    int raw_length = strlen(sequence);
+    int needed = raw_length / 32 + 1;
+
+    if (packed->capacity < needed) 
+    {
+        packed->words = xrealloc(packed->words, sizeof(uint64_t) * needed);
+        packed->capacity = needed;
+    }
+
+    int length = 0;
+    uint64_t word = 0;
+
+    for (int i = 0; sequence[i] != '\0'; i++) 
+    {
+        int code = base_code(toupper(sequence[i]));
+
+        if (code < 0) 
+        {
+            continue;
+        }
+
+        word |= (uint64_t)code << (2 * (length % 32));
+        length++;
+
+        if (length % 32 == 0) 
+        {
+            packed->words[length / 32 - 1] = word;
+            word = 0;
+        }
+    }
+
+    if (length % 32 != 0) 
+    {
+        packed->words[length / 32] = word;
+    }
+
+    packed->length = length;
+    packed->word_count = (length + 31) / 32;
+}
+
+void unpack_sequence(const packed_sequence *packed, char *out)
+{
+    const char bases[] = { 'A', 'C', 'G', 'T' };
+
+    for (int i = 0; i < packed->length; i++) 
+    {
+        out[i] = bases[(packed->words[i / 32] >> (2 * (i % 32))) & 3];
+    }
+
+    out[packed->length] = '\0';
+}
+
+int packed_hamming_distance(const packed_sequence *a, const packed_sequence *b, int limit)
+{
+    const uint64_t low_bits = 0x5555555555555555ULL;
+    int distance = 0;
+    int w = 0;
+
+#if defined(__AVX2__)
+    const __m256i mask = _mm256_set1_epi64x((long long)low_bits);
+    const __m256i nibble_mask = _mm256_set1_epi8(0x0F);
+    const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+
+    for (; w + 4 <= a->word_count; w += 4) 
+    {
+        __m256i x = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)(a->words + w)),
+                                     _mm256_loadu_si256((const __m256i *)(b->words + w)));
+        __m256i diff = _mm256_and_si256(_mm256_or_si256(x, _mm256_srli_epi64(x, 1)), mask);
+        __m256i counts = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, _mm256_and_si256(diff, nibble_mask)),
+                                         _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(diff, 4), nibble_mask)));
+        __m256i sums = _mm256_sad_epu8(counts, _mm256_setzero_si256());
+
+        distance += _mm256_extract_epi64(sums, 0) + _mm256_extract_epi64(sums, 1) +
+                    _mm256_extract_epi64(sums, 2) + _mm256_extract_epi64(sums, 3);
+
+        if (limit >= 0 && distance > limit) 
+        {
+            return limit + 1;
+        }
+    }
+#endif
+
+    for (; w < a->word_count; w++) 
+    {
+        uint64_t x = a->words[w] ^ b->words[w];
+
+        distance += popcount64((x | (x >> 1)) & low_bits);
+
+        if (limit >= 0 && distance > limit) 
+        {
+            return limit + 1;
+        }
+    }
+
+    return distance;
+}
+
+void hamming_state_init(hamming_state *state, const options *config)
+{
+    memset(state, 0, sizeof(*state));
+    pack_sequence(config->hamming_seq, &state->reference);
+    state->max_dist = config->hamming_max_dist;
+    state->top_n = config->hamming_top_n;
+
+    if (state->top_n > 0) 
+    {
+        state->hits = xmalloc(sizeof(hamming_hit) * state->top_n);
+    }
+}
+
+void hamming_heap_sift_down(hamming_hit *hits, int count, int index)
+{
+    while (1) 
+    {
+        int largest = index;
+        int left = 2 * index + 1;
+        int right = left + 1;
+
+        if (left < count && hits[left].distance > hits[largest].distance) 
+        {
+            largest = left;
+        }
+
+        if (right < count && hits[right].distance > hits[largest].distance) 
+        {
+            largest = right;
+        }
+
+        if (largest == index) 
+        {
+            return;
+        }
+
+        hamming_hit temp = hits[index];
+        hits[index] = hits[largest];
+        hits[largest] = temp;
+        index = largest;
+    }
+}
+
+void hamming_heap_push(hamming_state *state, int distance)
+{
+    hamming_hit hit;
+
+    hit.distance = distance;
+    hit.line = state->line_number;
+    hit.sequence = xmalloc(state->input.length + 1);
+    unpack_sequence(&state->input, hit.sequence);
+
+    if (state->hit_count < state->top_n) 
+    {
+        int index = state->hit_count++;
+
+        state->hits[index] = hit;
+
+        while (index > 0 && state->hits[(index - 1) / 2].distance < state->hits[index].distance) 
+        {
+            hamming_hit temp = state->hits[index];
+            state->hits[index] = state->hits[(index - 1) / 2];
+            state->hits[(index - 1) / 2] = temp;
+            index = (index - 1) / 2;
+        }
+
+        return;
+    }
+
+    free(state->hits[0].sequence);
+    state->hits[0] = hit;
+    hamming_heap_sift_down(state->hits, state->hit_count, 0);
+}
+
+int compare_hamming_hits(const void *a, const void *b)
+{
+    const hamming_hit *x = a;
+    const hamming_hit *y = b;
+
+    if (x->distance != y->distance) 
+    {
+        return x->distance - y->distance;
+    }
+
+    return (x->line > y->line) - (x->line < y->line);
+}
+
+void print_hamming_top(hamming_state *state)
+{
+    qsort(state->hits, state->hit_count, sizeof(hamming_hit), compare_hamming_hits);
+
+    log_printf("\n=== Nearest Sequences (Hamming) ===\n\n");
+
+    if (state->hit_count == 0) 
+    {
+        log_printf("No sequences within range.\n\n");
+        return;
+    }
+
+    for (int i = 0; i < state->hit_count; i++) 
+    {
+        log_printf("%d. Line %ld: distance %d\n", i + 1, state->hits[i].line, state->hits[i].distance);
+        log_printf("   %s\n", state->hits[i].sequence);
+    }
+
+    log_printf("\n");
+}
+
+void hamming_state_free(hamming_state *state)
+{
+    for (int i = 0; i < state->hit_count; i++) 
+    {
+        free(state->hits[i].sequence);
+    }
+
+    free(state->hits);
+    free(state->reference.words);
+    free(state->input.words);
+}
+
+typedef struct {
+    FILE *file;
+    io_writer *io;
+    char *buffer;
+    size_t length;
+    size_t capacity;
+} buffered_writer;
+
+typedef struct {
+    char *header;
+    size_t header_capacity;
+    char *sequence;
+    size_t sequence_length;
+    size_t sequence_capacity;
+    char *quality;
+    size_t quality_capacity;
+    int has_quality;
+} sequence_record;
+
+typedef struct {
+    FILE *file;
+    int owns_file;
+    char *line;
+    size_t line_capacity;
+    int pending;
+    int format;
+} record_reader;
+
+typedef struct {
+    uint64_t code;
+    int sample;
+    int distance;
+} barcode_slot;
+
+typedef struct {
+    barcode_slot *slots;
+    size_t capacity;
+    int barcode_length;
+    int ambiguous_variants;
+} barcode_table;
+
+typedef struct {
+    const barcode_table *table;
+    const sequence_record *records;
+    int *assignments;
+    int start;
+    int end;
+} demux_worker;
+
+int writer_open(buffered_writer *writer, const char *filename, size_t capacity)
+{
+    writer->file = NULL;
+    writer->io = NULL;
+    writer->length = 0;
+    writer->capacity = capacity;
+    writer->buffer = NULL;
+
+    if (strcmp(filename, "-") == 0) 
+    {
+        writer->file = stdout;
+    }
+    else 
+    {
+        writer->io = xmalloc(sizeof(io_writer));
+
+        if (io_writer_open(writer->io, filename, capacity)) 
+        {
+            writer->buffer = io_writer_buffer(writer->io);
+            return 1;
+        }
+
+        free(writer->io);
+        writer->io = NULL;
+        writer->file = fopen(filename, "wb");
+    }
+
+    if (writer->file == NULL) 
+    {
+        log_printf("Error: Could not open output file '%s'\n", filename);
+        return 0;
+    }
+
+    writer->buffer = xmalloc(capacity);
+
+    return 1;
+}
+
+void writer_flush(buffered_writer *writer)
+{
+    if (writer->length > 0) 
+    {
+        if (writer->io != NULL) 
+        {
+            writer->buffer = io_writer_submit(writer->io, writer->length);
+        }
+        else 
+        {
+            fwrite(writer->buffer, 1, writer->length, writer->file);
+        }
+
+        writer->length = 0;
+    }
+}
+
+void writer_write(buffered_writer *writer, const char *data, size_t length)
+{
+    if (writer->length + length > writer->capacity) 
+    {
+        writer_flush(writer);
+
+        if (length > writer->capacity && writer->io == NULL) 
+        {
+            fwrite(data, 1, length, writer->file);
+            return;
+        }
+
+        while (length > writer->capacity) 
+        {
+            memcpy(writer->buffer, data, writer->capacity);
+            writer->length = writer->capacity;
+            writer_flush(writer);
+            data += writer->capacity;
+            length -= writer->capacity;
+        }
+    }
+
+    memcpy(writer->buffer + writer->length, data, length);
+    writer->length += length;
+}
+
+void writer_puts(buffered_writer *writer, const char *text)
+{
+    writer_write(writer, text, strlen(text));
+}
+
+void writer_close(buffered_writer *writer)
+{
+    if (writer->io != NULL) 
+    {
+        writer_flush(writer);
+
+        if (!io_writer_close(writer->io)) 
+        {
+            log_printf("Error: Could not write all output\n");
+        }
+
+        free(writer->io);
+        writer->io = NULL;
+        writer->buffer = NULL;
+    }
+
+    if (writer->file != NULL) 
+    {
+        writer_flush(writer);
+
+        if (writer->file == stdout) 
+        {
+            fflush(stdout);
+        }
+        else 
+        {
+            fclose(writer->file);
+        }
+    }
+
+    free(writer->buffer);
+    writer->file = NULL;
+    writer->buffer = NULL;
+}
+
+int read_line(FILE *file, char **line, size_t *capacity)
+{
+    size_t length = 0;
+
+    if (*line == NULL) 
+    {
+        *capacity = 256;
+        *line = xmalloc(*capacity);
+    }
+
+    while (fgets(*line + length, (int)(*capacity - length), file) != NULL) 
+    {
+        length += strlen(*line + length);
+
+        if (length > 0 && (*line)[length - 1] == '\n') 
+        {
+            break;
+        }
+
+        if (length + 1 < *capacity) 
+        {
+            continue;
+        }
+
+        *capacity *= 2;
+        *line = xrealloc(*line, *capacity);
+    }
+
+    while (length > 0 && ((*line)[length - 1] == '\n' || (*line)[length - 1] == '\r')) 
+    {
+        length--;
+    }
+
+    (*line)[length] = '\0';
+
+    return length > 0 || !feof(file);
+}
+
+void copy_field(char **field, size_t *capacity, const char *text, size_t length)
+{
+    if (*capacity < length + 1) 
+    {
+        *capacity = length + 1;
+        *field = xrealloc(*field, *capacity);
+    }
+
+    memcpy(*field, text, length);
+    (*field)[length] = '\0';
+}
+
+void append_field(char **field, size_t *length, size_t *capacity, const char *text)
+{
+    size_t extra = strlen(text);
+
+    if (*capacity < *length + extra + 1) 
+    {
+        *capacity = (*length + extra + 1) * 2;
+        *field = xrealloc(*field, *capacity);
+    }
+
+    memcpy(*field + *length, text, extra + 1);
+    *length += extra;
+}
+
+int record_reader_open(record_reader *reader, const char *filename)
+{
+    memset(reader, 0, sizeof(*reader));
+
+    if (filename == NULL || filename[0] == '\0' || strcmp(filename, "-") == 0) 
+    {
+        reader->file = stdin;
+        return 1;
+    }
+
+    reader->file = fopen(filename, "r");
+    reader->owns_file = 1;
+
+    if (reader->file == NULL) 
+    {
+        log_printf("Error: Could not open input file '%s'\n", filename);
+        return 0;
+    }
+
+    return 1;
+}
+
+void record_reader_close(record_reader *reader)
+{
+    if (reader->owns_file && reader->file != NULL) 
+    {
+        fclose(reader->file);
+    }
+
+    free(reader->line);
+    reader->file = NULL;
+    reader->line = NULL;
+}
+
+int record_reader_next(record_reader *reader, sequence_record *record)
+{
+    while (reader->pending || read_line(reader->file, &reader->line, &reader->line_capacity)) 
+    {
+        reader->pending = 0;
+
+        if (reader->line[0] == '\0') 
+        {
+            continue;
+        }
+
+        if (reader->format == 0) 
+        {
+            reader->format = reader->line[0] == '@' || reader->line[0] == '>' ? reader->line[0] : 'p';
+        }
+
+        record->sequence_length = 0;
+        record->has_quality = 0;
+
+        if (record->sequence == NULL) 
+        {
+            record->sequence_capacity = 256;
+            record->sequence = xmalloc(record->sequence_capacity);
+        }
+
+        record->sequence[0] = '\0';
+
+        if (reader->format == 'p') 
+        {
+            copy_field(&record->header, &record->header_capacity, "", 0);
+            append_field(&record->sequence, &record->sequence_length, &record->sequence_capacity, reader->line);
+            return 1;
+        }
+
+        copy_field(&record->header, &record->header_capacity, reader->line + 1, strlen(reader->line + 1));
+
+        if (reader->format == '@') 
+        {
+            if (read_line(reader->file, &reader->line, &reader->line_capacity)) 
+            {
+                append_field(&record->sequence, &record->sequence_length, &record->sequence_capacity, reader->line);
+            }
+
+            read_line(reader->file, &reader->line, &reader->line_capacity);
+
+            if (read_line(reader->file, &reader->line, &reader->line_capacity)) 
+            {
+                copy_field(&record->quality, &record->quality_capacity, reader->line, strlen(reader->line));
+                record->has_quality = 1;
+            }
+
+            return 1;
+        }
+
+        while (read_line(reader->file, &reader->line, &reader->line_capacity)) 
+        {
+            if (reader->line[0] == '>') 
+            {
+                reader->pending = 1;
+                break;
+            }
+
+            append_field(&record->sequence, &record->sequence_length, &record->sequence_capacity, reader->line);
+        }
+
+        return 1;
+    }
+
+    return 0;
+}
+
+void write_sequence_record(buffered_writer *writer, const sequence_record *record, int format)
+{
+    if (format == '@') 
+    {
+        writer_write(writer, "@", 1);
+        writer_puts(writer, record->header);
+        writer_write(writer, "\n", 1);
+        writer_write(writer, record->sequence, record->sequence_length);
+        writer_write(writer, "\n+\n", 3);
+        writer_puts(writer, record->has_quality ? record->quality : "");
+        writer_write(writer, "\n", 1);
+    } 
+    else if (format == '>') 
+    {
+        writer_write(writer, ">", 1);
+        writer_puts(writer, record->header);
+        writer_write(writer, "\n", 1);
+        writer_write(writer, record->sequence, record->sequence_length);
+        writer_write(writer, "\n", 1);
+    } 
+    else 
+    {
+        writer_write(writer, record->sequence, record->sequence_length);
+        writer_write(writer, "\n", 1);
+    }
+}
+
+void free_sequence_record(sequence_record *record)
+{
+    free(record->header);
+    free(record->sequence);
+    free(record->quality);
+    memset(record, 0, sizeof(*record));
+}
+
+int encode_bases(const char *sequence, int length, uint64_t *code)
+{
+    *code = 0;
+
+    for (int i = 0; i < length; i++) 
+    {
+        int value = base_code(toupper(sequence[i]));
+
+        if (value < 0) 
+        {
+            return 0;
+        }
+
+        *code = (*code << 2) | (uint64_t)value;
+    }
+
+    return 1;
+}
+
+barcode_slot *barcode_table_find(const barcode_table *table, uint64_t code)
+{
+    size_t mask = table->capacity - 1;
+    size_t slot = mix64(code) & mask;
+
+    while (table->slots[slot].sample != -1) 
+    {
+        if (table->slots[slot].code == code) 
+        {
+            return &table->slots[slot];
+        }
+
+        slot = (slot + 1) & mask;
+    }
+
+    return &table->slots[slot];
+}
+
+void barcode_table_add(barcode_table *table, uint64_t code, int sample, int distance)
+{
+    barcode_slot *slot = barcode_table_find(table, code);
+
+    if (slot->sample == -1) 
+    {
+        slot->code = code;
+        slot->sample = sample;
+        slot->distance = distance;
+        return;
+    }
+
+    if (slot->distance < distance || slot->sample == sample) 
+    {
+        return;
+    }
+
+    if (slot->sample != -2) 
+    {
+        table->ambiguous_variants++;
+    }
+
+    slot->sample = -2;
+}
+
+void barcode_table_add_variants(barcode_table *table, uint64_t code, int sample, int distance, int from, int remaining)
+{
+    int length = table->barcode_length;
+
+    for (int pos = from; pos < length; pos++) 
+    {
+        int shift = 2 * (length - 1 - pos);
+        uint64_t original = (code >> shift) & 3;
+
+        for (uint64_t base = 0; base < 4; base++) 
+        {
+            if (base == original) 
+            {
+                continue;
+            }
+
+            uint64_t variant = (code & ~((uint64_t)3 << shift)) | (base << shift);
+
+            if (remaining == 1) 
+            {
+                barcode_table_add(table, variant, sample, distance + 1);
+            } 
+            else 
+            {
+                barcode_table_add_variants(table, variant, sample, distance + 1, pos + 1, remaining - 1);
+            }
+        }
+    }
+}
+
+int classify_barcode(const barcode_table *table, const char *sequence, size_t length)
+{
+    uint64_t code;
+
+    if ((int)length < table->barcode_length || !encode_bases(sequence, table->barcode_length, &code)) 
+    {
+        return -1;
+    }
+
+    const barcode_slot *slot = barcode_table_find(table, code);
+
+    return slot->sample;
+}
+
+void *demux_classify_worker(void *arg)
+{
+    demux_worker *worker = arg;
+
+    for (int i = worker->start; i < worker->end; i++) 
+    {
+        worker->assignments[i] = classify_barcode(worker->table, worker->records[i].sequence, worker->records[i].sequence_length);
+    }
+
+    return NULL;
+}
+
+int load_barcodes(const char *filename, char ***names, uint64_t **codes, int *length)
+{
+    FILE *file = fopen(filename, "r");
+
+    if (file == NULL) 
+    {
+        log_printf("Error: Could not open barcode file '%s'\n", filename);
+        return -1;
+    }
+
+    char *line = NULL;
+    size_t capacity = 0;
+    int count = 0;
+    int allocated = 0;
+
+    *names = NULL;
+    *codes = NULL;
+    *length = 0;
+
+    while (read_line(file, &line, &capacity)) 
+    {
+        char name[MAX_FILENAME_LENGTH];
+        char barcode[64];
+
+        if (line[0] == '#' || sscanf(line, "%255s %63s", name, barcode) != 2) 
+        {
+            continue;
+        }
+
+        int barcode_length = strlen(barcode);
+        uint64_t code;
+
+        if (barcode_length > MAX_KMER_SIZE || !encode_bases(barcode, barcode_length, &code)) 
+        {
+            log_printf("Error: Invalid barcode '%s' for sample '%s'\n", barcode, name);
+            count = -1;
+            break;
+        }
+
+        if (*length != 0 && barcode_length != *length) 
+        {
+            log_printf("Error: All barcodes must have the same length ('%s' has %d, expected %d)\n", barcode, barcode_length, *length);
+            count = -1;
+            break;
+        }
+
+        *length = barcode_length;
+
+        if (count == allocated) 
+        {
+            allocated = allocated == 0 ? 16 : allocated * 2;
+            *names = xrealloc(*names, sizeof(char *) * allocated);
+            *codes = xrealloc(*codes, sizeof(uint64_t) * allocated);
+        }
+
+        (*names)[count] = xmalloc(strlen(name) + 1);
+        strcpy((*names)[count], name);
+        (*codes)[count] = code;
+        count++;
+    }
+
+    free(line);
+    fclose(file);
+
+    if (count == 0) 
+    {
+        log_printf("Error: No barcodes found in '%s'\n", filename);
+        return -1;
+    }
+
+    return count;
+}
+
+int barcode_distance(uint64_t a, uint64_t b, int length)
+{
+    uint64_t x = a ^ b;
+    uint64_t low = length == 32 ? 0x5555555555555555ULL : (0x5555555555555555ULL & (((uint64_t)1 << (2 * length)) - 1));
+
+    return popcount64((x | (x >> 1)) & low);
+}
+
+void run_demux_mode(const options *config)
+{
+    char **names;
+    uint64_t *codes;
+    int barcode_length;
+    int sample_count = load_barcodes(config->demux_barcode_file, &names, &codes, &barcode_length);
+
+    if (sample_count < 0) 
+    {
+        return;
+    }
+
+    int mismatches = config->demux_mismatches;
+    size_t variants = (size_t)sample_count * (1 + 3 * barcode_length + (mismatches > 1 ? 9 * barcode_length * (barcode_length - 1) / 2 : 0));
+    barcode_table table;
+
+    table.capacity = 16;
+
+    while (table.capacity < variants * 2) 
+    {
+        table.capacity *= 2;
+    }
+
+    table.slots = xmalloc(sizeof(barcode_slot) * table.capacity);
+    table.barcode_length = barcode_length;
+    table.ambiguous_variants = 0;
+
+    for (size_t i = 0; i < table.capacity; i++) 
+    {
+        table.slots[i].sample = -1;
+    }
+
+    log_printf("\n=== Demultiplexing ===\n\n");
+
+    int collisions = 0;
+
+    for (int a = 0; a < sample_count; a++) 
+    {
+        for (int b = a + 1; b < sample_count; b++) 
+        {
+            int distance = barcode_distance(codes[a], codes[b], barcode_length);
+
+            if (distance <= 2 * mismatches) 
+            {
+                log_printf("Warning: Barcodes of '%s' and '%s' are %d mismatch(es) apart\n", names[a], names[b], distance);
+                collisions++;
+            }
+        }
+    }
+
+    for (int d = 0; d <= mismatches; d++) 
+    {
+        for (int s = 0; s < sample_count; s++) 
+        {
+            if (d == 0) 
+            {
+                barcode_table_add(&table, codes[s], s, 0);
+            } 
+            else 
+            {
+                barcode_table_add_variants(&table, codes[s], s, 0, 0, d);
+            }
+        }
+    }
+
+    size_t entries = 0;
+
+    for (size_t i = 0; i < table.capacity; i++) 
+    {
+        entries += table.slots[i].sample != -1;
+    }
+
+    record_reader reader;
+    const char *input = config->file_mode == 1 ? config->input_file : (config->do_fasta_input == 1 ? config->fasta_input_file : NULL);
+
+    if (!record_reader_open(&reader, input)) 
+    {
+        free(table.slots);
+        return;
+    }
+
+    int batch_size = 16384;
+    sequence_record *records = calloc(batch_size, sizeof(sequence_record));
+    int *assignments = xmalloc(sizeof(int) * batch_size);
+    buffered_writer *writers = xmalloc(sizeof(buffered_writer) * (sample_count + 1));
+    uint64_t *counts = calloc(sample_count + 2, sizeof(uint64_t));
+    int thread_count = config->thread_count > 0 ? config->thread_count : default_thread_count();
+    demux_worker *workers = xmalloc(sizeof(demux_worker) * thread_count);
+    int writers_open = 0;
+    int failed = 0;
+    uint64_t total = 0;
+
+    if (records == NULL || counts == NULL) 
+    {
+        fprintf(stderr, "Error: Out of memory.\n");
+        exit(1);
+    }
+
+    while (1) 
+    {
+        int count = 0;
+
+        while (count < batch_size && record_reader_next(&reader, &records[count])) 
+        {
+            count++;
+        }
+
+        if (count == 0) 
+        {
+            break;
+        }
+
+        if (!writers_open) 
+        {
+            const char *extension = reader.format == '@' ? "fastq" : (reader.format == '>' ? "fasta" : "txt");
+            char path[MAX_FILENAME_LENGTH * 2];
+
+            for (int s = 0; s <= sample_count; s++) 
+            {
+                snprintf(path, sizeof(path), "%s%s.%s", config->demux_prefix, s < sample_count ? names[s] : "undetermined", extension);
+
+                if (!writer_open(&writers[s], path, 1 << 18)) 
+                {
+                    for (int o = 0; o < s; o++) 
+                    {
+                        writer_close(&writers[o]);
+                    }
+
+                    failed = 1;
+                    break;
+                }
+            }
+
+            if (failed) 
+            {
+                break;
+            }
+
+            writers_open = 1;
+        }
+
+        int per_thread = (count + thread_count - 1) / thread_count;
+
+        for (int w = 0; w < thread_count; w++) 
+        {
+            workers[w].table = &table;
+            workers[w].records = records;
+            workers[w].assignments = assignments;
+            workers[w].start = w * per_thread < count ? w * per_thread : count;
+            workers[w].end = (w + 1) * per_thread < count ? (w + 1) * per_thread : count;
+        }
+
+        run_workers(thread_count, demux_classify_worker, workers, sizeof(demux_worker));
+
+        for (int i = 0; i < count; i++) 
+        {
+            int sample = assignments[i];
+            int target = sample >= 0 ? sample : sample_count;
+
+            counts[sample >= 0 ? sample : (sample == -2 ? sample_count + 1 : sample_count)]++;
+            write_sequence_record(&writers[target], &records[i], reader.format);
+        }
+
+        total += count;
+    }
+
+    if (!failed) 
+    {
+        if (writers_open) 
+        {
+            for (int s = 0; s <= sample_count; s++) 
+            {
+                writer_close(&writers[s]);
+            }
+        }
+
+        log_printf("Barcodes          : %d (length %d, up to %d mismatch(es))\n", sample_count, barcode_length, mismatches);
+        log_printf("Lookup entries    : %zu (%d ambiguous)\n", entries, table.ambiguous_variants);
+        log_printf("Barcode conflicts : %d\n", collisions);
+        log_printf("Reads             : %llu\n\n", (unsigned long long)total);
+
+        for (int s = 0; s < sample_count; s++) 
+        {
+            log_printf("%-20s %llu\n", names[s], (unsigned long long)counts[s]);
+        }
+
+        log_printf("%-20s %llu\n", "undetermined", (unsigned long long)(counts[sample_count] + counts[sample_count + 1]));
+        log_printf("%-20s %llu\n\n", "  (ambiguous)", (unsigned long long)counts[sample_count + 1]);
+    }
+
+    for (int i = 0; i < batch_size; i++) 
+    {
+        free_sequence_record(&records[i]);
+    }
+
+    for (int s = 0; s < sample_count; s++) 
+    {
+        free(names[s]);
+    }
+
+    free(records);
+    free(assignments);
+    free(writers);
+    free(counts);
+    free(workers);
+    free(names);
+    free(codes);
+    free(table.slots);
+    record_reader_close(&reader);
+}
+
+typedef struct {
+    char *raw;
+    char *clean;
+    char *work;
+    int block_count;
+    int64_t bases;
+    uint64_t sink;
+    scratch_arena scratch;
+    char input_path[MAX_FILENAME_LENGTH];
+    char output_path[MAX_FILENAME_LENGTH];
+} bench_context;
+
+typedef struct {
+    const char *name;
+    int uses_work;
+    void (*kernel)(bench_context *);
+} bench_case;
+
+typedef struct {
+    const char *name;
+    int64_t bytes;
+    int64_t min_ns;
+    int64_t p50_ns;
+    int64_t p90_ns;
+    int64_t p99_ns;
+    int64_t max_ns;
+    double mean_ns;
+} bench_result;
+
+void bench_clean(bench_context *ctx)
+{
+    for (int b = 0; b < ctx->block_count; b++) 
+    {
+        clean_sequence(ctx->work + (size_t)b * MAX_DNA_LENGTH);
+    }
+}
+
+void bench_count(bench_context *ctx)
+{
+    for (int b = 0; b < ctx->block_count; b++) 
+    {
+        int a, c, g, t;
+
+        count_bases(ctx->clean + (size_t)b * MAX_DNA_LENGTH, &a, &c, &g, &t);
+        ctx->sink += a + c + g + t;
+    }
+}
+
+void bench_complement(bench_context *ctx)
+{
+    for (int b = 0; b < ctx->block_count; b++) 
+    {
+        make_complement(ctx->work + (size_t)b * MAX_DNA_LENGTH);
+    }
+}
+
+void bench_reverse_complement(bench_context *ctx)
+{
+    for (int b = 0; b < ctx->block_count; b++) 
+    {
+        reverse_complement_sequence(ctx->work + (size_t)b * MAX_DNA_LENGTH);
+    }
+}
+
+void bench_find(bench_context *ctx)
+{
+    for (int b = 0; b < ctx->block_count; b++) 
+    {
+        find_pattern(ctx->clean + (size_t)b * MAX_DNA_LENGTH, "GATTACA", 0);
+    }
+}
+
+void bench_orf(bench_context *ctx)
+{
+    for (int b = 0; b < ctx->block_count; b++) 
+    {
+        find_orfs(ctx->clean + (size_t)b * MAX_DNA_LENGTH, &ctx->scratch);
+        arena_reset(&ctx->scratch);
+    }
+}
+
+void bench_translate(bench_context *ctx)
+{
+    for (int b = 0; b < ctx->block_count; b++) 
+    {
+        translate_sequence(ctx->clean + (size_t)b * MAX_DNA_LENGTH, &ctx->scratch);
+        arena_reset(&ctx->scratch);
+    }
+}
+
+void bench_compress(bench_context *ctx)
+{
+    char compressed[MAX_COMPRESSED_LENGTH];
+
+    for (int b = 0; b < ctx->block_count; b++) 
+    {
+        compress_sequence(ctx->clean + (size_t)b * MAX_DNA_LENGTH, compressed);
+        ctx->sink += (unsigned char)compressed[0];
+    }
+}
+
+void bench_key(bench_context *ctx)
+{
+    unsigned char key[KEY_SIZE];
+
+    for (int b = 0; b < ctx->block_count; b++) 
+    {
+        derive_key_bytes(ctx->clean + (size_t)b * MAX_DNA_LENGTH, key);
+        ctx->sink += key[0];
+    }
+}
+
+void bench_hash(bench_context *ctx)
+{
+    for (int b = 0; b < ctx->block_count; b++) 
+    {
+        derive_hash(ctx->clean + (size_t)b * MAX_DNA_LENGTH);
+    }
+}
+
+void bench_encrypt_file(bench_context *ctx)
+{
+    encrypt_file(ctx->clean, ctx->input_path, ctx->output_path);
+}
+
+int compare_i64(const void *a, const void *b)
+{
+    int64_t x = *(const int64_t *)a;
+    int64_t y = *(const int64_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+int64_t percentile_ns(const int64_t *sorted, int count, int percent)
+{
+    int rank = (int)ceil(count * percent / 100.0);
+
+    return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+void bench_generate_input(bench_context *ctx, int64_t bases)
+{
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+    const char *alphabet = "ACGT";
+
+    ctx->block_count = (int)((bases + MAX_DNA_LENGTH - 2) / (MAX_DNA_LENGTH - 1));
+    ctx->bases = bases;
+    ctx->raw = xmalloc((size_t)ctx->block_count * MAX_DNA_LENGTH);
+    ctx->clean = xmalloc((size_t)ctx->block_count * MAX_DNA_LENGTH);
+    ctx->work = xmalloc((size_t)ctx->block_count * MAX_DNA_LENGTH);
+
+    for (int b = 0; b < ctx->block_count; b++) 
+    {
+        char *block = ctx->raw + (size_t)b * MAX_DNA_LENGTH;
+        int64_t remaining = bases - (int64_t)b * (MAX_DNA_LENGTH - 1);
+        int length = remaining < MAX_DNA_LENGTH - 1 ? (int)remaining : MAX_DNA_LENGTH - 1;
+
+        for (int i = 0; i < length; i++) 
+        {
+            state = mix64(state + 0x9E3779B97F4A7C15ULL);
+
+            char base = alphabet[state & 3];
+            int noise = (int)((state >> 8) & 1023);
+
+            if (noise < 10) 
+            {
+                base = tolower(base);
+            }
+            else if (noise < 12) 
+            {
+                base = 'N';
+            }
+
+            block[i] = base;
+        }
+
+        block[length] = '\0';
+    }
+
+    memcpy(ctx->clean, ctx->raw, (size_t)ctx->block_count * MAX_DNA_LENGTH);
+
+    for (int b = 0; b < ctx->block_count; b++) 
+    {
+        clean_sequence(ctx->clean + (size_t)b * MAX_DNA_LENGTH);
+    }
+}
+
+int bench_write_file(const char *path, const bench_context *ctx)
+{
+    FILE *file = fopen(path, "wb");
+
+    if (file == NULL) 
+    {
+        log_printf("Error: Could not open output file '%s'\n", path);
+        return 0;
+    }
+
+    int64_t written = 0;
+
+    while (written < ctx->bases) 
+    {
+        int64_t chunk = ctx->bases - written < MAX_DNA_LENGTH - 1 ? ctx->bases - written : MAX_DNA_LENGTH - 1;
+
+        fwrite(ctx->raw + (size_t)(written / (MAX_DNA_LENGTH - 1)) * MAX_DNA_LENGTH, 1, (size_t)chunk, file);
+        written += chunk;
+    }
+
+    fclose(file);
+
+    return 1;
+}
+
+void write_bench_json(FILE *out, const options *config, const bench_result *results, int count, int64_t bases)
+{
+    fprintf(out, "{\n");
+    fprintf(out, "  \"version\": \"%s\",\n", PROGRAM_VERSION);
+    fprintf(out, "  \"bases\": %lld,\n", (long long)bases);
+    fprintf(out, "  \"block_size\": %d,\n", MAX_DNA_LENGTH - 1);
+    fprintf(out, "  \"repetitions\": %d,\n", config->bench_reps);
+    fprintf(out, "  \"peak_rss_kb\": %lld,\n", (long long)peak_rss_kb());
+    fprintf(out, "  \"benchmarks\": [\n");
+
+    for (int i = 0; i < count; i++) 
+    {
+        const bench_result *r = &results[i];
+        double seconds = r->p50_ns / 1e9;
+
+        fprintf(out, "    {\"name\": \"%s\", \"bytes\": %lld, \"min_ns\": %lld, \"p50_ns\": %lld, \"p90_ns\": %lld, \"p99_ns\": %lld, \"max_ns\": %lld, \"mean_ns\": %.1f, \"ns_per_base\": %.4f, \"gb_per_s\": %.4f}%s\n",
+            r->name, (long long)r->bytes, (long long)r->min_ns, (long long)r->p50_ns, (long long)r->p90_ns, (long long)r->p99_ns, (long long)r->max_ns, r->mean_ns,
+            (double)r->p50_ns / r->bytes, seconds > 0 ? r->bytes / seconds / 1e9 : 0.0, i + 1 < count ? "," : "");
+    }
+
+    fprintf(out, "  ]\n");
+    fprintf(out, "}\n");
+}
+
+void run_bench_suite(const options *config)
+{
+    static const bench_case cases[] = {
+        { "clean", 1, bench_clean },
+        { "count", 0, bench_count },
+        { "complement", 1, bench_complement },
+        { "reverse_complement", 1, bench_reverse_complement },
+        { "find", 0, bench_find },
+        { "orf", 0, bench_orf },
+        { "translate", 0, bench_translate },
+        { "compress", 0, bench_compress },
+        { "key", 0, bench_key },
+        { "hash", 0, bench_hash },
+        { "encrypt_file", 0, bench_encrypt_file }
+    };
+    int case_count = sizeof(cases) / sizeof(cases[0]);
+    bench_context ctx;
+    bench_result results[sizeof(cases) / sizeof(cases[0])];
+    int64_t *samples = xmalloc(sizeof(int64_t) * config->bench_reps);
+
+    memset(&ctx, 0, sizeof(ctx));
+    bench_generate_input(&ctx, config->bench_size);
+    snprintf(ctx.input_path, sizeof(ctx.input_path), "dnashield_bench.in");
+    snprintf(ctx.output_path, sizeof(ctx.output_path), "dnashield_bench.out");
+
+    int result_count = 0;
+    int have_file = bench_write_file(ctx.input_path, &ctx);
+
+    for (int c = 0; c < case_count; c++) 
+    {
+        const bench_case *bench = &cases[c];
+        if (bench->kernel == bench_encrypt_file && !have_file) 
+        {
+            continue;
+        }
+
+        bench_result *r = &results[result_count++];
+
+        r->name = bench->name;
+        r->bytes = ctx.bases;
+
+        for (int rep = -1; rep < config->bench_reps; rep++) 
+        {
+            if (bench->uses_work) 
+            {
+                memcpy(ctx.work, bench->kernel == bench_clean ? ctx.raw : ctx.clean, (size_t)ctx.block_count * MAX_DNA_LENGTH);
+            }
+
+            log_muted = 1;
+
+            int64_t start = now_ns();
+
+            bench->kernel(&ctx);
+
+            int64_t elapsed = now_ns() - start;
+
+            log_muted = 0;
+
+            if (rep >= 0) 
+            {
+                samples[rep] = elapsed;
+            }
+        }
+
+        qsort(samples, config->bench_reps, sizeof(int64_t), compare_i64);
+
+        double total = 0;
+
+        for (int rep = 0; rep < config->bench_reps; rep++) 
+        {
+            total += samples[rep];
+        }
+
+        r->min_ns = samples[0];
+        r->p50_ns = percentile_ns(samples, config->bench_reps, 50);
+        r->p90_ns = percentile_ns(samples, config->bench_reps, 90);
+        r->p99_ns = percentile_ns(samples, config->bench_reps, 99);
+        r->max_ns = samples[config->bench_reps - 1];
+        r->mean_ns = total / config->bench_reps;
+    }
+
+    remove(ctx.input_path);
+    remove(ctx.output_path);
+
+    if (config->bench_output_file[0] != '\0') 
+    {
+        FILE *out = fopen(config->bench_output_file, "w");
+
+        if (out == NULL) 
+        {
+            log_printf("Error: Could not open output file '%s'\n", config->bench_output_file);
+        }
+        else 
+        {
+            write_bench_json(out, config, results, result_count, ctx.bases);
+            fclose(out);
+        }
+
+        log_printf("\n=== Benchmark Suite ===\n\n");
+        log_printf("Input: %lld bases in %d blocks, %d repetitions\n\n", (long long)ctx.bases, ctx.block_count, config->bench_reps);
+        log_printf("%-20s %12s %12s %10s %10s\n", "Kernel", "p50 (ms)", "p99 (ms)", "ns/base", "GB/s");
+
+        for (int c = 0; c < result_count; c++) 
+        {
+            double seconds = results[c].p50_ns / 1e9;
+
+            log_printf("%-20s %12.3f %12.3f %10.3f %10.3f\n", results[c].name, results[c].p50_ns / 1e6, results[c].p99_ns / 1e6,
+                (double)results[c].p50_ns / results[c].bytes, seconds > 0 ? results[c].bytes / seconds / 1e9 : 0.0);
+        }
+
+        log_printf("\nPeak RSS: %lld KB\n", (long long)peak_rss_kb());
+        log_printf("Results written to %s\n\n", config->bench_output_file);
+    }
+    else 
+    {
+        write_bench_json(stdout, config, results, result_count, ctx.bases);
+    }
+
+    free(samples);
+    free(ctx.raw);
+    free(ctx.clean);
+    free(ctx.work);
+    arena_free(&ctx.scratch);
+}
+
+typedef struct {
+    rng_state rng;
+    int64_t bases;
+    char *raw;
+    char *text;
+    size_t text_length;
+} random_chunk_job;
+
+void *random_chunk_worker(void *arg)
+{
+    random_chunk_job *job = arg;
+    size_t out = 0;
+
+    rng_fill_bases(&job->rng, job->raw, job->bases);
+
+    for (int64_t i = 0; i < job->bases; i += FASTA_LINE_WIDTH) 
+    {
+        int64_t line = job->bases - i < FASTA_LINE_WIDTH ? job->bases - i : FASTA_LINE_WIDTH;
+
+        memcpy(job->text + out, job->raw + i, (size_t)line);
+        out += line;
+        job->text[out++] = '\n';
+    }
+
+    job->text_length = out;
+
+    return NULL;
+}
+
+void run_random_output_mode(const options *config)
+{
+    int to_stdout = strcmp(config->random_output_file, "-") == 0;
+    FILE *out = to_stdout ? stdout : fopen(config->random_output_file, "wb");
+
+    if (out == NULL) 
+    {
+        log_printf("Error: Could not open output file '%s'\n", config->random_output_file);
+        return;
+    }
+
+    int thread_count = config->thread_count > 0 ? config->thread_count : default_thread_count();
+    random_chunk_job *jobs = xmalloc(sizeof(random_chunk_job) * thread_count);
+    rng_state stream = global_rng;
+    int64_t remaining = config->random_length;
+    int64_t start = now_ns();
+
+    for (int t = 0; t < thread_count; t++) 
+    {
+        jobs[t].raw = xmalloc(RANDOM_CHUNK_BASES);
+        jobs[t].text = xmalloc(RANDOM_CHUNK_BASES + RANDOM_CHUNK_BASES / FASTA_LINE_WIDTH + 1);
+    }
+
+    fprintf(out, ">random length=%lld seed=%llu\n", (long long)config->random_length, (unsigned long long)config->seed);
+
+    while (remaining > 0) 
+    {
+        int active = 0;
+
+        while (active < thread_count && remaining > 0) 
+        {
+            jobs[active].rng = stream;
+            jobs[active].bases = remaining < RANDOM_CHUNK_BASES ? remaining : RANDOM_CHUNK_BASES;
+            remaining -= jobs[active].bases;
+            rng_jump(&stream);
+            active++;
+        }
+
+        run_workers(active, random_chunk_worker, jobs, sizeof(random_chunk_job));
+
+        for (int t = 0; t < active; t++) 
+        {
+            fwrite(jobs[t].text, 1, jobs[t].text_length, out);
+        }
+    }
+
+    if (to_stdout) 
+    {
+        fflush(out);
+    }
+    else 
+    {
+        fclose(out);
+
+        log_printf("\n=== Random Sequence ===\n\n");
+        log_printf("Length : %lld bases\n", (long long)config->random_length);
+        log_printf("Seed   : %llu\n", (unsigned long long)config->seed);
+        log_printf("Output : %s\n", config->random_output_file);
+        log_printf("Time   : %.3f seconds\n\n", (now_ns() - start) / 1e9);
+    }
+
+    for (int t = 0; t < thread_count; t++) 
+    {
+        free(jobs[t].raw);
+        free(jobs[t].text);
+    }
+
+    free(jobs);
+}
+
+typedef struct {
+    char **names;
+    char **sequences;
+    int64_t *lengths;
+    int64_t *cumulative;
+    int count;
+    int64_t usable;
+    int max_name_length;
+} reference_set;
+
+typedef struct {
+    int length;
+    char *quality;
+    uint32_t *error_threshold;
+} error_profile;
+
+typedef struct {
+    const reference_set *reference;
+    const error_profile *profile;
+    const options *config;
+    rng_state rng;
+    int64_t first_read;
+    int count;
+    char *text1;
+    char *text2;
+    size_t length1;
+    size_t length2;
+    char *fragment;
+} read_sim_job;
+
+int load_reference_set(const char *filename, reference_set *set, int64_t min_length)
+{
+    fasta_reader reader;
+    int allocated = 0;
+
+    memset(set, 0, sizeof(*set));
+
+    if (!fasta_reader_open(&reader, filename)) 
+    {
+        return 0;
+    }
+
+    while (1) 
+    {
+        char *sequence = NULL;
+        int64_t capacity = 0;
+        int64_t length;
+
+        if (!fasta_read_record(&reader, &sequence, &capacity, &length)) 
+        {
+            free(sequence);
+            break;
+        }
+
+        if (set->count == allocated) 
+        {
+            allocated = allocated == 0 ? 16 : allocated * 2;
+            set->names = xrealloc(set->names, sizeof(char *) * allocated);
+            set->sequences = xrealloc(set->sequences, sizeof(char *) * allocated);
+            set->lengths = xrealloc(set->lengths, sizeof(int64_t) * allocated);
+            set->cumulative = xrealloc(set->cumulative, sizeof(int64_t) * allocated);
+        }
+
+        int name_length = strcspn(reader.name, " \t");
+
+        set->names[set->count] = xmalloc(name_length + 1);
+        memcpy(set->names[set->count], reader.name, name_length);
+        set->names[set->count][name_length] = '\0';
+        set->sequences[set->count] = sequence;
+        set->lengths[set->count] = length;
+
+        if (length >= min_length) 
+        {
+            set->usable += length - min_length + 1;
+        }
+
+        set->cumulative[set->count] = set->usable;
+
+        if (name_length > set->max_name_length) 
+        {
+            set->max_name_length = name_length;
+        }
+
+        set->count++;
+    }
+
+    fasta_reader_close(&reader);
+
+    return set->count > 0;
+}
+
+void free_reference_set(reference_set *set)
+{
+    for (int i = 0; i < set->count; i++) 
+    {
+        free(set->names[i]);
+        free(set->sequences[i]);
+    }
+
+    free(set->names);
+    free(set->sequences);
+    free(set->lengths);
+    free(set->cumulative);
+}
+
+int build_error_profile(error_profile *profile, const options *config)
+{
+    int length = config->read_length;
+    double *rates = xmalloc(sizeof(double) * length);
+
+    for (int i = 0; i < length; i++) 
+    {
+        rates[i] = length > 1 ? config->error_start + (config->error_end - config->error_start) * i / (length - 1) : config->error_start;
+    }
+
+    if (config->error_profile_file[0] != '\0') 
+    {
+        FILE *file = fopen(config->error_profile_file, "r");
+
+        if (file == NULL) 
+        {
+            log_printf("Error: Could not open error profile '%s'\n", config->error_profile_file);
+            free(rates);
+            return 0;
+        }
+
+        double rate = config->error_end;
+        int read = 0;
+
+        while (read < length && fscanf(file, "%lf", &rate) == 1) 
+        {
+            rates[read++] = rate;
+        }
+
+        for (int i = read; i < length; i++) 
+        {
+            rates[i] = rate;
+        }
+
+        fclose(file);
+    }
+
+    profile->length = length;
+    profile->quality = xmalloc(length + 1);
+    profile->error_threshold = xmalloc(sizeof(uint32_t) * length);
+
+    for (int i = 0; i < length; i++) 
+    {
+        double rate = rates[i] < 0 ? 0 : (rates[i] > 0.75 ? 0.75 : rates[i]);
+        int quality = rate > 0 ? (int)lround(-10.0 * log10(rate)) : 41;
+
+        quality = quality < 2 ? 2 : (quality > 41 ? 41 : quality);
+        profile->quality[i] = (char)(33 + quality);
+        profile->error_threshold[i] = (uint32_t)(rate * 4294967295.0);
+    }
+
+    profile->quality[length] = '\0';
+    free(rates);
+
+    return 1;
+}
+
+size_t emit_fastq_read(char *out, int64_t index, int mate, const char *contig, int64_t position, char strand, const char *bases, int length, const error_profile *profile, rng_state *rng)
+{
+    size_t used = 0;
+    uint64_t draw = 0;
+
+    if (mate > 0) 
+    {
+        used += sprintf(out, "@sim.%lld %s:%lld:%c/%d\n", (long long)index, contig, (long long)position + 1, strand, mate);
+    }
+    else 
+    {
+        used += sprintf(out, "@sim.%lld %s:%lld:%c\n", (long long)index, contig, (long long)position + 1, strand);
+    }
+
+    for (int i = 0; i < length; i++) 
+    {
+        if ((i & 1) == 0) 
+        {
+            draw = rng_next(rng);
+        }
+
+        uint32_t value = (uint32_t)(draw >> (32 * (i & 1)));
+        char base = bases[i];
+
+        out[used + i] = value < profile->error_threshold[i] && is_valid_base(base) ? random_base_from(rng, base) : base;
+    }
+
+    used += length;
+    memcpy(out + used, "\n+\n", 3);
+    used += 3;
+    memcpy(out + used, profile->quality, length);
+    used += length;
+    out[used++] = '\n';
+
+    return used;
+}
+
+void *read_sim_worker(void *arg)
+{
+    read_sim_job *job = arg;
+    const reference_set *reference = job->reference;
+    const options *config = job->config;
+    int read_length = config->read_length;
+    int64_t max_fragment = (int64_t)config->fragment_size + 4 * (int64_t)config->fragment_sd;
+
+    job->length1 = 0;
+    job->length2 = 0;
+
+    for (int r = 0; r < job->count; r++) 
+    {
+        int64_t fragment_length = read_length;
+
+        if (config->paired) 
+        {
+            double u1 = rng_uniform(&job->rng);
+            double u2 = rng_uniform(&job->rng);
+            double normal = sqrt(-2.0 * log(u1)) * cos(6.283185307179586 * u2);
+
+            fragment_length = (int64_t)llround(config->fragment_size + config->fragment_sd * normal);
+
+            if (fragment_length < read_length) 
+            {
+                fragment_length = read_length;
+            }
+
+            if (fragment_length > max_fragment) 
+            {
+                fragment_length = max_fragment;
+            }
+        }
+
+        int64_t pick = (int64_t)rng_below(&job->rng, (uint64_t)reference->usable);
+        int lo = 0;
+        int hi = reference->count - 1;
+
+        while (lo < hi) 
+        {
+            int mid = (lo + hi) / 2;
+
+            if (reference->cumulative[mid] > pick) 
+            {
+                hi = mid;
+            }
+            else 
+            {
+                lo = mid + 1;
+            }
+        }
+
+        int64_t contig_length = reference->lengths[lo];
+        int64_t offset = pick - (lo > 0 ? reference->cumulative[lo - 1] : 0);
+
+        if (fragment_length > contig_length) 
+        {
+            fragment_length = contig_length;
+        }
+
+        if (offset + fragment_length > contig_length) 
+        {
+            offset = contig_length - fragment_length;
+        }
+
+        const char *source = reference->sequences[lo] + offset;
+        int reverse = (int)(rng_next(&job->rng) & 1);
+        char strand = reverse ? '-' : '+';
+        int64_t index = job->first_read + r;
+
+        memcpy(job->fragment, source, (size_t)fragment_length);
+        job->fragment[fragment_length] = '\0';
+
+        if (reverse) 
+        {
+            reverse_complement_sequence(job->fragment);
+        }
+
+        if (!config->paired) 
+        {
+            job->length1 += emit_fastq_read(job->text1 + job->length1, index, 0, reference->names[lo], offset, strand, job->fragment, read_length, job->profile, &job->rng);
+            continue;
+        }
+
+        job->length1 += emit_fastq_read(job->text1 + job->length1, index, 1, reference->names[lo], offset, strand, job->fragment, read_length, job->profile, &job->rng);
+        reverse_complement_sequence(job->fragment);
+        job->length2 += emit_fastq_read(job->text2 + job->length2, index, 2, reference->names[lo], offset, strand, job->fragment, read_length, job->profile, &job->rng);
+    }
+
+    return NULL;
+}
+
+void run_simulate_reads_mode(const options *config)
+{
+    reference_set reference;
+    error_profile profile;
+    const char *input = config->do_fasta_input == 1 ? config->fasta_input_file : (config->file_mode == 1 ? config->input_file : NULL);
+    int64_t min_length = config->paired ? config->fragment_size : config->read_length;
+
+    if (config->paired && config->fragment_size < config->read_length) 
+    {
+        log_printf("Error: Fragment size must be at least the read length (%d)\n", config->read_length);
+        return;
+    }
+
+    if (!load_reference_set(input, &reference, min_length)) 
+    {
+        log_printf("Error: No reference sequence could be read\n");
+        return;
+    }
+
+    if (reference.usable == 0) 
+    {
+        log_printf("Error: No reference record is at least %lld bases long\n", (long long)min_length);
+        free_reference_set(&reference);
+        return;
+    }
+
+    if (!build_error_profile(&profile, config)) 
+    {
+        free_reference_set(&reference);
+        return;
+    }
+
+    char path1[MAX_FILENAME_LENGTH + 16];
+    char path2[MAX_FILENAME_LENGTH + 16];
+
+    snprintf(path1, sizeof(path1), config->paired ? "%s_1.fastq" : "%s.fastq", config->reads_prefix);
+    snprintf(path2, sizeof(path2), "%s_2.fastq", config->reads_prefix);
+
+    FILE *out1 = fopen(path1, "wb");
+    FILE *out2 = config->paired ? fopen(path2, "wb") : NULL;
+
+    if (out1 == NULL || (config->paired && out2 == NULL)) 
+    {
+        log_printf("Error: Could not open output file '%s'\n", out1 == NULL ? path1 : path2);
+
+        if (out1 != NULL) 
+        {
+            fclose(out1);
+        }
+
+        free(profile.quality);
+        free(profile.error_threshold);
+        free_reference_set(&reference);
+        return;
+    }
+
+    int thread_count = config->thread_count > 0 ? config->thread_count : default_thread_count();
+    size_t per_read = 2 * (size_t)config->read_length + reference.max_name_length + 96;
+    read_sim_job *jobs = xmalloc(sizeof(read_sim_job) * thread_count);
+    rng_state stream = global_rng;
+    int64_t next_read = 0;
+    int64_t start = now_ns();
+
+    for (int t = 0; t < thread_count; t++) 
+    {
+        jobs[t].reference = &reference;
+        jobs[t].profile = &profile;
+        jobs[t].config = config;
+        jobs[t].text1 = xmalloc(per_read * SIM_READS_PER_JOB);
+        jobs[t].text2 = config->paired ? xmalloc(per_read * SIM_READS_PER_JOB) : NULL;
+        jobs[t].fragment = xmalloc((size_t)min_length + 4 * (size_t)config->fragment_sd + 1);
+    }
+
+    while (next_read < config->simulate_reads) 
+    {
+        int active = 0;
+
+        while (active < thread_count && next_read < config->simulate_reads) 
+        {
+            int64_t left = config->simulate_reads - next_read;
+
+            jobs[active].rng = stream;
+            jobs[active].first_read = next_read;
+            jobs[active].count = left < SIM_READS_PER_JOB ? (int)left : SIM_READS_PER_JOB;
+            next_read += jobs[active].count;
+            rng_jump(&stream);
+            active++;
+        }
+
+        run_workers(active, read_sim_worker, jobs, sizeof(read_sim_job));
+
+        for (int t = 0; t < active; t++) 
+        {
+            fwrite(jobs[t].text1, 1, jobs[t].length1, out1);
+
+            if (out2 != NULL) 
+            {
+                fwrite(jobs[t].text2, 1, jobs[t].length2, out2);
+            }
+        }
+    }
+
+    fclose(out1);
+
+    if (out2 != NULL) 
+    {
+        fclose(out2);
+    }
+
+    double seconds = (now_ns() - start) / 1e9;
+
+    log_printf("\n=== Read Simulation ===\n\n");
+    log_printf("Reference   : %d record(s), %lld usable start positions\n", reference.count, (long long)reference.usable);
+    log_printf("Reads       : %lld x %d bp%s\n", (long long)config->simulate_reads, config->read_length, config->paired ? " (paired)" : "");
+
+    if (config->paired) 
+    {
+        log_printf("Fragments   : %d +/- %d bp\n", config->fragment_size, config->fragment_sd);
+    }
+
+    log_printf("Seed        : %llu\n", (unsigned long long)config->seed);
+    log_printf("Output      : %s%s%s\n", path1, config->paired ? ", " : "", config->paired ? path2 : "");
+    log_printf("Time        : %.3f seconds (%.0f reads/s)\n\n", seconds, seconds > 0 ? config->simulate_reads / seconds : 0.0);
+
+    for (int t = 0; t < thread_count; t++) 
+    {
+        free(jobs[t].text1);
+        free(jobs[t].text2);
+        free(jobs[t].fragment);
+    }
+
+    free(jobs);
+    free(profile.quality);
+    free(profile.error_threshold);
+    free_reference_set(&reference);
+}
+
+typedef struct {
+    int64_t counts[5];
+    int64_t low;
+    int64_t high;
+} window_counts;
+
+void window_slide(window_counts *window, const unsigned char *sequence, const unsigned char *index, int64_t start, int64_t end)
+{
+    if (start >= window->high) 
+    {
+        memset(window->counts, 0, sizeof(window->counts));
+        window->low = start;
+        window->high = start;
+    }
+
+    while (window->high < end) 
+    {
+        window->counts[index[sequence[window->high++]]]++;
+    }
+
+    while (window->low < start) 
+    {
+        window->counts[index[sequence[window->low++]]]--;
+    }
+}
+
+void text_append_fixed(text_buffer *buffer, double value, int decimals)
+{
+    int64_t scale = 1;
+
+    for (int d = 0; d < decimals; d++) 
+    {
+        scale *= 10;
+    }
+
+    int64_t scaled = llround(value * scale);
+
+    if (scaled < 0) 
+    {
+        text_append(buffer, "-", 1);
+        scaled = -scaled;
+    }
+
+    text_append_int(buffer, scaled / scale);
+    text_append(buffer, ".", 1);
+
+    int64_t fraction = scaled % scale;
+
+    for (int64_t place = scale / 10; place > 0; place /= 10) 
+    {
+        text_reserve(buffer, 1);
+        buffer->data[buffer->length++] = (char)('0' + fraction / place % 10);
+    }
+}
+
+void window_append_row(text_buffer *buffer, const char *name, int name_length, int64_t start, int64_t end, double value, int decimals)
+{
+    text_append(buffer, name, name_length);
+    text_append(buffer, "\t", 1);
+    text_append_int(buffer, start);
+    text_append(buffer, "\t", 1);
+    text_append_int(buffer, end);
+    text_append(buffer, "\t", 1);
+    text_append_fixed(buffer, value, decimals);
+    text_append(buffer, "\n", 1);
+}
+
+int64_t write_window_profile(FILE **out, const char *name, const char *sequence, int64_t length, int64_t size, int64_t step, const double *plogp)
+{
+    unsigned char index[256];
+    window_counts window;
+    text_buffer rows[3];
+    int name_length = strlen(name);
+    int64_t written = 0;
+
+    memset(index, 4, sizeof(index));
+    index['A'] = 0;
+    index['C'] = 1;
+    index['G'] = 2;
+    index['T'] = 3;
+    memset(&window, 0, sizeof(window));
+    memset(rows, 0, sizeof(rows));
+
+    for (int64_t start = 0; start < length; start += step) 
+    {
+        int64_t end = start + size < length ? start + size : length;
+
+        window_slide(&window, (const unsigned char *)sequence, index, start, end);
+
+        int64_t a = window.counts[0];
+        int64_t c = window.counts[1];
+        int64_t g = window.counts[2];
+        int64_t t = window.counts[3];
+        int64_t total = a + c + g + t;
+
+        if (total > 0) 
+        {
+            double entropy = (plogp[total] - plogp[a] - plogp[c] - plogp[g] - plogp[t]) / total;
+            double skew = g + c > 0 ? (double)(g - c) / (g + c) : 0.0;
+
+            window_append_row(&rows[0], name, name_length, start, end, 100.0 * (g + c) / total, 2);
+            window_append_row(&rows[1], name, name_length, start, end, entropy, 4);
+            window_append_row(&rows[2], name, name_length, start, end, skew, 4);
+            written++;
+        }
+
+        if (rows[0].length >= (1 << 20) || end == length) 
+        {
+            for (int m = 0; m < 3; m++) 
+            {
+                fwrite(rows[m].data, 1, rows[m].length, out[m]);
+                rows[m].length = 0;
+            }
+        }
+
+        if (end == length) 
+        {
+            break;
+        }
+    }
+
+    for (int m = 0; m < 3; m++) 
+    {
+        free(rows[m].data);
+    }
+
+    return written;
+}
+
+void run_window_mode(const options *config)
+{
+    static const char *metrics[3] = { "gc", "entropy", "skew" };
+    const char *input = config->do_fasta_input == 1 ? config->fasta_input_file : (config->file_mode == 1 ? config->input_file : NULL);
+    int64_t step = config->window_step > 0 ? config->window_step : config->window_size;
+    char paths[3][MAX_FILENAME_LENGTH + 32];
+    FILE *out[3] = { NULL, NULL, NULL };
+    fasta_reader reader;
+
+    for (int m = 0; m < 3; m++) 
+    {
+        snprintf(paths[m], sizeof(paths[m]), "%s.%s.bedgraph", config->window_prefix, metrics[m]);
+        out[m] = fopen(paths[m], "w");
+
+        if (out[m] == NULL) 
+        {
+            log_printf("Error: Could not open output file '%s'\n", paths[m]);
+
+            for (int k = 0; k < m; k++) 
+            {
+                fclose(out[k]);
+            }
+
+            return;
+        }
+
+        fprintf(out[m], "track type=bedGraph name=\"%s\" description=\"%s, window %lld step %lld\"\n", metrics[m], metrics[m], (long long)config->window_size, (long long)step);
+    }
+
+    if (!fasta_reader_open_record(&reader, input, config->fasta_record)) 
+    {
+        for (int m = 0; m < 3; m++) 
+        {
+            fclose(out[m]);
+        }
+
+        return;
+    }
+
+    double *plogp = xmalloc(sizeof(double) * (config->window_size + 1));
+    char *sequence = NULL;
+    int64_t capacity = 0;
+    int64_t length;
+    int64_t total_bases = 0;
+    int64_t windows = 0;
+    int records = 0;
+    int64_t start = now_ns();
+
+    plogp[0] = 0.0;
+
+    for (int64_t n = 1; n <= config->window_size; n++) 
+    {
+        plogp[n] = n * log2((double)n);
+    }
+
+    while (fasta_read_record(&reader, &sequence, &capacity, &length)) 
+    {
+        char name[MAX_FILENAME_LENGTH];
+        int name_length = strcspn(reader.name, " \t");
+
+        memcpy(name, reader.name, name_length);
+        name[name_length] = '\0';
+        windows += write_window_profile(out, name, sequence, length, config->window_size, step, plogp);
+        total_bases += length;
+        records++;
+    }
+
+    double seconds = (now_ns() - start) / 1e9;
+
+    fasta_reader_close(&reader);
+    free(sequence);
+    free(plogp);
+
+    for (int m = 0; m < 3; m++) 
+    {
+        fclose(out[m]);
+    }
+
+    log_printf("\n=== Window Profile ===\n\n");
+    log_printf("Records     : %d (%lld bases)\n", records, (long long)total_bases);
+    log_printf("Window      : %lld bp, step %lld bp\n", (long long)config->window_size, (long long)step);
+    log_printf("Windows     : %lld\n", (long long)windows);
+    log_printf("Output      : %s, %s, %s\n", paths[0], paths[1], paths[2]);
+    log_printf("Time        : %.3f seconds\n\n", seconds);
+}
+
+typedef struct {
+    int64_t start;
+    int64_t end;
+} mask_interval;
+
+typedef struct {
+    int64_t start;
+    int64_t finish;
+    int r;
+    int l;
+} dust_perfect;
+
+typedef struct {
+    mask_interval *items;
+    int count;
+    int capacity;
+} mask_list;
+
+typedef struct {
+    const char *sequence;
+    int64_t length;
+    int64_t chunk_start;
+    int64_t chunk_end;
+    int level;
+    int window;
+    mask_list result;
+} mask_job;
+
+void mask_list_push(mask_list *list, int64_t start, int64_t end)
+{
+    if (list->count > 0 && start <= list->items[list->count - 1].end) 
+    {
+        if (end > list->items[list->count - 1].end) 
+        {
+            list->items[list->count - 1].end = end;
+        }
+
+        return;
+    }
+
+    if (list->count == list->capacity) 
+    {
+        list->capacity = list->capacity == 0 ? 256 : list->capacity * 2;
+        list->items = xrealloc(list->items, sizeof(mask_interval) * list->capacity);
+    }
+
+    list->items[list->count].start = start;
+    list->items[list->count].end = end;
+    list->count++;
+}
+
+void dust_save_masked(mask_list *result, dust_perfect *perfect, int *perfect_count, int64_t start)
+{
+    if (*perfect_count == 0 || perfect[*perfect_count - 1].start >= start) 
+    {
+        return;
+    }
+
+    dust_perfect *last = &perfect[*perfect_count - 1];
+    int i = *perfect_count - 1;
+
+    mask_list_push(result, last->start, last->finish);
+
+    while (i >= 0 && perfect[i].start < start) 
+    {
+        i--;
+    }
+
+    *perfect_count = i + 1;
+}
+
+void dust_scan(const char *sequence, int64_t begin, int64_t end, int level, int window, mask_list *result)
+{
+    int capacity = 1;
+
+    while (capacity < window) 
+    {
+        capacity <<= 1;
+    }
+
+    int mask = capacity - 1;
+    int *words = xmalloc(sizeof(int) * capacity);
+    signed char codes[256];
+    int perfect_capacity = window;
+    dust_perfect *perfect = xmalloc(sizeof(dust_perfect) * perfect_capacity);
+    int perfect_count = 0;
+    int cw[64];
+    int cv[64];
+    int front = 0;
+    int count = 0;
+    int suffix = 0;
+    int rw = 0;
+    int rv = 0;
+    int64_t run = 0;
+    unsigned word = 0;
+
+    memset(cw, 0, sizeof(cw));
+    memset(cv, 0, sizeof(cv));
+
+    for (int ch = 0; ch < 256; ch++) 
+    {
+        codes[ch] = (signed char)base_code((char)ch);
+    }
+
+    for (int64_t i = begin; i <= end; i++) 
+    {
+        int b = i < end ? codes[(unsigned char)sequence[i]] : -1;
+
+        if (b < 0) 
+        {
+            int64_t start = (run - window + 1 > 0 ? run - window + 1 : 0) + (i + 1 - run);
+
+            while (perfect_count > 0) 
+            {
+                dust_save_masked(result, perfect, &perfect_count, start++);
+            }
+
+            memset(cw, 0, sizeof(cw));
+            memset(cv, 0, sizeof(cv));
+            front = count = suffix = rw = rv = 0;
+            run = 0;
+            word = 0;
+            continue;
+        }
+
+        run++;
+        word = ((word << 2) | (unsigned)b) & 63;
+
+        if (run < 3) 
+        {
+            continue;
+        }
+
+        int64_t start = (run - window > 0 ? run - window : 0) + (i + 1 - run);
+        int s;
+
+        dust_save_masked(result, perfect, &perfect_count, start);
+
+        if (count >= window - 2) 
+        {
+            s = words[front];
+            front = (front + 1) & mask;
+            count--;
+            rw -= --cw[s];
+
+            if (suffix > count) 
+            {
+                suffix--;
+                rv -= --cv[s];
+            }
+        }
+
+        words[(front + count) & mask] = word;
+        count++;
+        suffix++;
+        rw += cw[word]++;
+        rv += cv[word]++;
+
+        if (cv[word] * 10 > 2 * level) 
+        {
+            do 
+            {
+                s = words[(front + count - suffix) & mask];
+                rv -= --cv[s];
+                suffix--;
+            } 
+            while (s != (int)word);
+        }
+
+        if (rw * 10 <= suffix * level) 
+        {
+            continue;
+        }
+
+        int c[64];
+        int r = rv;
+        int max_r = 0;
+        int max_l = 0;
+        int j = 0;
+
+        memcpy(c, cv, sizeof(c));
+
+        for (int k = count - suffix - 1; k >= 0; k--) 
+        {
+            int t = words[(front + k) & mask];
+
+            r += c[t]++;
+
+            int new_l = count - k - 1;
+
+            if (r * 10 <= level * new_l) 
+            {
+                continue;
+            }
+
+            for (; j < perfect_count && perfect[j].start >= k + start; j++) 
+            {
+                if (max_r == 0 || perfect[j].r * max_l > max_r * perfect[j].l) 
+                {
+                    max_r = perfect[j].r;
+                    max_l = perfect[j].l;
+                }
+            }
+
+            if (max_r == 0 || r * max_l >= max_r * new_l) 
+            {
+                max_r = r;
+                max_l = new_l;
+
+                if (j > 0 && perfect[j - 1].start == k + start) 
+                {
+                    perfect[j - 1].finish = count + 2 + start;
+                    perfect[j - 1].r = r;
+                    perfect[j - 1].l = new_l;
+                    continue;
+                }
+
+                if (perfect_count == perfect_capacity) 
+                {
+                    perfect_capacity *= 2;
+                    perfect = xrealloc(perfect, sizeof(dust_perfect) * perfect_capacity);
+                }
+
+                memmove(perfect + j + 1, perfect + j, sizeof(dust_perfect) * (perfect_count - j));
+                perfect[j].start = k + start;
+                perfect[j].finish = count + 2 + start;
+                perfect[j].r = r;
+                perfect[j].l = new_l;
+                perfect_count++;
+                j++;
+            }
+        }
+    }
+
+    free(words);
+    free(perfect);
+}
+
+void *mask_worker(void *arg)
+{
+    mask_job *job = (mask_job *)arg;
+    int64_t begin = job->chunk_start - 2 * (int64_t)job->window;
+    int64_t end = job->chunk_end + job->window;
+    mask_list found;
+
+    memset(&found, 0, sizeof(found));
+    memset(&job->result, 0, sizeof(job->result));
+    dust_scan(job->sequence, begin > 0 ? begin : 0, end < job->length ? end : job->length, job->level, job->window, &found);
+
+    for (int i = 0; i < found.count; i++) 
+    {
+        int64_t start = found.items[i].start > job->chunk_start ? found.items[i].start : job->chunk_start;
+        int64_t stop = found.items[i].end < job->chunk_end ? found.items[i].end : job->chunk_end;
+
+        if (start < stop) 
+        {
+            mask_list_push(&job->result, start, stop);
+        }
+    }
+
+    free(found.items);
+
+    return NULL;
+}
+
+void run_mask_mode(const options *config)
+{
+    const char *input = config->do_fasta_input == 1 ? config->fasta_input_file : (config->file_mode == 1 ? config->input_file : NULL);
+    int thread_count = config->thread_count > 0 ? config->thread_count : default_thread_count();
+    mask_job *jobs = xmalloc(sizeof(mask_job) * thread_count);
+    buffered_writer writer;
+    fasta_reader reader;
+
+    if (!writer_open(&writer, config->mask_output_file, 1 << 20)) 
+    {
+        free(jobs);
+        return;
+    }
+
+    if (!fasta_reader_open_record(&reader, input, config->fasta_record)) 
+    {
+        writer_close(&writer);
+        free(jobs);
+        return;
+    }
+
+    char *sequence = NULL;
+    int64_t capacity = 0;
+    int64_t length;
+    int64_t total_bases = 0;
+    int64_t masked_bases = 0;
+    int64_t intervals = 0;
+    int records = 0;
+    int64_t start = now_ns();
+    mask_list merged;
+
+    memset(&merged, 0, sizeof(merged));
+
+    while (fasta_read_record(&reader, &sequence, &capacity, &length)) 
+    {
+        char name[MAX_FILENAME_LENGTH];
+        int name_length = strcspn(reader.name, " \t");
+        int64_t chunk = (length + thread_count - 1) / thread_count;
+        int active = 0;
+
+        memcpy(name, reader.name, name_length);
+        name[name_length] = '\0';
+
+        if (chunk < MASK_MIN_CHUNK) 
+        {
+            chunk = MASK_MIN_CHUNK;
+        }
+
+        for (int64_t offset = 0; offset < length; offset += chunk) 
+        {
+            jobs[active].sequence = sequence;
+            jobs[active].length = length;
+            jobs[active].chunk_start = offset;
+            jobs[active].chunk_end = offset + chunk < length ? offset + chunk : length;
+            jobs[active].level = config->mask_level;
+            jobs[active].window = config->mask_window;
+            active++;
+        }
+
+        run_workers(active, mask_worker, jobs, sizeof(mask_job));
+        merged.count = 0;
+
+        for (int t = 0; t < active; t++) 
+        {
+            for (int i = 0; i < jobs[t].result.count; i++) 
+            {
+                mask_list_push(&merged, jobs[t].result.items[i].start, jobs[t].result.items[i].end);
+            }
+
+            free(jobs[t].result.items);
+        }
+
+        for (int i = 0; i < merged.count; i++) 
+        {
+            masked_bases += merged.items[i].end - merged.items[i].start;
+
+            if (config->mask_bed) 
+            {
+                char line[MAX_FILENAME_LENGTH + 64];
+                int line_length = snprintf(line, sizeof(line), "%s\t%lld\t%lld\n", name, (long long)merged.items[i].start, (long long)merged.items[i].end);
+
+                writer_write(&writer, line, line_length);
+                continue;
+            }
+
+            for (int64_t p = merged.items[i].start; p < merged.items[i].end; p++) 
+            {
+                sequence[p] = (char)tolower((unsigned char)sequence[p]);
+            }
+        }
+
+        if (!config->mask_bed) 
+        {
+            writer_write(&writer, ">", 1);
+            writer_write(&writer, name, name_length);
+            writer_write(&writer, "\n", 1);
+
+            for (int64_t p = 0; p < length; p += FASTA_LINE_WIDTH) 
+            {
+                writer_write(&writer, sequence + p, length - p < FASTA_LINE_WIDTH ? (size_t)(length - p) : FASTA_LINE_WIDTH);
+                writer_write(&writer, "\n", 1);
+            }
+        }
+
+        intervals += merged.count;
+        total_bases += length;
+        records++;
+    }
+
+    double seconds = (now_ns() - start) / 1e9;
+
+    fasta_reader_close(&reader);
+    writer_close(&writer);
+    free(merged.items);
+    free(sequence);
+    free(jobs);
+
+    if (strcmp(config->mask_output_file, "-") == 0) 
+    {
+        return;
+    }
+
+    log_printf("\n=== Low-Complexity Mask ===\n\n");
+    log_printf("Records     : %d (%lld bases)\n", records, (long long)total_bases);
+    log_printf("Masked      : %lld bases in %lld intervals (%.2f%%)\n", (long long)masked_bases, (long long)intervals, total_bases > 0 ? 100.0 * masked_bases / total_bases : 0.0);
+    log_printf("Parameters  : window %d, level %d, %d thread(s)\n", config->mask_window, config->mask_level, thread_count);
+    log_printf("Output      : %s (%s)\n", config->mask_output_file, config->mask_bed ? "BED" : "soft-masked FASTA");
+    log_printf("Time        : %.3f seconds\n\n", seconds);
+}
+
+int64_t find_palindromes_in_record(buffered_writer *writer, const char *name, const char *sequence, int64_t length, const options *config, uint16_t *radius)
+{
+    const uint64_t low_bits = 0x5555555555555555ULL;
+    unsigned char complement[256];
+    signed char codes[256];
+    int64_t max_arm = config->max_arm > 0 ? config->max_arm : length;
+    int64_t left = 0;
+    int64_t right = 0;
+    int64_t found = 0;
+    uint64_t behind = 0;
+    uint64_t behind_valid = 0;
+    uint64_t ahead[2] = { 0, 0 };
+    uint64_t ahead_valid[2] = { 0, 0 };
+
+    memset(complement, 0, sizeof(complement));
+    complement['A'] = 'T';
+    complement['C'] = 'G';
+    complement['G'] = 'C';
+    complement['T'] = 'A';
+
+    for (int ch = 0; ch < 256; ch++) 
+    {
+        codes[ch] = (signed char)base_code((char)ch);
+    }
+
+    const unsigned char *bases = (const unsigned char *)sequence;
+
+    for (int64_t i = 0; i < 64 && i < length; i++) 
+    {
+        if (codes[bases[i]] >= 0) 
+        {
+            ahead[i / 32] |= (uint64_t)codes[bases[i]] << (2 * (i % 32));
+            ahead_valid[i / 32] |= 3ULL << (2 * (i % 32));
+        }
+    }
+
+    for (int64_t center = 0; center <= length; center++) 
+    {
+        int64_t arm = 0;
+
+        if (center > 0) 
+        {
+            int code = codes[bases[center - 1]];
+            int incoming = center + 63 < length ? codes[bases[center + 63]] : -1;
+
+            behind = (behind << 2) | (code >= 0 ? (uint64_t)(3 - code) : 0);
+            behind_valid = (behind_valid << 2) | (code >= 0 ? 3 : 0);
+            ahead[0] = (ahead[0] >> 2) | (ahead[1] << 62);
+            ahead_valid[0] = (ahead_valid[0] >> 2) | (ahead_valid[1] << 62);
+            ahead[1] = (ahead[1] >> 2) | (incoming >= 0 ? (uint64_t)incoming << 62 : 0);
+            ahead_valid[1] = (ahead_valid[1] >> 2) | (incoming >= 0 ? 3ULL << 62 : 0);
+        }
+
+        if (center < right) 
+        {
+            int64_t mirrored = radius[left + right - center];
+
+            arm = mirrored < right - center ? mirrored : right - center;
+        }
+
+        while (center - 1 - arm >= 0 && center + arm < length && bases[center - 1 - arm] == complement[bases[center + arm]]) 
+        {
+            arm++;
+        }
+
+        radius[center] = arm < UINT16_MAX ? (uint16_t)arm : UINT16_MAX;
+
+        if (center + arm > right) 
+        {
+            left = center - arm;
+            right = center + arm;
+        }
+
+        for (int spacer = 0; spacer <= config->max_spacer; spacer++) 
+        {
+            int64_t span = arm;
+            int nested = 0;
+
+            if (spacer > 0) 
+            {
+                if (center + spacer > length) 
+                {
+                    break;
+                }
+
+                nested = (spacer > 1) & (bases[center] == complement[bases[center + spacer - 1]]);
+                span = 0;
+
+                if (spacer < 32) 
+                {
+                    uint64_t facing = (ahead[0] >> (2 * spacer)) | (ahead[1] << (64 - 2 * spacer));
+                    uint64_t facing_valid = (ahead_valid[0] >> (2 * spacer)) | (ahead_valid[1] << (64 - 2 * spacer));
+                    uint64_t differ = behind ^ facing;
+                    uint64_t stop = ((differ | (differ >> 1)) & low_bits) | (~(behind_valid & facing_valid) & low_bits);
+
+                    span = trailing_zeros64(stop) / 2;
+                }
+
+                if (spacer >= 32 || span == 32) 
+                {
+                    while (span < max_arm && center - 1 - span >= 0 && center + spacer + span < length && bases[center - 1 - span] == complement[bases[center + spacer + span]]) 
+                    {
+                        span++;
+                    }
+                }
+            }
+
+            if (span > max_arm) 
+            {
+                span = max_arm;
+            }
+
+            if (span < config->min_arm || nested) 
+            {
+                continue;
+            }
+
+            char line[MAX_FILENAME_LENGTH + 96];
+            int line_length = snprintf(line, sizeof(line), "%s\t%lld\t%lld\t%lld\t%d\n", name, (long long)(center - span), (long long)(center + spacer + span), (long long)span, spacer);
+
+            writer_write(writer, line, line_length);
+            found++;
+        }
+    }
+
+    return found;
+}
+
+void run_palindrome_mode(const options *config)
+{
+    const char *input = config->do_fasta_input == 1 ? config->fasta_input_file : (config->file_mode == 1 ? config->input_file : NULL);
+    buffered_writer writer;
+    fasta_reader reader;
+
+    if (!writer_open(&writer, config->palindrome_output_file, 1 << 20)) 
+    {
+        return;
+    }
+
+    if (!fasta_reader_open_record(&reader, input, config->fasta_record)) 
+    {
+        writer_close(&writer);
+        return;
+    }
+
+    char *sequence = NULL;
+    uint16_t *radius = NULL;
+    int64_t capacity = 0;
+    int64_t radius_capacity = 0;
+    int64_t length;
+    int64_t total_bases = 0;
+    int64_t found = 0;
+    int records = 0;
+    int64_t start = now_ns();
+
+    writer_puts(&writer, "#sequence\tstart\tend\tarm\tspacer\n");
+
+    while (fasta_read_record(&reader, &sequence, &capacity, &length)) 
+    {
+        char name[MAX_FILENAME_LENGTH];
+        int name_length = strcspn(reader.name, " \t");
+
+        memcpy(name, reader.name, name_length);
+        name[name_length] = '\0';
+
+        if (radius_capacity < length + 1) 
+        {
+            radius_capacity = length + 1;
+            radius = xrealloc(radius, sizeof(uint16_t) * radius_capacity);
+        }
+
+        found += find_palindromes_in_record(&writer, name, sequence, length, config, radius);
+        total_bases += length;
+        records++;
+    }
+
+    double seconds = (now_ns() - start) / 1e9;
+
+    fasta_reader_close(&reader);
+    writer_close(&writer);
+    free(sequence);
+    free(radius);
+
+    if (strcmp(config->palindrome_output_file, "-") == 0) 
+    {
+        return;
+    }
+
+    log_printf("\n=== Palindromes ===\n\n");
+    log_printf("Records     : %d (%lld bases)\n", records, (long long)total_bases);
+    log_printf("Found       : %lld\n", (long long)found);
+    log_printf("Arms        : %d", config->min_arm);
+
+    if (config->max_arm > 0) 
+    {
+        log_printf("-%d", config->max_arm);
+    }
+    else 
+    {
+        log_printf("+");
+    }
+
+    log_printf(" bp, spacer 0-%d bp\n", config->max_spacer);
+    log_printf("Output      : %s\n", config->palindrome_output_file);
+    log_printf("Time        : %.3f seconds\n\n", seconds);
+}
+
+typedef struct {
+    int64_t start;
+    int64_t end;
+    int period;
+    int64_t matches;
+} repeat_hit;
+
+typedef struct {
+    const char *sequence;
+    int64_t length;
+    int64_t chunk_start;
+    int64_t chunk_end;
+    int max_period;
+    int min_copies;
+    repeat_hit *hits;
+    int hit_count;
+    int hit_capacity;
+    int64_t *closed;
+} repeat_job;
+
+int compare_repeat_hits(const void *a, const void *b)
+{
+    const repeat_hit *x = (const repeat_hit *)a;
+    const repeat_hit *y = (const repeat_hit *)b;
+
+    if (x->start != y->start) 
+    {
+        return x->start < y->start ? -1 : 1;
+    }
+
+    return x->period - y->period;
+}
+
+int repeat_unit_is_primitive(const char *unit, int period)
+{
+    for (int q = 1; q < period; q++) 
+    {
+        if (period % q != 0) 
+        {
+            continue;
+        }
+
+        int i = q;
+
+        while (i < period && unit[i] == unit[i - q]) 
+        {
+            i++;
+        }
+
+        if (i == period) 
+        {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+void repeat_emit(repeat_job *job, int period, int64_t start, int64_t last_compare, int64_t matches)
+{
+    int64_t end = last_compare + 1 + period;
+    int64_t minimum = (int64_t)job->min_copies * period;
+
+    if (end - start < (minimum > REPEAT_MIN_LENGTH ? minimum : REPEAT_MIN_LENGTH)) 
+    {
+        return;
+    }
+
+    if (!repeat_unit_is_primitive(job->sequence + start, period)) 
+    {
+        return;
+    }
+
+    if (job->hit_count == job->hit_capacity) 
+    {
+        job->hit_capacity = job->hit_capacity == 0 ? 256 : job->hit_capacity * 2;
+        job->hits = xrealloc(job->hits, sizeof(repeat_hit) * job->hit_capacity);
+    }
+
+    job->hits[job->hit_count].start = start;
+    job->hits[job->hit_count].end = end;
+    job->hits[job->hit_count].period = period;
+    job->hits[job->hit_count].matches = matches;
+    job->hit_count++;
+}
+
+void *repeat_worker(void *arg)
+{
+    repeat_job *job = (repeat_job *)arg;
+    const unsigned char *bases = (const unsigned char *)job->sequence;
+    unsigned char valid[256];
+
+    memset(valid, 0, sizeof(valid));
+    valid['A'] = valid['C'] = valid['G'] = valid['T'] = 1;
+    job->hits = NULL;
+    job->hit_count = 0;
+    job->hit_capacity = 0;
+
+    for (int period = 1; period <= job->max_period; period++) 
+    {
+        int64_t score = 0;
+        int64_t best = 0;
+        int64_t best_end = 0;
+        int64_t matches = 0;
+        int64_t best_matches = 0;
+        int64_t segment = job->chunk_start;
+        int64_t i;
+
+        for (i = job->chunk_start; i + period < job->length; i++) 
+        {
+            if (i >= job->chunk_end && score == 0) 
+            {
+                break;
+            }
+
+            if (bases[i] == bases[i + period] && valid[bases[i]]) 
+            {
+                score++;
+                matches++;
+
+                if (score > best) 
+                {
+                    best = score;
+                    best_end = i;
+                    best_matches = matches;
+                }
+
+                continue;
+            }
+
+            score -= REPEAT_MISMATCH_PENALTY;
+
+            if (score <= 0) 
+            {
+                if (best > 0) 
+                {
+                    repeat_emit(job, period, segment, best_end, best_matches);
+                }
+
+                score = 0;
+                best = 0;
+                matches = 0;
+                segment = i + 1;
+            }
+        }
+
+        if (best > 0) 
+        {
+            repeat_emit(job, period, segment, best_end, best_matches);
+        }
+
+        job->closed[period] = i;
+    }
+
+    return NULL;
+}
+
+void run_repeats_mode(const options *config)
+{
+    const char *input = config->do_fasta_input == 1 ? config->fasta_input_file : (config->file_mode == 1 ? config->input_file : NULL);
+    int thread_count = config->thread_count > 0 ? config->thread_count : default_thread_count();
+    repeat_job *jobs = xmalloc(sizeof(repeat_job) * thread_count);
+    buffered_writer writer;
+    fasta_reader reader;
+
+    if (!writer_open(&writer, config->repeats_output_file, 1 << 20)) 
+    {
+        free(jobs);
+        return;
+    }
+
+    if (!fasta_reader_open_record(&reader, input, config->fasta_record)) 
+    {
+        writer_close(&writer);
+        free(jobs);
+        return;
+    }
+
+    for (int t = 0; t < thread_count; t++) 
+    {
+        jobs[t].closed = xmalloc(sizeof(int64_t) * (config->max_period + 1));
+    }
+
+    char *sequence = NULL;
+    int64_t capacity = 0;
+    int64_t length;
+    int64_t total_bases = 0;
+    int64_t repeat_bases = 0;
+    int64_t found = 0;
+    int records = 0;
+    int64_t start = now_ns();
+    repeat_hit *merged = NULL;
+    int merged_capacity = 0;
+
+    writer_puts(&writer, "#sequence\tstart\tend\tperiod\tcopies\tpurity\tunit\n");
+
+    while (fasta_read_record(&reader, &sequence, &capacity, &length)) 
+    {
+        char name[MAX_FILENAME_LENGTH];
+        int name_length = strcspn(reader.name, " \t");
+        int64_t chunk = (length + thread_count - 1) / thread_count;
+        int active = 0;
+        int merged_count = 0;
+
+        memcpy(name, reader.name, name_length);
+        name[name_length] = '\0';
+
+        if (chunk < REPEAT_MIN_CHUNK) 
+        {
+            chunk = REPEAT_MIN_CHUNK;
+        }
+
+        for (int64_t offset = 0; offset < length; offset += chunk) 
+        {
+            jobs[active].sequence = sequence;
+            jobs[active].length = length;
+            jobs[active].chunk_start = offset;
+            jobs[active].chunk_end = offset + chunk < length ? offset + chunk : length;
+            jobs[active].max_period = config->max_period;
+            jobs[active].min_copies = config->min_copies;
+            active++;
+        }
+
+        run_workers(active, repeat_worker, jobs, sizeof(repeat_job));
+
+        for (int t = 0; t < active; t++) 
+        {
+            for (int h = 0; h < jobs[t].hit_count; h++) 
+            {
+                repeat_hit *hit = &jobs[t].hits[h];
+
+                if (t > 0 && hit->start < jobs[t - 1].closed[hit->period]) 
+                {
+                    continue;
+                }
+
+                if (merged_count == merged_capacity) 
+                {
+                    merged_capacity = merged_capacity == 0 ? 1024 : merged_capacity * 2;
+                    merged = xrealloc(merged, sizeof(repeat_hit) * merged_capacity);
+                }
+
+                merged[merged_count++] = *hit;
+            }
+
+            free(jobs[t].hits);
+        }
+
+        qsort(merged, merged_count, sizeof(repeat_hit), compare_repeat_hits);
+
+        for (int h = 0; h < merged_count; h++) 
+        {
+            repeat_hit *hit = &merged[h];
+            int64_t span = hit->end - hit->start;
+            char line[MAX_FILENAME_LENGTH + 128];
+            int line_length = snprintf(line, sizeof(line), "%s\t%lld\t%lld\t%d\t%.1f\t%.3f\t", name, (long long)hit->start, (long long)hit->end, hit->period, (double)span / hit->period, (double)hit->matches / (span - hit->period));
+
+            writer_write(&writer, line, line_length);
+            writer_write(&writer, sequence + hit->start, hit->period);
+            writer_write(&writer, "\n", 1);
+            repeat_bases += span;
+        }
+
+        found += merged_count;
+        total_bases += length;
+        records++;
+    }
+
+    double seconds = (now_ns() - start) / 1e9;
+
+    fasta_reader_close(&reader);
+    writer_close(&writer);
+
+    for (int t = 0; t < thread_count; t++) 
+    {
+        free(jobs[t].closed);
+    }
+
+    free(jobs);
+    free(merged);
+    free(sequence);
+
+    if (strcmp(config->repeats_output_file, "-") == 0) 
+    {
+        return;
+    }
+
+    log_printf("\n=== Tandem Repeats ===\n\n");
+    log_printf("Records     : %d (%lld bases)\n", records, (long long)total_bases);
+    log_printf("Repeats     : %lld covering %lld bases\n", (long long)found, (long long)repeat_bases);
+    log_printf("Parameters  : period 1-%d, at least %d copies, %d thread(s)\n", config->max_period, config->min_copies, thread_count);
+    log_printf("Output      : %s\n", config->repeats_output_file);
+    log_printf("Time        : %.3f seconds\n\n", seconds);
+}
+
+typedef struct batch_chunk {
+    char sequence[MAX_DNA_LENGTH];
+    char record[MAX_FILENAME_LENGTH];
+    int64_t offset;
+    int64_t index;
+    int length;
+    int file;
+    int done;
+    text_buffer output;
+    struct batch_chunk *next;
+} batch_chunk;
+
+typedef struct {
+    int file;
+    batch_chunk *chunk;
+} batch_task;
+
+typedef struct {
+    batch_task *tasks;
+    int head;
+    int tail;
+    int capacity;
+    worker_mutex lock;
+} batch_deque;
+
+typedef struct {
+    const char *path;
+    int read_done;
+    int failed;
+    text_buffer output;
+    batch_chunk *first;
+    batch_chunk *last;
+} batch_file;
+
+typedef struct {
+    const options *config;
+    batch_file *files;
+    batch_deque *deques;
+    int file_count;
+    int worker_count;
+    int64_t pending;
+    int next_flush;
+    int header_flushed;
+    int failed;
+    int64_t chunks;
+    int64_t bases;
+    buffered_writer *writer;
+    worker_mutex flush_lock;
+} batch_pool;
+
+typedef struct {
+    batch_pool *pool;
+    int id;
+} batch_worker;
+
+int batch_deque_push(batch_deque *deque, batch_task task)
+{
+    worker_mutex_lock(&deque->lock);
+
+    if (deque->tail == deque->capacity) 
+    {
+        int live = deque->tail - deque->head;
+
+        if (deque->head > 0) 
+        {
+            memmove(deque->tasks, deque->tasks + deque->head, sizeof(batch_task) * live);
+        }
+
+        if (live == deque->capacity) 
+        {
+            deque->capacity = deque->capacity > 0 ? deque->capacity * 2 : 64;
+            deque->tasks = xrealloc(deque->tasks, sizeof(batch_task) * deque->capacity);
+        }
+
+        deque->head = 0;
+        deque->tail = live;
+    }
+
+    deque->tasks[deque->tail++] = task;
+
+    int live = deque->tail - deque->head;
+
+    worker_mutex_unlock(&deque->lock);
+
+    return live;
+}
+
+int batch_deque_pop(batch_deque *deque, batch_task *task, int steal)
+{
+    int found = 0;
+
+    worker_mutex_lock(&deque->lock);
+
+    if (deque->head < deque->tail) 
+    {
+        *task = steal ? deque->tasks[deque->head++] : deque->tasks[--deque->tail];
+        found = 1;
+    }
+
+    worker_mutex_unlock(&deque->lock);
+
+    return found;
+}
+
+int batch_next_task(batch_worker *worker, batch_task *task)
+{
+    batch_pool *pool = worker->pool;
+
+    while (1) 
+    {
+        if (batch_deque_pop(&pool->deques[worker->id], task, 0)) 
+        {
+            return 1;
+        }
+
+        for (int v = 1; v < pool->worker_count; v++) 
+        {
+            if (batch_deque_pop(&pool->deques[(worker->id + v) % pool->worker_count], task, 1)) 
+            {
+                return 1;
+            }
+        }
+
+        if (__atomic_load_n(&pool->pending, __ATOMIC_ACQUIRE) == 0) 
+        {
+            return 0;
+        }
+
+#ifndef _WIN32
+        sched_yield();
+#endif
+    }
+}
+
+void batch_write_output(batch_pool *pool, text_buffer *output)
+{
+    writer_write(pool->writer, output->data, output->length);
+
+    if (log_fp != NULL && pool->config->output_format != FORMAT_MSGPACK) 
+    {
+        fwrite(output->data, 1, output->length, log_fp);
+    }
+
+    free(output->data);
+    memset(output, 0, sizeof(*output));
+}
+
+void batch_flush_ready(batch_pool *pool)
+{
+    worker_mutex_lock(&pool->flush_lock);
+
+    while (pool->next_flush < pool->file_count) 
+    {
+        batch_file *file = &pool->files[pool->next_flush];
+
+        if (!pool->header_flushed) 
+        {
+            if (file->first == NULL && !file->read_done) 
+            {
+                break;
+            }
+
+            batch_write_output(pool, &file->output);
+            pool->header_flushed = 1;
+        }
+
+        batch_chunk *chunk = file->first;
+
+        if (chunk != NULL) 
+        {
+            if (!__atomic_load_n(&chunk->done, __ATOMIC_ACQUIRE)) 
+            {
+                break;
+            }
+
+            batch_write_output(pool, &chunk->output);
+            pool->chunks++;
+            pool->bases += chunk->length;
+            file->first = chunk->next;
+
+            if (file->first == NULL) 
+            {
+                file->last = NULL;
+            }
+
+            free(chunk);
+            continue;
+        }
+
+        if (!file->read_done) 
+        {
+            break;
+        }
+
+        pool->failed += file->failed;
+        pool->next_flush++;
+        pool->header_flushed = 0;
+    }
+
+    worker_mutex_unlock(&pool->flush_lock);
+}
+
+void batch_run_chunk(batch_pool *pool, batch_chunk *chunk)
+{
+    const options *config = pool->config;
+
+    log_capture = &chunk->output;
+    output_record_index = chunk->index;
+    output_record_file = pool->files[chunk->file].path;
+    output_record_name = chunk->record;
+    output_record_offset = chunk->offset;
+    rng_seed(&global_rng, config->seed + ((uint64_t)chunk->file << 32) + (uint64_t)chunk->index);
+
+    if (config->output_format == FORMAT_TEXT) 
+    {
+        log_printf("\n=== Record %s:%lld-%lld ===\n", chunk->record, (long long)chunk->offset + 1, (long long)chunk->offset + chunk->length);
     }
 
-    if (pg > 0) 
+    process_sequence(chunk->sequence, config);
+
+    output_record_file = NULL;
+    output_record_name = NULL;
+    __atomic_store_n(&chunk->done, 1, __ATOMIC_RELEASE);
+}
+
+void batch_run_task(batch_worker *worker, const batch_task *task);
+
+void batch_read_file(batch_worker *worker, int index)
+{
+    batch_pool *pool = worker->pool;
+    batch_file *file = &pool->files[index];
+    fasta_reader reader;
+    char *sequence = NULL;
+    int64_t capacity = 0;
+    int64_t length;
+    int64_t chunk_index = 0;
+
+    log_capture = &file->output;
+
+    if (pool->config->output_format == FORMAT_TEXT) 
     {
-        entropy -= pg * log2(pg);
+        log_printf("\n=== File: %s ===\n", file->path);
     }
 
-    if (pt > 0) 
+    if (!fasta_reader_open_record(&reader, file->path, pool->config->fasta_record)) 
     {
-        entropy -= pt * log2(pt);
+        file->failed = 1;
     }
+    else 
+    {
+        while (fasta_read_record(&reader, &sequence, &capacity, &length)) 
+        {
+            int name_length = strcspn(reader.name, " \t");
 
-    log_printf("\n=== Sequence Complexity ===\n\n");
-    log_printf("Shannon Entropy: %.4f bits/base (max: 2.0000)\n", entropy);
-}
+            for (int64_t offset = 0; offset < length; offset += MAX_DNA_LENGTH - 1) 
+            {
+                batch_chunk *chunk = xmalloc(sizeof(batch_chunk));
+                int chunk_length = length - offset < MAX_DNA_LENGTH - 1 ? (int)(length - offset) : MAX_DNA_LENGTH - 1;
+                batch_task task;
+
+                memcpy(chunk->sequence, sequence + offset, (size_t)chunk_length);
+                chunk->sequence[chunk_length] = '\0';
+                memcpy(chunk->record, reader.name, name_length);
+                chunk->record[name_length] = '\0';
+                chunk->offset = offset;
+                chunk->index = chunk_index++;
+                chunk->length = chunk_length;
+                chunk->file = index;
+                chunk->done = 0;
+                memset(&chunk->output, 0, sizeof(chunk->output));
+                chunk->next = NULL;
+
+                worker_mutex_lock(&pool->flush_lock);
+
+                if (file->last != NULL) 
+                {
+                    file->last->next = chunk;
+                }
+                else 
+                {
+                    file->first = chunk;
+                }
 
-void print_version(const char *progname) 
-{
-    printf("\n%s version %s\n", progname, PROGRAM_VERSION);
-    printf("Build date: %s %s\n\n", BUILD_DATE, BUILD_TIME);
+                file->last = chunk;
+                worker_mutex_unlock(&pool->flush_lock);
+
+                task.file = index;
+                task.chunk = chunk;
+                __atomic_fetch_add(&pool->pending, 1, __ATOMIC_RELEASE);
+
+                if (batch_deque_push(&pool->deques[worker->id], task) > BATCH_QUEUE_DEPTH && batch_deque_pop(&pool->deques[worker->id], &task, 0)) 
+                {
+                    batch_run_task(worker, &task);
+                    log_capture = &file->output;
+                }
+            }
+        }
+
+        fasta_reader_close(&reader);
+
+        if (chunk_index == 0) 
+        {
+            log_printf("Error: No DNA sequence found in FASTA file '%s'\n", file->path);
+            file->failed = 1;
+        }
+    }
+
+    free(sequence);
+
+    worker_mutex_lock(&pool->flush_lock);
+    file->read_done = 1;
+    worker_mutex_unlock(&pool->flush_lock);
 }
 
-void print_help(const char *progname)
+void batch_run_task(batch_worker *worker, const batch_task *task)
 {
-    printf("\n%s - DNA Sequence Analysis Tool\n\n", progname);
+    batch_pool *pool = worker->pool;
 
-    printf("Usage:\n");
-    printf("  %s [options]\n\n", progname);
+    if (task->chunk != NULL) 
+    {
+        batch_run_chunk(pool, task->chunk);
+    }
+    else 
+    {
+        batch_read_file(worker, task->file);
+    }
 
-    printf("Options:\n");
-    printf("  --ascii                 Show ASCII representation of DNA sequence\n");
-    printf("  --stats                 Show base statistics\n");
-    printf("  --summary               Show summary of sequence statistics\n");
-    printf("  --json                  Output analysis in JSON format (disables ASCII, stats, summary)\n");
-    printf("  --palindrome            Check if DNA sequence is a palindrome (reverse-complement)\n");
-    printf("  --reverse               Reverse the DNA sequence before analysis\n");
-    printf("  --complement            Use complement of DNA sequence before analysis\n");
-    printf("  --reverse-complement    Use reverse complement of DNA sequence before analysis\n");
-    printf("  --binary                Output DNA sequence as binary code\n");
-    printf("  --hex                   Output DNA sequence as hexadecimal code\n");
-    printf("  --key                   Derive a 128-bit key from DNA sequence\n");
-    printf("  --hash                  Output a 256-bit hash of the DNA sequence\n");
-    printf("  --qrcode                Visualize DNA sequence as a symbolic QR code\n");
-    printf("  --histogram             Show base distribution histogram (horizontal by default)\n");
-    printf("  --histogram-vertical    Show base distribution histogram vertically\n");
-    printf("  --histogram-horizontal  Show base distribution histogram horizontally\n");
-    printf("  --compress              Compress the DNA sequence (run-length encoding)\n");
-    printf("  --decompress            Decompress a run-length encoded DNA sequence\n");
-    printf("  --export-stats <file>   Export statistics as JSON to file\n");
-    printf("  --errors <N>            Introduce N random errors in the sequence\n");
-    printf("  --no-color              Disable colored output\n");
-    printf("  --csv <file>            Export sequence data to CSV file\n");
-    printf("  --file <file>           Read sequences from a file (one per line)\n");
-    printf("  --mutate <N>            Introduce N random point mutations\n");
-    printf("  --random <length>       Generate a random DNA sequence of given length\n");
-    printf("  --compare <seq1> <seq2> Compare two DNA sequences and count differences\n");
-    printf("  --find <pattern>        Search for a subsequence pattern in DNA\n");
-    printf("  --encrypt <text>        Encrypt text with DNA-derived key\n");
-    printf("  --decrypt <hex>         Decrypt hex string with DNA-derived key\n");
-    printf("  --encrypt-file <in> <out>  Encrypt a file using DNA key\n");
-    printf("  --decrypt-file <in> <out>  Decrypt a file using DNA key\n");
-    printf("  --stdin                 Read sequences from standard input\n");
-    printf("  --complexity            Calculate sequence complexity (Shannon entropy)\n");
-    printf("  --translate             Translate DNA sequence to amino acid sequence\n");
-    printf("  --benchmark             Measure and display analysis time\n");
-    printf("  --rotate <N>            Cyclically rotate DNA sequence by N bases\n");
-    printf("  --hamming <seq>         Calculate Hamming distance to reference sequence\n");
-    printf("  --log <file>            Log all terminal output to specified file\n");
-    printf("  --fasta <file>          Read a single DNA sequence from a FASTA file\n");
-    printf("  --export-fasta <file>   Export processed sequence to a FASTA file\n");
-    printf("  --orf                   Find and display Open Reading Frames (ORFs) in the sequence\n");
-    printf("  --position <base>       Show all 0-based positions of specified base (A, C, G, T)\n\n");
-    printf("  --version, -v           Show program version and build info\n");
-    printf("  --help, -h              Show this help message\n");
+    log_capture = NULL;
+    batch_flush_ready(pool);
+    __atomic_fetch_sub(&pool->pending, 1, __ATOMIC_RELEASE);
 }
 
-options parse_args(int argc, char *argv[]) 
+void *batch_worker_run(void *arg)
 {
-    options config;
+    batch_worker *worker = arg;
+    batch_task task;
+
+    while (batch_next_task(worker, &task)) 
+    {
+        batch_run_task(worker, &task);
+    }
 
-    config.show_ascii = 0;
-    config.show_stats = 0;
-    config.show_summary = 0;
-    config.show_json = 0;
-    config.do_reverse = 0;
-    config.do_complement = 0;
-    config.do_reverse_complement = 0;
-    config.file_mode = 0;
-    config.do_csv = 0;
-    config.do_binary = 0;
-    config.do_hex = 0;
-    config.do_key = 0;
-    config.do_hash = 0;
-    config.do_qrcode = 0;
-    config.do_histogram = 0;
-    config.histogram_vertical = 0;
-    config.do_compress = 0;
-    config.do_decompress = 0;
-    config.do_export_stats = 0;
-    config.do_find = 0;
-    config.do_complexity = 0;
-    config.mutate_count = 0;
-    config.errors_count = 0;
-    config.random_length = 0;
-    config.compare_mode = 0;
-    config.encrypt_mode = 0;
-    config.decrypt_mode = 0;
-    config.encrypt_file_mode = 0;
-    config.decrypt_file_mode = 0;
-    config.stdin_mode = 0;
-    config.no_color = 0;
-    config.show_version = 0;
-    config.do_benchmark = 0;
-    config.do_translate = 0;
-    config.rotate_n = 0;
-    config.do_hamming = 0;
-    config.do_log = 0;
-    config.do_palindrome = 0;
-    config.do_fasta_input = 0;
-    config.do_fasta_export = 0;
-    config.do_orf = 0;
-    config.do_position = 0;
-    config.position_base = '\0';
-
-    config.hamming_seq[0] = '\0';
-    config.input_file[0] = '\0';
-    config.output_file[0] = '\0';
-    config.csv_file[0] = '\0';
-    config.export_stats_file[0] = '\0';
-    config.compare_seq1[0] = '\0';
-    config.compare_seq2[0] = '\0';
-    config.find_pattern[0] = '\0';
-    config.encrypt_text[0] = '\0';
-    config.decrypt_hex[0] = '\0';
-    config.encrypt_file_input[0] = '\0';
-    config.encrypt_file_output[0] = '\0';
-    config.decrypt_file_input[0] = '\0';
-    config.decrypt_file_output[0] = '\0';
-    config.log_file[0] = '\0';
-    config.fasta_input_file[0] = '\0';
-    config.fasta_export_file[0] = '\0';
+    arena_free(&global_arena);
+    free(output_record.buffer.data);
+    memset(&output_record, 0, sizeof(output_record));
 
-    for (int i = 1; i < argc; i++) 
+    return NULL;
+}
+
+int batch_add_input(const char *spec, char ***paths, int *count, int *capacity)
+{
+    if (spec[0] == '@') 
     {
-        if (strcmp(argv[i], "--ascii") == 0) 
-        {
-            config.show_ascii = 1;
-        } 
-        else if (strcmp(argv[i], "--stats") == 0) 
-        {
-            config.show_stats = 1;
-        } 
-        else if (strcmp(argv[i], "--summary") == 0) 
+        FILE *manifest = fopen(spec + 1, "r");
+        char *line = NULL;
+        size_t line_capacity = 0;
+
+        if (manifest == NULL) 
         {
-            config.show_summary = 1;
+            log_printf("Error: Could not open manifest file '%s'\n", spec + 1);
+            return 0;
         }
-        else if (strcmp(argv[i], "--palindrome") == 0)
+
+        while (read_line(manifest, &line, &line_capacity)) 
         {
-            config.do_palindrome = 1;
+            if (line[0] != '\0' && line[0] != '#') 
+            {
+                batch_add_input(line, paths, count, capacity);
+            }
         }
-        else if (strcmp(argv[i], "--json") == 0) 
-        {
-            config.show_json = 1;
-            config.show_ascii = 0;
-            config.show_stats = 0;
-            config.show_summary = 0;
-        } 
-        else if (strcmp(argv[i], "--reverse") == 0) 
-        {
-            config.do_reverse = 1;
-        } 
-        else if (strcmp(argv[i], "--complement") == 0) 
+
+        free(line);
+        fclose(manifest);
+
+        return 1;
+    }
+
+#ifndef _WIN32
+    if (strpbrk(spec, "*?[") != NULL) 
+    {
+        glob_t matches;
+
+        if (glob(spec, 0, NULL, &matches) != 0) 
         {
-            config.do_complement = 1;
+            log_printf("Error: No files match '%s'\n", spec);
+            return 0;
         }
-        else if (strcmp(argv[i], "--reverse-complement") == 0)
+
+        for (size_t m = 0; m < matches.gl_pathc; m++) 
         {
-            config.do_reverse_complement = 1;
+            batch_add_input(matches.gl_pathv[m], paths, count, capacity);
         }
-        else if (strcmp(argv[i], "--binary") == 0) 
-        {
-            config.do_binary = 1;
-        } 
-        else if (strcmp(argv[i], "--hex") == 0) 
-        {
-            config.do_hex = 1;
-        } 
-        else if (strcmp(argv[i], "--key") == 0) 
-        {
-            config.do_key = 1;
-        } 
-        else if (strcmp(argv[i], "--hash") == 0) 
-        {
-            config.do_hash = 1;
-        } 
-        else if (strcmp(argv[i], "--qrcode") == 0) 
-        {
-            config.do_qrcode = 1;
-        } 
-        else if (strcmp(argv[i], "--histogram") == 0) 
-        {
-            config.do_histogram = 1;
-        } 
-        else if (strcmp(argv[i], "--histogram-vertical") == 0) 
-        {
-            config.do_histogram = 1;
-            config.histogram_vertical = 1;
-        } 
-        else if (strcmp(argv[i], "--histogram-horizontal") == 0) 
-        {
-            config.do_histogram = 1;
-            config.histogram_vertical = 0;
-        } 
-        else if (strcmp(argv[i], "--compress") == 0) 
-        {
-            config.do_compress = 1;
-        } 
-        else if (strcmp(argv[i], "--decompress") == 0) 
-        {
-            config.do_decompress = 1;
-        } 
-        else if (strcmp(argv[i], "--export-stats") == 0 && i + 1 < argc) 
-        {
-            strncpy(config.export_stats_file, argv[++i], MAX_FILENAME_LENGTH - 1);
-            config.do_export_stats = 1;
-        } 
-        else if (strcmp(argv[i], "--errors") == 0 && i + 1 < argc) 
-        {
-            config.errors_count = atoi(argv[++i]);
-        } 
-        else if (strcmp(argv[i], "--no-color") == 0) 
-        {
-            config.no_color = 1;
-        } 
-        else if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc) 
-        {
-            strncpy(config.csv_file, argv[++i], MAX_FILENAME_LENGTH - 1);
-            config.do_csv = 1;
-        } 
-        else if (strcmp(argv[i], "--file") == 0 && i + 1 < argc) 
-        {
-            strncpy(config.input_file, argv[++i], MAX_FILENAME_LENGTH - 1);
-            config.file_mode = 1;
-        } 
-        else if (strcmp(argv[i], "--mutate") == 0 && i + 1 < argc) 
-        {
-            config.mutate_count = atoi(argv[++i]);
-        } 
-        else if (strcmp(argv[i], "--random") == 0 && i + 1 < argc) 
-        {
-            config.random_length = atoi(argv[++i]);
-        } 
-        else if (strcmp(argv[i], "--compare") == 0 && i + 2 < argc) 
-        {
-            strncpy(config.compare_seq1, argv[++i], MAX_DNA_LENGTH - 1);
-            strncpy(config.compare_seq2, argv[++i], MAX_DNA_LENGTH - 1);
-            config.compare_mode = 1;
-        } 
-        else if (strcmp(argv[i], "--find") == 0 && i + 1 < argc) 
-        {
-            strncpy(config.find_pattern, argv[++i], MAX_DNA_LENGTH - 1);
-            config.do_find = 1;
-        } 
-        else if (strcmp(argv[i], "--encrypt") == 0 && i + 1 < argc) 
-        {
-            strncpy(config.encrypt_text, argv[++i], MAX_TEXT_LENGTH - 1);
-            config.encrypt_mode = 1;
-        } 
-        else if (strcmp(argv[i], "--decrypt") == 0 && i + 1 < argc) 
-        {
-            strncpy(config.decrypt_hex, argv[++i], MAX_TEXT_LENGTH - 1);
-            config.decrypt_mode = 1;
-        } 
-        else if (strcmp(argv[i], "--encrypt-file") == 0 && i + 2 < argc) 
-        {
-            strncpy(config.encrypt_file_input, argv[++i], MAX_FILENAME_LENGTH - 1);
-            strncpy(config.encrypt_file_output, argv[++i], MAX_FILENAME_LENGTH - 1);
-            config.encrypt_file_mode = 1;
-        } 
-        else if (strcmp(argv[i], "--decrypt-file") == 0 && i + 2 < argc) 
-        {
-            strncpy(config.decrypt_file_input, argv[++i], MAX_FILENAME_LENGTH - 1);
-            strncpy(config.decrypt_file_output, argv[++i], MAX_FILENAME_LENGTH - 1);
-            config.decrypt_file_mode = 1;
-        } 
-        else if (strcmp(argv[i], "--stdin") == 0) 
+
+        globfree(&matches);
+
+        return 1;
+    }
+#endif
+
+    if (*count == *capacity) 
+    {
+        *capacity = *capacity > 0 ? *capacity * 2 : 64;
+        *paths = xrealloc(*paths, sizeof(char *) * *capacity);
+    }
+
+    size_t length = strlen(spec) + 1;
+
+    (*paths)[*count] = xmalloc(length);
+    memcpy((*paths)[(*count)++], spec, length);
+
+    return 1;
+}
+
+void run_batch_mode(const options *config)
+{
+    char **paths = NULL;
+    int path_count = 0;
+    int path_capacity = 0;
+    int64_t wall_start = now_ns();
+    buffered_writer writer;
+
+    for (int i = 0; i < config->batch_input_count; i++) 
+    {
+        batch_add_input(config->batch_inputs[i], &paths, &path_count, &path_capacity);
+    }
+
+    if (path_count == 0) 
+    {
+        log_printf("Error: No input files for --batch\n");
+        free(paths);
+        return;
+    }
+
+    if (!writer_open(&writer, config->batch_output_file, 1 << 20)) 
+    {
+        for (int i = 0; i < path_count; i++) 
         {
-            config.stdin_mode = 1;
-        } 
-        else if (strcmp(argv[i], "--complexity") == 0) 
+            free(paths[i]);
+        }
+
+        free(paths);
+        return;
+    }
+
+    int thread_count = config->thread_count > 0 ? config->thread_count : default_thread_count();
+    batch_pool pool;
+    batch_file *files = xmalloc(sizeof(batch_file) * path_count);
+    batch_worker *workers = xmalloc(sizeof(batch_worker) * thread_count);
+
+    pool.config = config;
+    pool.files = files;
+    pool.deques = xmalloc(sizeof(batch_deque) * thread_count);
+    pool.file_count = path_count;
+    pool.worker_count = thread_count;
+    pool.pending = path_count;
+    pool.next_flush = 0;
+    pool.header_flushed = 0;
+    pool.failed = 0;
+    pool.chunks = 0;
+    pool.bases = 0;
+    pool.writer = &writer;
+    worker_mutex_init(&pool.flush_lock);
+
+    for (int w = 0; w < thread_count; w++) 
+    {
+        memset(&pool.deques[w], 0, sizeof(batch_deque));
+        worker_mutex_init(&pool.deques[w].lock);
+        workers[w].pool = &pool;
+        workers[w].id = w;
+    }
+
+    for (int i = 0; i < path_count; i++) 
+    {
+        batch_task task;
+
+        memset(&files[i], 0, sizeof(batch_file));
+        files[i].path = paths[i];
+        task.file = i;
+        task.chunk = NULL;
+        batch_deque_push(&pool.deques[i % thread_count], task);
+    }
+
+    run_workers(thread_count, batch_worker_run, workers, sizeof(batch_worker));
+    writer_close(&writer);
+
+    if (strcmp(config->batch_output_file, "-") != 0) 
+    {
+        log_printf("\n=== Batch ===\n\n");
+        log_printf("Files    : %d\n", path_count - pool.failed);
+
+        if (pool.failed > 0) 
         {
-            config.do_complexity = 1;
-        } 
-        else if (strcmp(argv[i], "--translate") == 0) 
+            log_printf("Failed   : %d\n", pool.failed);
+        }
+
+        log_printf("Chunks   : %lld (%lld bases)\n", (long long)pool.chunks, (long long)pool.bases);
+        log_printf("Threads  : %d\n", thread_count);
+        log_printf("Time     : %.3f seconds\n", (now_ns() - wall_start) / 1e9);
+        log_printf("Output   : %s\n\n", config->batch_output_file);
+    }
+
+    for (int w = 0; w < thread_count; w++) 
+    {
+        worker_mutex_destroy(&pool.deques[w].lock);
+        free(pool.deques[w].tasks);
+    }
+
+    for (int i = 0; i < path_count; i++) 
+    {
+        free(paths[i]);
+    }
+
+    worker_mutex_destroy(&pool.flush_lock);
+    free(pool.deques);
+    free(workers);
+    free(files);
+    free(paths);
+}
+
+typedef struct {
+    const char *key;
+    int key_length;
+    const char *value;
+    int value_length;
+} json_field;
+
+const char *json_skip_space(const char *p)
+{
+    while (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n') 
+    {
+        p++;
+    }
+
+    return p;
+}
+
+const char *json_skip_value(const char *p)
+{
+    p = json_skip_space(p);
+
+    if (*p == '"') 
+    {
+        for (p++; *p != '"'; p++) 
         {
-            config.do_translate = 1;
+            if (*p == '\0') 
+            {
+                return NULL;
+            }
+
+            if (*p == '\\' && *++p == '\0') 
+            {
+                return NULL;
+            }
         }
-        else if (strcmp(argv[i], "--rotate") == 0 && i + 1 < argc)
+
+        return p + 1;
+    }
+
+    if (*p == '{' || *p == '[') 
+    {
+        char close = *p == '{' ? '}' : ']';
+
+        p = json_skip_space(p + 1);
+
+        if (*p == close) 
         {
-            config.rotate_n = atoi(argv[++i]);
+            return p + 1;
         }
-        else if (strcmp(argv[i], "--hamming") == 0 && i + 1 < argc)
+
+        while (1) 
         {
-            config.do_hamming = 1;
-            strncpy(config.hamming_seq, argv[++i], MAX_DNA_LENGTH - 1);
-            config.hamming_seq[MAX_DNA_LENGTH - 1] = '\0';
+            if (close == '}') 
+            {
+                p = json_skip_value(p);
+
+                if (p == NULL) 
+                {
+                    return NULL;
+                }
+
+                p = json_skip_space(p);
+
+                if (*p++ != ':') 
+                {
+                    return NULL;
+                }
+            }
+
+            p = json_skip_value(p);
+
+            if (p == NULL) 
+            {
+                return NULL;
+            }
+
+            p = json_skip_space(p);
+
+            if (*p == close) 
+            {
+                return p + 1;
+            }
+
+            if (*p++ != ',') 
+            {
+                return NULL;
+            }
         }
-        else if (strcmp(argv[i], "--version") == 0 || strcmp(argv[i], "-v") == 0) 
+    }
+
+    const char *start = p;
+
+    while (*p == '-' || *p == '+' || *p == '.' || isalnum((unsigned char)*p)) 
+    {
+        p++;
+    }
+
+    return p == start ? NULL : p;
+}
+
+int json_parse_object(const char *text, json_field *fields, int max_fields)
+{
+    const char *p = json_skip_space(text);
+    int count = 0;
+
+    if (*p++ != '{') 
+    {
+        return -1;
+    }
+
+    p = json_skip_space(p);
+
+    if (*p == '}') 
+    {
+        return *json_skip_space(p + 1) == '\0' ? 0 : -1;
+    }
+
+    while (1) 
+    {
+        p = json_skip_space(p);
+
+        if (*p != '"') 
         {
-            config.show_version = 1;
+            return -1;
         }
-        else if (strcmp(argv[i], "--benchmark") == 0)
+
+        const char *key_end = json_skip_value(p);
+
+        if (key_end == NULL) 
         {
-            config.do_benchmark = 1;
+            return -1;
         }
-        else if (strcmp(argv[i], "--help") == 0 || strcmp(argv[i], "-h") == 0) 
+
+        const char *value = json_skip_space(key_end);
+
+        if (*value++ != ':') 
         {
-            print_help(argv[0]);
-            exit(0);
+            return -1;
         }
-        else if (strcmp(argv[i], "--log") == 0 && i + 1 < argc)
+
+        value = json_skip_space(value);
+
+        const char *value_end = json_skip_value(value);
+
+        if (value_end == NULL) 
         {
-            strncpy(config.log_file, argv[++i], MAX_FILENAME_LENGTH - 1);
-            config.do_log = 1;
+            return -1;
         }
-        else if (strcmp(argv[i], "--fasta") == 0 && i + 1 < argc)
+
+        if (count < max_fields) 
         {
-            strncpy(config.fasta_input_file, argv[++i], MAX_FILENAME_LENGTH - 1);
-            config.do_fasta_input = 1;
+            fields[count].key = p + 1;
+            fields[count].key_length = (int)(key_end - p - 2);
+            fields[count].value = value;
+            fields[count].value_length = (int)(value_end - value);
+            count++;
         }
-        else if (strcmp(argv[i], "--export-fasta") == 0 && i + 1 < argc)
+
+        p = json_skip_space(value_end);
+
+        if (*p == '}') 
         {
-            strncpy(config.fasta_export_file, argv[++i], MAX_FILENAME_LENGTH - 1);
-            config.do_fasta_export = 1;
+            return *json_skip_space(p + 1) == '\0' ? count : -1;
         }
-        else if (strcmp(argv[i], "--orf") == 0)
+
+        if (*p++ != ',') 
         {
-            config.do_orf = 1;
+            return -1;
         }
-        else if (strcmp(argv[i], "--position") == 0 && i + 1 < argc)
-        {
-            char b = toupper(argv[++i][0]);
+    }
+}
 
-            if (is_valid_base(b)) 
-            {
-                config.do_position = 1;
-                config.position_base = b;
-            }
+const json_field *json_get(const json_field *fields, int count, const char *key)
+{
+    int length = strlen(key);
+
+    for (int i = 0; i < count; i++) 
+    {
+        if (fields[i].key_length == length && strncmp(fields[i].key, key, length) == 0) 
+        {
+            return &fields[i];
         }
     }
 
-    return config;
+    return NULL;
 }
 
-char translate_codon(const char *codon)
+int json_decode_string(const char *value, int value_length, char *out)
 {
-    char c1 = codon[0];
-    char c2 = codon[1];
-    char c3 = codon[2];
+    int length = 0;
 
-    if (c1 == 'T') 
+    if (value_length < 2 || value[0] != '"') 
     {
-        if (c2 == 'T') 
-        {
-            if (c3 == 'T' || c3 == 'C') 
-            {
-                return 'F';
-            }
-            else if (c3 == 'A' || c3 == 'G') 
-            {
-                return 'L';
-            }
-        }
-        else if (c2 == 'C') 
-        {
-            return 'S';
-        }
-        else if (c2 == 'A') 
+        return -1;
+    }
+
+    for (int i = 1; i < value_length - 1; i++) 
+    {
+        char ch = value[i];
+
+        if (ch == '\\') 
         {
-            if (c3 == 'T' || c3 == 'C') 
-            {
-                return 'Y';
-            }
-            else if (c3 == 'A' || c3 == 'G') 
+            ch = value[++i];
+
+            if (ch == 'n') 
             {
-                return '*';
+                ch = '\n';
             }
-        }
-        else if (c2 == 'G') 
-        {
-            if (c3 == 'T' || c3 == 'C') 
+            else if (ch == 't') 
             {
-                return 'C';
+                ch = '\t';
             }
-            else if (c3 == 'A') 
+            else if (ch == 'r') 
             {
-                return '*';
+                ch = '\r';
             }
-            else if (c3 == 'G') 
+            else if (ch == 'u') 
             {
-                return 'W';
+                i += 4;
+                ch = '?';
             }
         }
+
+        out[length++] = ch;
     }
-    else if (c1 == 'C') 
+
+    out[length] = '\0';
+
+    return length;
+}
+
+int64_t json_get_integer(const json_field *fields, int count, const char *key, int64_t fallback)
+{
+    const json_field *field = json_get(fields, count, key);
+
+    return field != NULL && field->value[0] != '"' ? strtoll(field->value, NULL, 10) : fallback;
+}
+
+int serve_op_flag(const char *name, int length)
+{
+    static const char *names[] = { "clean", "mutate", "reverse_complement", "complement", "reverse", "stats", "find", "orf", "translate", "compress", "hash", "key" };
+
+    for (int i = 0; i < (int)(sizeof(names) / sizeof(names[0])); i++) 
     {
-        if (c2 == 'T') 
-        {
-            return 'L';
-        }
-        else if (c2 == 'C') 
+        if ((int)strlen(names[i]) == length && strncmp(names[i], name, length) == 0) 
         {
-            return 'P';
+            return 1 << i;
         }
-        else if (c2 == 'A') 
+    }
+
+    return 0;
+}
+
+int serve_parse_ops(const json_field *field, char *unknown)
+{
+    int flags = 0;
+    const char *p = field->value;
+    const char *end = field->value + field->value_length;
+
+    if (p == end || *p++ != '[') 
+    {
+        return -1;
+    }
+
+    p = json_skip_space(p);
+
+    if (p < end && *p == ']') 
+    {
+        return p + 1 == end ? 0 : -1;
+    }
+
+    while (p < end) 
+    {
+        if (*p++ != '"') 
         {
-            if (c3 == 'T' || c3 == 'C') 
-            {
-                return 'H';
-            }
-            else if (c3 == 'A' || c3 == 'G') 
-            {
-                return 'Q';
-            }
+            return -1;
         }
-        else if (c2 == 'G') 
+
+        const char *name = p;
+
+        while (p < end && (isalnum((unsigned char)*p) || *p == '_')) 
         {
-            return 'R';
+            p++;
         }
-    }
-    else if (c1 == 'A') 
-    {
-        if (c2 == 'T') 
+
+        if (p == name || p == end || *p++ != '"') 
         {
-            if (c3 == 'T' || c3 == 'C' || c3 == 'A') 
-            {
-                return 'I';
-            }
-            else if (c3 == 'G') 
-            {
-                return 'M';
-            }
+            return -1;
         }
-        else if (c2 == 'C') 
+
+        int flag = serve_op_flag(name, (int)(p - 1 - name));
+
+        if (flag == 0 && unknown[0] == '\0') 
         {
-            return 'T';
+            int length = (int)(p - 1 - name) < 63 ? (int)(p - 1 - name) : 63;
+
+            memcpy(unknown, name, length);
+            unknown[length] = '\0';
         }
-        else if (c2 == 'A') 
+
+        flags |= flag;
+        p = json_skip_space(p);
+
+        if (p < end && *p == ']') 
         {
-            if (c3 == 'T' || c3 == 'C') 
-            {
-                return 'N';
-            }
-            else if (c3 == 'A' || c3 == 'G') 
-            {
-                return 'K';
-            }
+            return p + 1 == end ? flags : -1;
         }
-        else if (c2 == 'G') 
+
+        if (p == end || *p++ != ',') 
         {
-            if (c3 == 'T' || c3 == 'C') 
-            {
-                return 'S';
-            }
-            else if (c3 == 'A' || c3 == 'G') 
-            {
-                return 'R';
-            }
+            return -1;
         }
+
+        p = json_skip_space(p);
     }
-    else if (c1 == 'G') 
+
+    return -1;
+}
+
+void serve_begin(record_writer *writer, const json_field *id, int ok)
+{
+    writer->format = FORMAT_NDJSON;
+    writer->buffer.length = 0;
+    writer->depth = 0;
+
+    record_begin_map(writer);
+
+    if (id != NULL) 
     {
-        if (c2 == 'T') 
-        {
-            return 'V';
-        }
-        else if (c2 == 'C') 
+        record_key(writer, "id");
+        record_json(writer, id->value, id->value_length);
+    }
+
+    record_key(writer, "ok");
+    record_bool(writer, ok);
+}
+
+void serve_error(record_writer *writer, const json_field *id, const char *message)
+{
+    serve_begin(writer, id, 0);
+    record_key(writer, "error");
+    record_string(writer, message, strlen(message));
+    record_close(writer);
+    text_append(&writer->buffer, "\n", 1);
+}
+
+void handle_serve_request(const char *line, record_writer *writer, rng_state *rng, scratch_arena *scratch)
+{
+    json_field fields[16];
+    int64_t start = now_ns();
+    int count = json_parse_object(line, fields, 16);
+
+    if (count < 0) 
+    {
+        serve_error(writer, NULL, "invalid JSON object");
+        return;
+    }
+
+    const json_field *id = json_get(fields, count, "id");
+    const json_field *sequence_field = json_get(fields, count, "sequence");
+    const json_field *ops_field = json_get(fields, count, "ops");
+    char unknown[64] = "";
+
+    if (sequence_field == NULL || sequence_field->value[0] != '"') 
+    {
+        serve_error(writer, id, "missing \"sequence\" string");
+        return;
+    }
+
+    int ops = ops_field != NULL ? serve_parse_ops(ops_field, unknown) : SERVE_OP_STATS;
+
+    if (ops < 0) 
+    {
+        serve_error(writer, id, "\"ops\" must be an array of operation names");
+        return;
+    }
+
+    if (unknown[0] != '\0') 
+    {
+        char message[128];
+
+        snprintf(message, sizeof(message), "unknown operation '%s'", unknown);
+        serve_error(writer, id, message);
+        return;
+    }
+
+    const json_field *pattern_field = json_get(fields, count, "pattern");
+    char pattern[MAX_DNA_LENGTH] = "";
+
+    if ((ops & SERVE_OP_FIND) && (pattern_field == NULL || pattern_field->value_length >= MAX_DNA_LENGTH || json_decode_string(pattern_field->value, pattern_field->value_length, pattern) <= 0)) 
+    {
+        serve_error(writer, id, "\"find\" needs a non-empty \"pattern\" string");
+        return;
+    }
+
+    const json_field *seed = json_get(fields, count, "seed");
+    rng_state seeded;
+
+    if (seed != NULL) 
+    {
+        char *seed_end;
+
+        errno = 0;
+
+        uint64_t value = strtoull(seed->value, &seed_end, 10);
+
+        if (!isdigit((unsigned char)seed->value[0]) || seed_end != seed->value + seed->value_length || errno == ERANGE) 
         {
-            return 'A';
+            serve_error(writer, id, "\"seed\" must be a non-negative integer");
+            return;
         }
-        else if (c2 == 'A') 
+
+        rng_seed(&seeded, value);
+    }
+
+    char *sequence = arena_alloc(scratch, sequence_field->value_length + 1);
+    int length = json_decode_string(sequence_field->value, sequence_field->value_length, sequence);
+
+    if (ops & SERVE_OP_CLEAN) 
+    {
+        clean_sequence(sequence);
+        length = strlen(sequence);
+    }
+
+    if (ops & SERVE_OP_MUTATE) 
+    {
+
+        substitute_random_positions(seed != NULL ? &seeded : rng, sequence, length, json_get_integer(fields, count, "count", 1));
+    }
+
+    if (ops & SERVE_OP_REVERSE_COMPLEMENT) 
+    {
+        reverse_complement_sequence(sequence);
+    }
+    else 
+    {
+        if (ops & SERVE_OP_COMPLEMENT) 
         {
-            if (c3 == 'T' || c3 == 'C') 
-            {
-                return 'D';
-            }
-            else if (c3 == 'A' || c3 == 'G') 
-            {
-                return 'E';
-            }
+            make_complement(sequence);
         }
-        else if (c2 == 'G') 
+
+        if (ops & SERVE_OP_REVERSE) 
         {
-            return 'G';
+            reverse_sequence(sequence);
         }
     }
 
-    return 'X';
+    options request;
+
+    options_init(&request);
+    request.output_format = FORMAT_NDJSON;
+    request.show_stats = (ops & SERVE_OP_STATS) != 0;
+    request.do_find = (ops & SERVE_OP_FIND) != 0;
+    request.find_pattern = pattern;
+    request.do_orf = (ops & SERVE_OP_ORF) != 0;
+    request.do_translate = (ops & SERVE_OP_TRANSLATE) != 0;
+    request.do_compress = (ops & SERVE_OP_COMPRESS) != 0;
+    request.do_hash = (ops & SERVE_OP_HASH) != 0;
+    request.do_key = (ops & SERVE_OP_KEY) != 0;
+
+    serve_begin(writer, id, 1);
+    write_sequence_fields(writer, sequence, length, &request, (ops & (SERVE_OP_CLEAN | SERVE_OP_MUTATE | SERVE_OP_REVERSE_COMPLEMENT | SERVE_OP_COMPLEMENT | SERVE_OP_REVERSE)) != 0, scratch);
+    record_key(writer, "elapsed_us");
+    record_double(writer, (now_ns() - start) / 1e3);
+    record_close(writer);
+    text_append(&writer->buffer, "\n", 1);
+    arena_reset(scratch);
 }
 
-void translate_sequence(const char *sequence) 
+#ifndef _WIN32
+typedef struct {
+    int fd;
+    pthread_mutex_t lock;
+    int references;
+} serve_connection;
+
+typedef struct {
+    char *line;
+    serve_connection *connection;
+} serve_job;
+
+typedef struct {
+    serve_job *jobs;
+    int capacity;
+    int head;
+    int count;
+    int closed;
+    pthread_mutex_t mutex;
+    pthread_cond_t not_empty;
+    pthread_cond_t not_full;
+} serve_queue;
+
+typedef struct {
+    serve_queue *queue;
+    rng_state rng;
+    scratch_arena scratch;
+} serve_worker;
+
+typedef struct {
+    serve_queue *queue;
+    serve_connection *connection;
+    FILE *input;
+} serve_reader;
+
+void serve_connection_release(serve_connection *connection)
 {
-    log_printf("\n=== Translation to Amino Acids ===\n\n");
+    pthread_mutex_lock(&connection->lock);
 
-    int len = strlen(sequence);
-    int start_index = -1;
-    int i;
+    int remaining = --connection->references;
 
-    for (i = 0; i + 2 < len; i++) 
+    pthread_mutex_unlock(&connection->lock);
+
+    if (remaining == 0) 
     {
-        if (sequence[i] == 'A' && sequence[i + 1] == 'T' && sequence[i + 2] == 'G') 
+        if (connection->fd != STDOUT_FILENO) 
         {
-            start_index = i;
-            break;
+            close(connection->fd);
         }
+
+        pthread_mutex_destroy(&connection->lock);
+        free(connection);
     }
+}
 
-    if (start_index == -1) 
+serve_connection *serve_connection_create(int fd)
+{
+    serve_connection *connection = xmalloc(sizeof(serve_connection));
+
+    connection->fd = fd;
+    connection->references = 1;
+    pthread_mutex_init(&connection->lock, NULL);
+
+    return connection;
+}
+
+void serve_queue_push(serve_queue *queue, char *line, serve_connection *connection)
+{
+    pthread_mutex_lock(&connection->lock);
+    connection->references++;
+    pthread_mutex_unlock(&connection->lock);
+
+    pthread_mutex_lock(&queue->mutex);
+
+    while (queue->count == queue->capacity) 
     {
-        log_printf("No start codon found.\n");
-        log_printf("\n");
-        return;
+        pthread_cond_wait(&queue->not_full, &queue->mutex);
     }
 
-    for (i = start_index; i + 2 < len; i += 3) 
+    serve_job *job = &queue->jobs[(queue->head + queue->count) % queue->capacity];
+
+    job->line = line;
+    job->connection = connection;
+    queue->count++;
+    pthread_cond_signal(&queue->not_empty);
+    pthread_mutex_unlock(&queue->mutex);
+}
+
+int serve_queue_pop(serve_queue *queue, serve_job *job)
+{
+    pthread_mutex_lock(&queue->mutex);
+
+    while (queue->count == 0 && !queue->closed) 
+    {
+        pthread_cond_wait(&queue->not_empty, &queue->mutex);
+    }
+
+    if (queue->count == 0) 
     {
-        char codon[4];
+        pthread_mutex_unlock(&queue->mutex);
+        return 0;
+    }
+
+    *job = queue->jobs[queue->head];
+    queue->head = (queue->head + 1) % queue->capacity;
+    queue->count--;
+    pthread_cond_signal(&queue->not_full);
+    pthread_mutex_unlock(&queue->mutex);
 
-        codon[0] = sequence[i];
-        codon[1] = sequence[i + 1];
-        codon[2] = sequence[i + 2];
-        codon[3] = '\0';
+    return 1;
+}
 
-        char aa = translate_codon(codon);
+void serve_write(serve_connection *connection, const char *data, size_t length)
+{
+    pthread_mutex_lock(&connection->lock);
 
-        if (aa == '*') 
+    while (length > 0) 
+    {
+        ssize_t written = write(connection->fd, data, length);
+
+        if (written <= 0) 
         {
             break;
         }
 
-        log_printf("%c", aa);
+        data += written;
+        length -= (size_t)written;
     }
 
-    log_printf("\n");
+    pthread_mutex_unlock(&connection->lock);
 }
 
-void rotate_sequence(char *sequence, int n)
+void *serve_worker_loop(void *arg)
 {
-    int length = strlen(sequence);
+    serve_worker *worker = arg;
+    record_writer writer;
+    serve_job job;
 
-    if (length == 0) 
-    {
-        return;
-    }
+    memset(&writer, 0, sizeof(writer));
 
-    if (n < 0) 
-    {
-        n = length + (n % length);
-    } 
-    else 
+    while (serve_queue_pop(worker->queue, &job)) 
     {
-        n = n % length;
+        handle_serve_request(job.line, &writer, &worker->rng, &worker->scratch);
+        serve_write(job.connection, writer.buffer.data, writer.buffer.length);
+        free(job.line);
+        serve_connection_release(job.connection);
     }
 
-    if (n == 0) 
+    free(writer.buffer.data);
+    arena_free(&worker->scratch);
+
+    return NULL;
+}
+
+void *serve_reader_loop(void *arg)
+{
+    serve_reader *reader = arg;
+    char *line = NULL;
+    size_t capacity = 0;
+
+    while (read_line(reader->input, &line, &capacity)) 
     {
-        return;
+        if (line[0] == '\0') 
+        {
+            continue;
+        }
+
+        char *copy = xmalloc(strlen(line) + 1);
+
+        strcpy(copy, line);
+        serve_queue_push(reader->queue, copy, reader->connection);
     }
 
-    char temp[MAX_DNA_LENGTH];
-    int i;
+    free(line);
 
-    for (i = 0; i < length; i++) 
+    if (reader->input == stdin) 
     {
-        temp[(i + n) % length] = sequence[i];
+        pthread_mutex_lock(&reader->queue->mutex);
+        reader->queue->closed = 1;
+        pthread_cond_broadcast(&reader->queue->not_empty);
+        pthread_mutex_unlock(&reader->queue->mutex);
     }
-
-    for (i = 0; i < length; i++) 
+    else 
     {
-        sequence[i] = temp[i];
+        fclose(reader->input);
     }
 
-    sequence[length] = '\0';
+    serve_connection_release(reader->connection);
+    free(reader);
+
+    return NULL;
 }
 
-void check_palindrome(const char *sequence)
+void *serve_accept_loop(void *arg)
 {
-    int length = strlen(sequence);
+    serve_reader *listener = arg;
+    int server = listener->connection->fd;
 
-    if (length == 0) 
+    while (1) 
     {
-        log_printf("\nPalindrome: No\n");
-        return;
-    }
+        int client = accept(server, NULL, NULL);
 
-    char revcomp[MAX_DNA_LENGTH];
-    int i;
+        if (client < 0) 
+        {
+            continue;
+        }
 
-    for (i = 0; i < length; i++) 
-    {
-        revcomp[i] = complement_base(sequence[length - 1 - i]);
-    }
+        int input_fd = dup(client);
+        serve_reader *reader = xmalloc(sizeof(serve_reader));
+        pthread_t thread;
 
-    revcomp[length] = '\0';
+        reader->queue = listener->queue;
+        reader->connection = serve_connection_create(client);
+        reader->input = input_fd >= 0 ? fdopen(input_fd, "r") : NULL;
 
-    for (i = 0; i < length; i++) 
-    {
-        if (sequence[i] != revcomp[i]) 
+        if (reader->input == NULL || pthread_create(&thread, NULL, serve_reader_loop, reader) != 0) 
         {
-            log_printf("\nPalindrome: No\n");
-            return;
+            if (reader->input != NULL) 
+            {
+                fclose(reader->input);
+            }
+
+            serve_connection_release(reader->connection);
+            free(reader);
+            continue;
         }
+
+        pthread_detach(thread);
     }
 
-    log_printf("\nPalindrome: Yes\n");
+    return NULL;
 }
 
-int read_fasta_single_sequence(const char *filename, char *sequence) 
+void run_serve_mode(const options *config)
 {
-    FILE *file = fopen(filename, "r");
+    int thread_count = config->thread_count > 0 ? config->thread_count : default_thread_count();
+    serve_queue queue;
+    serve_worker *workers = xmalloc(sizeof(serve_worker) * thread_count);
+    serve_reader *reader = xmalloc(sizeof(serve_reader));
+    rng_state stream = global_rng;
+    pthread_t thread;
+    int server = -1;
 
-    if (file == NULL) 
+    memset(&queue, 0, sizeof(queue));
+    queue.capacity = 1024 * thread_count;
+    queue.jobs = xmalloc(sizeof(serve_job) * queue.capacity);
+    pthread_mutex_init(&queue.mutex, NULL);
+    pthread_cond_init(&queue.not_empty, NULL);
+    pthread_cond_init(&queue.not_full, NULL);
+    signal(SIGPIPE, SIG_IGN);
+
+    for (int t = 0; t < thread_count; t++) 
     {
-        log_printf("Error: Could not open FASTA file '%s'\n", filename);
-        return 0;
+        workers[t].queue = &queue;
+        workers[t].rng = stream;
+        memset(&workers[t].scratch, 0, sizeof(scratch_arena));
+        rng_jump(&stream);
     }
 
-    char line[1024];
-    int seq_started = 0;
-    int seq_len = 0;
+    reader->queue = &queue;
 
-    while (fgets(line, sizeof(line), file) != NULL) 
+    if (config->serve_socket[0] != '\0') 
     {
-        if (line[0] == '>') 
+        struct sockaddr_un address;
+
+        size_t path_length = strlen(config->serve_socket);
+
+        memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        server = path_length < sizeof(address.sun_path) ? socket(AF_UNIX, SOCK_STREAM, 0) : -1;
+        memcpy(address.sun_path, config->serve_socket, path_length < sizeof(address.sun_path) ? path_length : 0);
+        unlink(config->serve_socket);
+
+        if (server < 0 || bind(server, (struct sockaddr *)&address, sizeof(address)) != 0 || listen(server, 64) != 0) 
         {
-            if (seq_started) 
+            log_printf("Error: Could not listen on socket '%s'\n", config->serve_socket);
+
+            if (server >= 0) 
             {
-                break;
+                close(server);
             }
 
-            seq_started = 1;
-            continue;
+            free(reader);
+            free(workers);
+            free(queue.jobs);
+            return;
         }
 
-        if (!seq_started) 
+        fprintf(stderr, "Serving on %s with %d worker(s)\n", config->serve_socket, thread_count);
+        reader->connection = serve_connection_create(server);
+        pthread_create(&thread, NULL, serve_accept_loop, reader);
+    }
+    else 
+    {
+        reader->connection = serve_connection_create(STDOUT_FILENO);
+        reader->input = stdin;
+        pthread_create(&thread, NULL, serve_reader_loop, reader);
+    }
+
+    run_workers(thread_count, serve_worker_loop, workers, sizeof(serve_worker));
+    pthread_join(thread, NULL);
+
+    pthread_mutex_destroy(&queue.mutex);
+    pthread_cond_destroy(&queue.not_empty);
+    pthread_cond_destroy(&queue.not_full);
+    free(queue.jobs);
+    free(workers);
+}
+#else
+void run_serve_mode(const options *config)
+{
+    record_writer writer;
+    char *line = NULL;
+    size_t capacity = 0;
+
+    memset(&writer, 0, sizeof(writer));
+
+    if (config->serve_socket[0] != '\0') 
+    {
+        log_printf("Error: --serve-socket is not supported on this platform\n");
+        return;
+    }
+
+    while (read_line(stdin, &line, &capacity)) 
+    {
+        if (line[0] == '\0') 
         {
             continue;
         }
 
-        int i = 0;
+        handle_serve_request(line, &writer, &global_rng, &global_arena);
+        fwrite(writer.buffer.data, 1, writer.buffer.length, stdout);
+        fflush(stdout);
+    }
 
-        while (line[i] != '\0' && line[i] != '\n' && line[i] != '\r') 
+    free(line);
+    free(writer.buffer.data);
+}
+#endif
+
+void run_hamming_mode(const char *sequence, hamming_state *state)
+{
+    state->line_number++;
+    pack_sequence(sequence, &state->input);
+
+    if (state->input.length != state->reference.length) 
+    {
+        if (state->top_n == 0) 
         {
-            char base = toupper(line[i]);
+            log_printf("\nError: Sequences have different lengths. Cannot compute Hamming distance.\n\n");
+        }
 
-            if (is_valid_base(base)) 
-            {
-                if (seq_len < MAX_DNA_LENGTH - 1) 
-                {
-                    sequence[seq_len] = base;
-                    seq_len++;
-                }
-            }
+        return;
+    }
 
-            i++;
+    int limit = state->max_dist;
+
+    if (state->top_n > 0 && state->hit_count == state->top_n) 
+    {
+        int worst = state->hits[0].distance;
+
+        if (limit < 0 || worst - 1 < limit) 
+        {
+            limit = worst - 1;
+        }
+
+        if (limit < 0) 
+        {
+            return;
         }
     }
 
-    fclose(file);
+    profile_mark mark = profile_begin();
+    int hamming_distance = packed_hamming_distance(&state->input, &state->reference, limit);
 
-    sequence[seq_len] = '\0';
+    profile_end(STAGE_HAMMING, mark, state->input.length);
 
-    if (seq_len == 0) 
+    if (state->top_n > 0) 
     {
-        log_printf("Error: No DNA sequence found in FASTA file '%s'\n", filename);
-        return 0;
+        if (limit < 0 || hamming_distance <= limit) 
+        {
+            hamming_heap_push(state, hamming_distance);
+        }
+
+        return;
     }
 
-    return 1;
+    log_printf("\n=== Hamming Distance ===\n\n");
+
+    if (limit >= 0 && hamming_distance > limit) 
+    {
+        log_printf("> %d\n\n", limit);
+        return;
+    }
+
+    log_printf("%d\n\n", hamming_distance);
 }
 
-int export_fasta_sequence(const char *filename, const char *sequence) 
+int parse_region(const fai_index *index, const char *text, const fai_entry **entry, int64_t *begin, int64_t *end)
 {
-    FILE *file = fopen(filename, "w");
+    const char *colon = strrchr(text, ':');
+    int name_length = strlen(text);
+    long long start = 1;
+    long long stop = -1;
 
-    if (file == NULL) 
+    *entry = fai_find(index, text, name_length);
+
+    if (*entry == NULL && colon != NULL) 
     {
-        log_printf("Error: Could not open output FASTA file '%s' for writing\n", filename);
-        return 0;
-    }
+        char range[64];
+        int length = 0;
 
-    fprintf(file, ">dnashield_output\n");
+        for (const char *c = colon + 1; *c != '\0' && length < (int)sizeof(range) - 1; c++) 
+        {
+            if (*c != ',') 
+            {
+                range[length++] = *c;
+            }
+        }
 
-    int length = strlen(sequence);
-    int pos = 0;
+        range[length] = '\0';
 
-    while (pos < length) 
-    {
-        int line_len = 60;
+        char extra;
+        int fields = sscanf(range, "%lld-%lld%c", &start, &stop, &extra);
 
-        if (length - pos < 60) 
+        if (fields < 1 || fields > 2) 
         {
-            line_len = length - pos;
+            log_printf("Error: Malformed region '%s' (expected name:start-end)\n", text);
+            return 0;
         }
 
-        fwrite(sequence + pos, 1, line_len, file);
-        fprintf(file, "\n");
+        name_length = (int)(colon - text);
+        *entry = fai_find(index, text, name_length);
+    }
 
-        pos += line_len;
+    if (*entry == NULL) 
+    {
+        log_printf("Error: Unknown sequence '%.*s' in region '%s'\n", name_length, text, text);
+        return 0;
     }
 
-    fclose(file);
+    *begin = start - 1;
+    *end = stop < 0 || stop > (*entry)->length ? (*entry)->length : stop;
 
     return 1;
 }
 
-void print_orf(const char *sequence, int frame, int start, int end) 
+int process_region(FILE *fasta, const fai_entry *entry, int64_t begin, int64_t end, char **sequence, int64_t *capacity, const options *config)
 {
-    int length = end - start + 1;
+    if (begin < 0 || begin >= end) 
+    {
+        log_printf("Error: Region %.*s:%lld-%lld is empty or outside the sequence (length %lld)\n", entry->name_length, entry->name, (long long)begin + 1, (long long)end, (long long)entry->length);
+        return 0;
+    }
 
-    if (length <= 0) 
+    if (end - begin > MAX_DNA_LENGTH - 1) 
     {
-        return;
+        end = begin + MAX_DNA_LENGTH - 1;
     }
 
-    char aa_sequence[MAX_DNA_LENGTH];
-    int aa_index = 0;
+    if (fai_fetch(fasta, entry, begin, end, sequence, capacity) < 0) 
+    {
+        return 0;
+    }
 
-    for (int i = start; i + 2 <= end; i += 3) 
+    if (config->output_format == FORMAT_TEXT) 
     {
-        char codon[4];
+        log_printf("\n=== Region %.*s:%lld-%lld ===\n", entry->name_length, entry->name, (long long)begin + 1, (long long)end);
+    }
 
-        codon[0] = sequence[i];
-        codon[1] = sequence[i + 1];
-        codon[2] = sequence[i + 2];
-        codon[3] = '\0';
+    process_sequence(*sequence, config);
 
-        char aa = translate_codon(codon);
+    return 1;
+}
 
-        if (aa == '*') 
-        {
-            break;
-        }
+int run_region_mode(const options *config)
+{
+    fai_index index;
+    char *sequence = NULL;
+    int64_t capacity = MAX_DNA_LENGTH;
+    int status = 1;
 
-        aa_sequence[aa_index] = aa;
-        aa_index++;
+    if (!fai_open(&index, config->fasta_input_file)) 
+    {
+        return 0;
     }
 
-    aa_sequence[aa_index] = '\0';
+    FILE *fasta = fopen(config->fasta_input_file, "rb");
 
-    log_printf("Frame %d: Start=%d End=%d Length=%d\n", frame, start, end, length);
-    log_printf("Amino Acid Sequence: %s\n\n", aa_sequence);
-}
+    if (fasta == NULL) 
+    {
+        log_printf("Error: Could not open FASTA file '%s'\n", config->fasta_input_file);
+        fai_close(&index);
+        return 0;
+    }
 
-void find_orfs(const char *sequence) 
-{
-    int seq_len = strlen(sequence);
+    sequence = xmalloc((size_t)capacity);
 
-    log_printf("\n=== Open Reading Frames (ORFs) ===\n\n");
+    if (config->region[0] != '\0') 
+    {
+        const fai_entry *entry;
+        int64_t begin;
+        int64_t end;
 
-    for (int frame = 0; frame < 3; frame++) 
+        status = parse_region(&index, config->region, &entry, &begin, &end) && process_region(fasta, entry, begin, end, &sequence, &capacity, config);
+    }
+
+    if (config->regions_file[0] != '\0') 
     {
-        int i = frame;
+        FILE *bed = fopen(config->regions_file, "r");
 
-        while (i + 2 < seq_len) 
+        if (bed == NULL) 
+        {
+            log_printf("Error: Could not open regions file '%s'\n", config->regions_file);
+            status = 0;
+        }
+        else 
         {
-            if (sequence[i] == 'A' && sequence[i + 1] == 'T' && sequence[i + 2] == 'G') 
+            char *line = NULL;
+            size_t line_capacity = 0;
+            long line_number = 0;
+
+            while (read_line(bed, &line, &line_capacity)) 
             {
-                int start = i;
-                int j = i + 3;
-                int found_stop = 0;
+                char name[MAX_FILENAME_LENGTH];
+                long long begin;
+                long long end;
 
-                while (j + 2 < seq_len) 
+                line_number++;
+
+                if (line[0] == '#' || line[0] == '\0' || strncmp(line, "track", 5) == 0 || strncmp(line, "browser", 7) == 0) 
                 {
-                    char codon[4];
+                    continue;
+                }
 
-                    codon[0] = sequence[j];
-                    codon[1] = sequence[j + 1];
-                    codon[2] = sequence[j + 2];
-                    codon[3] = '\0';
+                if (sscanf(line, "%255s %lld %lld", name, &begin, &end) != 3) 
+                {
+                    log_printf("Error: Malformed BED line %ld in '%s'\n", line_number, config->regions_file);
+                    status = 0;
+                    continue;
+                }
 
-                    if (strcmp(codon, "TAA") == 0 || strcmp(codon, "TAG") == 0 || strcmp(codon, "TGA") == 0) 
-                    {
-                        found_stop = 1;
-                        break;
-                    }
+                const fai_entry *entry = fai_find(&index, name, strlen(name));
 
-                    j += 3;
+                if (entry == NULL) 
+                {
+                    log_printf("Error: Unknown sequence '%s' on BED line %ld\n", name, line_number);
+                    status = 0;
+                    continue;
                 }
 
-                if (found_stop) 
+                if (end > entry->length) 
                 {
-                    print_orf(sequence, frame, start, j + 2);
-                    i = j + 3;
-                } 
-                else 
+                    end = entry->length;
+                }
+
+                if (!process_region(fasta, entry, begin, end, &sequence, &capacity, config)) 
                 {
-                    print_orf(sequence, frame, start, seq_len - 1);
-                    break;
+                    status = 0;
                 }
-            } 
-            else 
-            {
-                i += 3;
             }
+
+            free(line);
+            fclose(bed);
         }
     }
+
+    free(sequence);
+    fclose(fasta);
+    fai_close(&index);
+
+    return status;
 }
 
-void process_sequence(char *sequence, options config) 
+int main(int argc, char *argv[]) 
 {
-    char work_seq[MAX_DNA_LENGTH];
+    char sequence[MAX_DNA_LENGTH];
 
-    strcpy(work_seq, sequence);
+    options config = parse_args(argc, argv);
 
-    if (config.do_decompress == 1) 
+    if (!config.has_seed) 
     {
-        char decompressed[MAX_DNA_LENGTH];
-
-        decompress_sequence(work_seq, decompressed);
+        config.seed = (uint64_t)time(NULL) ^ (uint64_t)now_ns();
+    }
 
-        log_printf("\n=== Decompressed Sequence ===\n\n");
-        log_printf("%s\n", decompressed);
+    init_random_base_table();
+    init_fasta_base_table();
+    rng_seed(&global_rng, config.seed);
+    io_backend = config.io_backend;
 
-        strcpy(work_seq, decompressed);
-    } 
-    else 
+    if (config.do_log == 1) 
     {
-        clean_sequence(work_seq);
-    }
+        log_fp = fopen(config.log_file, "w");
 
-    if (config.mutate_count > 0) 
-    {
-        mutate_sequence(work_seq, config.mutate_count);
+        if (log_fp == NULL) 
+        {
+            printf("Error: Could not open log file '%s' for writing.\n", config.log_file);
+            return 1;
+        }
     }
 
-    if (config.errors_count > 0) 
+    if (config.do_profile == 1) 
     {
-        inject_errors(work_seq, config.errors_count);
+        profile_start();
     }
 
-    if (config.do_reverse_complement == 1) 
-    {
-        reverse_complement_sequence(work_seq);
-    } 
-    else 
+    if (config.show_version == 1) 
     {
-        if (config.do_complement == 1) 
+        printf("\n%s version %s\n", argv[0], PROGRAM_VERSION);
+        printf("Build date: %s %s\n\n", BUILD_DATE, BUILD_TIME);
+
+        if (log_fp != NULL) 
         {
-            make_complement(work_seq);
+            fprintf(log_fp, "\n%s version %s\n", argv[0], PROGRAM_VERSION);
+            fprintf(log_fp, "Build date: %s %s\n\n", BUILD_DATE, BUILD_TIME);
         }
 
-        if (config.do_reverse == 1) 
+        if (log_fp != NULL) 
         {
-            reverse_sequence(work_seq);
+            fclose(log_fp);
         }
-    }
 
-    if (config.rotate_n != 0) 
-    {
-        rotate_sequence(work_seq, config.rotate_n);
+        return 0;
     }
 
-    if (config.do_find == 1 && config.find_pattern[0] != '\0') 
+    if (config.batch_input_count > 0) 
     {
-        find_pattern(work_seq, config.find_pattern, config.no_color ? 0 : 1);
-    }
+        run_batch_mode(&config);
+        profile_report(&config);
 
-    if (config.do_palindrome == 1) 
-    {
-        check_palindrome(work_seq);
-    }
+        if (log_fp != NULL) 
+        {
+            fclose(log_fp);
+        }
 
-    if (config.do_orf == 1) 
-    {
-        find_orfs(work_seq);
+        return 0;
     }
 
-    if (config.do_position == 1) 
+    if (config.faidx_file[0] != '\0') 
     {
-        print_positions_of_base(work_seq, config.position_base);
-    }
+        int success = run_faidx_mode(&config);
 
-    if (config.show_json == 1) 
-    {
-        print_json(work_seq);
-    }
+        if (log_fp != NULL) 
+        {
+            fclose(log_fp);
+        }
 
-    if (config.do_binary == 1) 
-    {
-        print_binary(work_seq);
+        return success ? 0 : 1;
     }
 
-    if (config.do_hex == 1) 
+    if (config.kmer_size > 0) 
     {
-        print_hex(work_seq);
-    }
+        run_kmer_count_mode(&config);
 
-    if (config.do_key == 1) 
-    {
-        derive_key(work_seq);
-    }
+        if (log_fp != NULL) 
+        {
+            fclose(log_fp);
+        }
 
-    if (config.do_hash == 1) 
-    {
-        derive_hash(work_seq);
+        return 0;
     }
 
-    if (config.encrypt_mode == 1) 
+    if (config.do_sketch == 1) 
     {
-        encrypt_text_with_dna_key(work_seq, config.encrypt_text);
-    }
+        run_sketch_mode(&config);
 
-    if (config.decrypt_mode == 1) 
-    {
-        decrypt_hex_with_dna_key(work_seq, config.decrypt_hex);
-    }
+        if (log_fp != NULL) 
+        {
+            fclose(log_fp);
+        }
 
-    if (config.do_qrcode == 1) 
-    {
-        print_qrcode(work_seq);
+        return 0;
     }
 
-    if (config.do_histogram == 1) 
+    if (config.do_compare_sketch == 1) 
     {
-        if (config.histogram_vertical) 
-        {
-            print_histogram_vertical(work_seq, config.no_color);
-        } 
-        else 
+        run_compare_sketch_mode(&config);
+
+        if (log_fp != NULL) 
         {
-            print_histogram_horizontal(work_seq, config.no_color);
+            fclose(log_fp);
         }
-    }
-
-    if (config.do_compress == 1) 
-    {
-        print_compressed(work_seq);
-    }
 
-    if (config.do_complexity == 1) 
-    {
-        print_complexity(work_seq);
+        return 0;
     }
 
-    if (config.do_translate == 1) 
+    if (config.do_serve == 1) 
     {
-        translate_sequence(work_seq);
-    }
+        run_serve_mode(&config);
 
-    if (config.show_ascii == 1) 
-    {
-        print_sequence(work_seq);
-    }
+        if (log_fp != NULL) 
+        {
+            fclose(log_fp);
+        }
 
-    if (config.show_stats == 1) 
-    {
-        print_stats(work_seq);
+        return 0;
     }
 
-    if (config.show_summary == 1) 
+    if (config.do_bench_suite == 1) 
     {
-        print_summary(work_seq);
-    }
+        run_bench_suite(&config);
 
-    if (config.do_csv == 1) 
-    {
-        export_csv(config.csv_file, work_seq);
-    }
+        if (log_fp != NULL) 
+        {
+            fclose(log_fp);
+        }
 
-    if (config.do_export_stats == 1) 
-    {
-        export_stats_json(config.export_stats_file, work_seq);
+        return 0;
     }
 
-    if (config.do_fasta_export == 1) 
+    if (config.do_demux == 1) 
     {
-        int success = export_fasta_sequence(config.fasta_export_file, work_seq);
+        run_demux_mode(&config);
 
-        if (success) 
+        if (log_fp != NULL) 
         {
-            log_printf("\nFASTA export completed: %s\n\n", config.fasta_export_file);
+            fclose(log_fp);
         }
-    }
-
-    log_printf("\n");
-}
-
-void run_compare_mode(options config) 
-{
-    clean_sequence(config.compare_seq1);
-    clean_sequence(config.compare_seq2);
 
-    int diff = count_differences(config.compare_seq1, config.compare_seq2);
-
-    log_printf("\n=== Comparing Sequences ===\n\n");
+        return 0;
+    }
 
-    log_printf("Sequence 1: %s\n", config.compare_seq1);
-    log_printf("Sequence 2: %s\n", config.compare_seq2);
-    log_printf("Differences: %d base(s)\n", diff);
+    if (config.do_align == 1 && config.align_file1[0] != '\0') 
+    {
+        run_align_fasta_mode(&config);
 
-    process_sequence(config.compare_seq1, config);
-    process_sequence(config.compare_seq2, config);
-}
+        if (log_fp != NULL) 
+        {
+            fclose(log_fp);
+        }
 
-void run_hamming_mode(const char *sequence, options config)
-{
-    char cleaned_ref[MAX_DNA_LENGTH];
-    strcpy(cleaned_ref, config.hamming_seq);
+        return 0;
+    }
 
-    clean_sequence((char *)cleaned_ref);
-    char cleaned_seq[MAX_DNA_LENGTH];
-    strcpy(cleaned_seq, sequence);
-    clean_sequence(cleaned_seq);
+    if (config.compare_mode == 1) 
+    {
+        run_compare_mode(&config);
+        profile_report(&config);
 
-    int len_seq = strlen(cleaned_seq);
-    int len_ref = strlen(cleaned_ref);
+        if (log_fp != NULL) 
+        {
+            fclose(log_fp);
+        }
 
-    if (len_seq != len_ref) 
-    {
-        log_printf("\nError: Sequences have different lengths. Cannot compute Hamming distance.\n\n");
-        return;
+        return 0;
     }
 
-    int hamming_distance = 0;
-
-    for (int i = 0; i < len_seq; i++) 
+    if (config.simulate_reads > 0) 
     {
-        if (cleaned_seq[i] != cleaned_ref[i]) 
+        run_simulate_reads_mode(&config);
+
+        if (log_fp != NULL) 
         {
-            hamming_distance++;
+            fclose(log_fp);
         }
-    }
 
-    log_printf("\n=== Hamming Distance ===\n\n");
-    log_printf("%d\n\n", hamming_distance);
-}
+        return 0;
+    }
 
-int main(int argc, char *argv[]) 
-{
-    srand(time(NULL));
+    if (config.window_size > 0) 
+    {
+        run_window_mode(&config);
 
-    char sequence[MAX_DNA_LENGTH];
+        if (log_fp != NULL) 
+        {
+            fclose(log_fp);
+        }
 
-    options config = parse_args(argc, argv);
+        return 0;
+    }
 
-    if (config.do_log == 1) 
+    if (config.do_mask == 1) 
     {
-        log_fp = fopen(config.log_file, "w");
+        run_mask_mode(&config);
 
-        if (log_fp == NULL) 
+        if (log_fp != NULL) 
         {
-            printf("Error: Could not open log file '%s' for writing.\n", config.log_file);
-            return 1;
+            fclose(log_fp);
         }
+
+        return 0;
     }
 
-    if (config.show_version == 1) 
+    if (config.do_find_palindromes == 1) 
     {
-        printf("\n%s version %s\n", argv[0], PROGRAM_VERSION);
-        printf("Build date: %s %s\n\n", BUILD_DATE, BUILD_TIME);
+        run_palindrome_mode(&config);
 
         if (log_fp != NULL) 
         {
-            fprintf(log_fp, "\n%s version %s\n", argv[0], PROGRAM_VERSION);
-            fprintf(log_fp, "Build date: %s %s\n\n", BUILD_DATE, BUILD_TIME);
+            fclose(log_fp);
         }
 
+        return 0;
+    }
+
+    if (config.do_repeats == 1) 
+    {
+        run_repeats_mode(&config);
+
         if (log_fp != NULL) 
         {
             fclose(log_fp);
@@ -2517,9 +15399,9 @@ int main(int argc, char *argv[])
         return 0;
     }
 
-    if (config.compare_mode == 1) 
+    if (config.random_length > 0 && config.random_output_file[0] != '\0') 
     {
-        run_compare_mode(config);
+        run_random_output_mode(&config);
 
         if (log_fp != NULL) 
         {
@@ -2532,7 +15414,8 @@ int main(int argc, char *argv[])
     if (config.random_length > 0) 
     {
         generate_random_sequence(sequence, config.random_length);
-        process_sequence(sequence, config);
+        process_sequence(sequence, &config);
+        profile_report(&config);
 
         if (log_fp != NULL) 
         {
@@ -2561,7 +15444,11 @@ int main(int argc, char *argv[])
 
         sequence[strcspn(sequence, "\n")] = '\0';
         clean_sequence(sequence);
+        profile_mark mark = profile_begin();
+
         encrypt_file(sequence, config.encrypt_file_input, config.encrypt_file_output);
+        profile_end(STAGE_ENCRYPT_FILE, mark, 0);
+        profile_report(&config);
 
         if (log_fp != NULL) 
         {
@@ -2590,7 +15477,11 @@ int main(int argc, char *argv[])
 
         sequence[strcspn(sequence, "\n")] = '\0';
         clean_sequence(sequence);
+        profile_mark mark = profile_begin();
+
         decrypt_file(sequence, config.decrypt_file_input, config.decrypt_file_output);
+        profile_end(STAGE_DECRYPT_FILE, mark, 0);
+        profile_report(&config);
 
         if (log_fp != NULL) 
         {
@@ -2600,17 +15491,38 @@ int main(int argc, char *argv[])
         return 0;
     }
 
-    clock_t start_time;
-    clock_t end_time;
+    int64_t wall_start = 0;
+    clock_t cpu_start = 0;
+    hamming_state hamming;
+
+    if (config.do_hamming == 1) 
+    {
+        hamming_state_init(&hamming, &config);
+    }
 
     if (config.do_benchmark == 1) 
     {
-        start_time = clock();
+        wall_start = now_ns();
+        cpu_start = clock();
+    }
+
+    if (config.region[0] != '\0' || config.regions_file[0] != '\0') 
+    {
+        int success = run_region_mode(&config);
+
+        profile_report(&config);
+
+        if (log_fp != NULL) 
+        {
+            fclose(log_fp);
+        }
+
+        return success ? 0 : 1;
     }
 
     if (config.do_fasta_input == 1) 
     {
-        int success = read_fasta_single_sequence(config.fasta_input_file, sequence);
+        int success = read_fasta_single_sequence(config.fasta_input_file, config.fasta_record, sequence);
 
         if (!success) 
         {
@@ -2622,7 +15534,8 @@ int main(int argc, char *argv[])
             return 1;
         }
 
-        process_sequence(sequence, config);
+        process_sequence(sequence, &config);
+        profile_report(&config);
 
         if (log_fp != NULL) 
         {
@@ -2666,11 +15579,11 @@ int main(int argc, char *argv[])
 
             if (config.do_hamming == 1) 
             {
-                run_hamming_mode(sequence, config);
+                run_hamming_mode(sequence, &hamming);
             } 
             else 
             {
-                process_sequence(sequence, config);
+                process_sequence(sequence, &config);
             }
         }
 
@@ -2707,11 +15620,11 @@ int main(int argc, char *argv[])
 
                 if (config.do_hamming == 1) 
                 {
-                    run_hamming_mode(sequence, config);
+                    run_hamming_mode(sequence, &hamming);
                 } 
                 else 
                 {
-                    process_sequence(sequence, config);
+                    process_sequence(sequence, &config);
                 }
             }
         } 
@@ -2736,23 +15649,36 @@ int main(int argc, char *argv[])
 
             if (config.do_hamming == 1) 
             {
-                run_hamming_mode(sequence, config);
+                run_hamming_mode(sequence, &hamming);
             } 
             else 
             {
-                process_sequence(sequence, config);
+                process_sequence(sequence, &config);
             }
         }
     }
 
-    if (config.do_benchmark == 1) 
+    if (config.do_hamming == 1) 
     {
-        end_time = clock();
+        if (config.hamming_top_n > 0) 
+        {
+            print_hamming_top(&hamming);
+        }
+
+        hamming_state_free(&hamming);
+    }
+
+    profile_report(&config);
 
-        double elapsed = (double)(end_time - start_time) / CLOCKS_PER_SEC;
+    if (config.do_benchmark == 1) 
+    {
+        double wall = (now_ns() - wall_start) / 1e9;
+        double cpu = (double)(clock() - cpu_start) / CLOCKS_PER_SEC;
 
         log_printf("\n=== Benchmark ===\n\n");
-        log_printf("Analysis took %.6f seconds.\n\n", elapsed);
+        log_printf("Wall time : %.6f seconds\n", wall);
+        log_printf("CPU time  : %.6f seconds\n", cpu);
+        log_printf("Peak RSS  : %lld KB\n\n", (long long)peak_rss_kb());
     }
 
     if (log_fp != NULL) 